@@ -0,0 +1,257 @@
+#ifndef SRC_ALLOCATOR
+#define SRC_ALLOCATOR
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+// Pool allocator for container nodes. Single objects are carved out of large
+// chunks and recycled through a free list, release() gives every chunk back
+// to the heap at once. Each container owns its own pool, so copies of the
+// allocator start empty and only moves transfer memory.
+template <class T>
+class slab_allocator {
+ public:
+  using value_type = T;
+  using pointer = T*;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  template <class U>
+  struct rebind {
+    using other = slab_allocator<U>;
+  };
+
+ private:
+  struct Slot {
+    Slot* next;
+  };
+  struct Chunk {
+    Chunk* next;
+  };
+
+  Chunk* chunks_;
+  Slot* free_;
+  char* cur_;
+  char* end_;
+  size_type free_count_;
+  size_type next_chunk_;
+
+ public:
+  // CONSTRUCTORS
+  slab_allocator() noexcept
+      : chunks_(nullptr),
+        free_(nullptr),
+        cur_(nullptr),
+        end_(nullptr),
+        free_count_(0),
+        next_chunk_(first_chunk()) {}
+  slab_allocator(const slab_allocator&) noexcept : slab_allocator() {}
+  template <class U>
+  slab_allocator(const slab_allocator<U>&) noexcept : slab_allocator() {}
+  slab_allocator(slab_allocator&& other) noexcept
+      : chunks_(other.chunks_),
+        free_(other.free_),
+        cur_(other.cur_),
+        end_(other.end_),
+        free_count_(other.free_count_),
+        next_chunk_(other.next_chunk_) {
+    other.forget_();
+  }
+  ~slab_allocator() { release(); }
+
+  // OPERATORS
+  slab_allocator& operator=(const slab_allocator&) noexcept { return *this; }
+  slab_allocator& operator=(slab_allocator&& other) noexcept {
+    if (this == &other) return *this;
+    release();
+    chunks_ = other.chunks_;
+    free_ = other.free_;
+    cur_ = other.cur_;
+    end_ = other.end_;
+    free_count_ = other.free_count_;
+    next_chunk_ = other.next_chunk_;
+    other.forget_();
+    return *this;
+  }
+  friend bool operator==(const slab_allocator& a, const slab_allocator& b) {
+    return &a == &b;
+  }
+  friend bool operator!=(const slab_allocator& a, const slab_allocator& b) {
+    return &a != &b;
+  }
+
+  // METHODS
+  T* allocate(size_type n) {
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "over-aligned types are not supported");
+    if (n != 1) {
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    if (free_ != nullptr) {
+      Slot* s = free_;
+      free_ = s->next;
+      free_count_--;
+      return reinterpret_cast<T*>(s);
+    }
+    if (cur_ == end_) {
+      grow_(next_chunk_);
+    }
+    T* ret = reinterpret_cast<T*>(cur_);
+    cur_ += slot_size();
+    return ret;
+  }
+  void deallocate(T* p, size_type n) noexcept {
+    if (n != 1) {
+      ::operator delete(p);
+      return;
+    }
+    Slot* s = reinterpret_cast<Slot*>(p);
+    s->next = free_;
+    free_ = s;
+    free_count_++;
+  }
+
+  // Makes sure the next n single-object allocations do not touch the heap.
+  void reserve(size_type n) {
+    size_type available = free_count_ + (end_ - cur_) / slot_size();
+    if (n > available) {
+      grow_(n - available > next_chunk_ ? n - available : next_chunk_);
+    }
+  }
+  // Frees every chunk. Objects still living in the pool must already be
+  // destroyed.
+  void release() noexcept {
+    while (chunks_ != nullptr) {
+      Chunk* next = chunks_->next;
+      ::operator delete(chunks_);
+      chunks_ = next;
+    }
+    forget_();
+  }
+  // Takes over all memory of other, so that objects allocated by other can be
+  // deallocated through *this.
+  void adopt(slab_allocator& other) noexcept {
+    if (this == &other || other.chunks_ == nullptr) return;
+    other.retire_tail_();
+    Chunk* last = other.chunks_;
+    while (last->next != nullptr) {
+      last = last->next;
+    }
+    last->next = chunks_;
+    chunks_ = other.chunks_;
+    while (other.free_ != nullptr) {
+      Slot* s = other.free_;
+      other.free_ = s->next;
+      s->next = free_;
+      free_ = s;
+      free_count_++;
+    }
+    other.forget_();
+  }
+
+ private:
+  static constexpr size_type align() {
+    return alignof(T) > alignof(Slot) ? alignof(T) : alignof(Slot);
+  }
+  static constexpr size_type slot_size() {
+    size_type s = sizeof(T) > sizeof(Slot) ? sizeof(T) : sizeof(Slot);
+    return (s + align() - 1) / align() * align();
+  }
+  static constexpr size_type header_size() {
+    return (sizeof(Chunk) + align() - 1) / align() * align();
+  }
+  static constexpr size_type first_chunk() { return 32; }
+  static constexpr size_type max_chunk() {
+    return (size_type(1) << 20) / slot_size() > first_chunk()
+               ? (size_type(1) << 20) / slot_size()
+               : first_chunk();
+  }
+
+  void forget_() noexcept {
+    chunks_ = nullptr;
+    free_ = nullptr;
+    cur_ = end_ = nullptr;
+    free_count_ = 0;
+    next_chunk_ = first_chunk();
+  }
+  // Moves whatever is left of the current chunk onto the free list.
+  void retire_tail_() noexcept {
+    while (cur_ != end_) {
+      Slot* s = reinterpret_cast<Slot*>(cur_);
+      s->next = free_;
+      free_ = s;
+      free_count_++;
+      cur_ += slot_size();
+    }
+  }
+  void grow_(size_type slots) {
+    retire_tail_();
+    char* raw = static_cast<char*>(
+        ::operator new(header_size() + slots * slot_size()));
+    Chunk* c = reinterpret_cast<Chunk*>(raw);
+    c->next = chunks_;
+    chunks_ = c;
+    cur_ = raw + header_size();
+    end_ = cur_ + slots * slot_size();
+    if (next_chunk_ < max_chunk()) {
+      next_chunk_ *= 2;
+    }
+  }
+};
+
+// Optional allocator capabilities the containers take advantage of.
+template <class A, class = void>
+struct has_release : std::false_type {};
+template <class A>
+struct has_release<A, std::void_t<decltype(std::declval<A&>().release())>>
+    : std::true_type {};
+
+template <class A, class = void>
+struct has_reserve : std::false_type {};
+template <class A>
+struct has_reserve<
+    A, std::void_t<decltype(std::declval<A&>().reserve(size_t()))>>
+    : std::true_type {};
+
+template <class A, class = void>
+struct has_adopt : std::false_type {};
+template <class A>
+struct has_adopt<A,
+                 std::void_t<decltype(std::declval<A&>().adopt(
+                     std::declval<A&>()))>> : std::true_type {};
+
+// Container swap exchanges the allocators only if they propagate on swap;
+// otherwise they must compare equal and stay where they are.
+template <class A>
+void swap_allocators(A& a, A& b) noexcept {
+  if constexpr (std::allocator_traits<A>::propagate_on_container_swap::value) {
+    using std::swap;
+    swap(a, b);
+  }
+}
+
+// Whether move assignment may take over the other container's memory: the
+// allocator propagates or the two allocators can free each other's memory.
+template <class A>
+bool can_steal_memory(const A& to, const A& from) noexcept {
+  using traits = std::allocator_traits<A>;
+  if constexpr (traits::propagate_on_container_move_assignment::value ||
+                traits::is_always_equal::value) {
+    return true;
+  } else {
+    return to == from;
+  }
+}
+
+}  // namespace s21
+
+#endif  // SRC_ALLOCATOR
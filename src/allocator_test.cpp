@@ -0,0 +1,143 @@
+#include "allocator.h"
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "map.h"
+#include "multiset.h"
+#include "set.h"
+
+namespace {
+
+// Never propagates and compares equal only to copies of itself, so
+// containers using it cannot hand nodes to each other.
+template <class T>
+struct tagged_allocator {
+  using value_type = T;
+  using propagate_on_container_move_assignment = std::false_type;
+  using propagate_on_container_swap = std::false_type;
+  static inline int next = 0;
+  int id;
+
+  tagged_allocator() : id(next++) {}
+  template <class U>
+  tagged_allocator(const tagged_allocator<U>& other) : id(other.id) {}
+  T* allocate(size_t n) { return std::allocator<T>().allocate(n); }
+  void deallocate(T* p, size_t n) { std::allocator<T>().deallocate(p, n); }
+  template <class U>
+  bool operator==(const tagged_allocator<U>& other) const {
+    return id == other.id;
+  }
+  template <class U>
+  bool operator!=(const tagged_allocator<U>& other) const {
+    return id != other.id;
+  }
+};
+
+}  // namespace
+
+class SlabAllocatorTest : public ::testing::Test {};
+
+TEST(SlabAllocatorTest, ReusesFreedSlots) {
+  s21::slab_allocator<long> A;
+  long* a = A.allocate(1);
+  long* b = A.allocate(1);
+  EXPECT_NE(a, b);
+  A.deallocate(a, 1);
+  long* c = A.allocate(1);
+  EXPECT_EQ(a, c);
+  A.deallocate(b, 1);
+  A.deallocate(c, 1);
+}
+
+TEST(SlabAllocatorTest, ArraysBypassThePool) {
+  s21::slab_allocator<int> A;
+  int* a = A.allocate(10);
+  for (int i = 0; i < 10; i++) {
+    a[i] = i;
+  }
+  EXPECT_EQ(a[9], 9);
+  A.deallocate(a, 10);
+}
+
+TEST(SlabAllocatorTest, MoveTransfersMemory) {
+  s21::slab_allocator<int> A;
+  int* a = A.allocate(1);
+  *a = 42;
+  s21::slab_allocator<int> B(std::move(A));
+  EXPECT_EQ(*a, 42);
+  B.deallocate(a, 1);
+  s21::slab_allocator<int> C(B);
+  EXPECT_FALSE(B == C);
+}
+
+TEST(SlabAllocatorTest, SetReserveAndClear) {
+  s21::set<int> A;
+  A.reserve(1000);
+  for (int i = 0; i < 1000; i++) {
+    A.insert(i);
+  }
+  EXPECT_EQ(A.size(), 1000);
+  A.clear();
+  EXPECT_TRUE(A.empty());
+  for (int i = 0; i < 10; i++) {
+    A.insert(i);
+  }
+  int e = 0;
+  for (auto i : A) {
+    EXPECT_EQ(i, e);
+    e++;
+  }
+  EXPECT_EQ(e, 10);
+}
+
+TEST(SlabAllocatorTest, StringsAreDestroyedOnClear) {
+  s21::multiset<std::string> A;
+  for (int i = 0; i < 100; i++) {
+    A.insert(std::string(40, 'a' + i % 26));
+  }
+  A.clear();
+  A.insert("after clear");
+  EXPECT_EQ(*A.begin(), "after clear");
+}
+
+TEST(SlabAllocatorTest, MergeAdoptsNodes) {
+  s21::set<int> A = {5, 6};
+  {
+    s21::set<int> B = {1, 2, 3, 4};
+    A.merge(B);
+  }
+  int e = 1;
+  for (auto i : A) {
+    EXPECT_EQ(i, e);
+    e++;
+  }
+  EXPECT_EQ(e, 7);
+}
+
+TEST(SlabAllocatorTest, StdAllocator) {
+  s21::map<int, int, std::less<int>, std::allocator<std::pair<int, int>>> A;
+  for (int i = 0; i < 100; i++) {
+    A.insert(i, i * 10);
+  }
+  EXPECT_EQ(A.at(50), 500);
+  A.clear();
+  EXPECT_TRUE(A.empty());
+}
+
+TEST(SlabAllocatorTest, MoveAssignWithUnequalAllocators) {
+  using tagged_set = s21::set<std::string, std::less<std::string>,
+                              tagged_allocator<std::string>>;
+  tagged_set A = {"a", "b"};
+  tagged_set B = {"c", "d", "e"};
+  const std::string* first = &*B.begin();
+  A = std::move(B);
+  EXPECT_EQ(A.size(), 3U);
+  EXPECT_NE(&*A.begin(), first);
+  EXPECT_EQ(*A.begin(), "c");
+  EXPECT_TRUE(B.empty());
+  EXPECT_FALSE(s21::can_steal_memory(A.get_allocator(), B.get_allocator()));
+  EXPECT_TRUE(s21::can_steal_memory(std::allocator<int>(),
+                                    std::allocator<int>()));
+}
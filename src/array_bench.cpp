@@ -0,0 +1,80 @@
+#include <array>
+#include <memory>
+#include <string>
+
+#include "array.h"
+#include "bench.h"
+
+namespace {
+
+using namespace s21::bench;
+
+// Arrays are allocated on the heap: at the larger sizes they do not fit on
+// the stack.
+template <class A, class T, size_t N>
+void run_array(const char* impl) {
+  const char* key = key_name<T>();
+  auto keys = shuffled_keys<T>(N);
+  auto a = std::make_unique<A>();
+  measure(
+      "array", impl, "fill", key, N, N, [&] { return a.get(); },
+      [&](A* a) {
+        a->fill(keys[0]);
+        keep((*a)[N - 1]);
+      });
+  measure(
+      "array", impl, "assign", key, N, N, [&] { return a.get(); },
+      [&](A* a) {
+        for (size_t i = 0; i < N; i++) {
+          (*a)[i] = keys[i];
+        }
+        keep((*a)[N - 1]);
+      });
+  measure(
+      "array", impl, "iterate", key, N, N, [&] { return a.get(); },
+      [](A* a) {
+        std::uint64_t sum = 0;
+        for (auto i = a->begin(); i != a->end(); ++i) {
+          sum += checksum(*i);
+        }
+        keep(sum);
+      });
+  measure(
+      "array", impl, "random_access", key, N, N, [&] { return a.get(); },
+      [](A* a) {
+        std::uint64_t sum = 0, k = 1;
+        for (size_t i = 0; i < N; i++) {
+          k = k * 6364136223846793005ULL + 1442695040888963407ULL;
+          sum += checksum((*a)[(k >> 33) % N]);
+        }
+        keep(sum);
+      });
+}
+
+template <class T, size_t N>
+void run_size() {
+  for (size_t n : sizes()) {
+    if (n == N) {
+      run_array<s21::array<T, N>, T, N>("s21");
+      run_array<std::array<T, N>, T, N>("std");
+    }
+  }
+}
+
+template <class T>
+void run_key() {
+  run_size<T, 10>();
+  run_size<T, 1000>();
+  run_size<T, 100000>();
+  run_size<T, 10000000>();
+}
+
+void run() {
+  run_key<int>();
+  run_key<std::string>();
+  run_key<blob64>();
+}
+
+registrar reg("array", run);
+
+}  // namespace
@@ -0,0 +1,194 @@
+#ifndef SRC_BENCH
+#define SRC_BENCH
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+// Microbenchmark harness shared by the *_bench.cpp files. Every benchmark
+// runs the same code against an s21:: container and its std:: counterpart
+// and reports one row per (container, implementation, operation, key type,
+// size) to the output table.
+namespace s21 {
+namespace bench {
+
+// KEY TYPES
+struct blob64 {
+  std::uint64_t v[8];
+
+  friend bool operator<(const blob64& a, const blob64& b) {
+    return std::lexicographical_compare(a.v, a.v + 8, b.v, b.v + 8);
+  }
+  friend bool operator==(const blob64& a, const blob64& b) {
+    return std::equal(a.v, a.v + 8, b.v);
+  }
+};
+
+// Hash for every key type, for the unordered containers.
+struct key_hash {
+  size_t operator()(int v) const { return std::hash<int>()(v); }
+  size_t operator()(const std::string& v) const {
+    return std::hash<std::string>()(v);
+  }
+  size_t operator()(const blob64& v) const {
+    return std::hash<std::uint64_t>()(v.v[0] ^ (v.v[7] << 1));
+  }
+};
+
+template <class T>
+T make_key(std::uint64_t i);
+template <>
+inline int make_key<int>(std::uint64_t i) {
+  return static_cast<int>(i);
+}
+template <>
+inline float make_key<float>(std::uint64_t i) {
+  return static_cast<float>(i);
+}
+// 24 characters, too long for the small string buffer.
+template <>
+inline std::string make_key<std::string>(std::uint64_t i) {
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "key-%020llu",
+                static_cast<unsigned long long>(i));
+  return buf;
+}
+template <>
+inline blob64 make_key<blob64>(std::uint64_t i) {
+  blob64 ret;
+  for (int j = 0; j < 8; j++) {
+    ret.v[j] = i * (j + 1);
+  }
+  return ret;
+}
+
+template <class T>
+const char* key_name();
+template <>
+inline const char* key_name<int>() {
+  return "int";
+}
+template <>
+inline const char* key_name<float>() {
+  return "float";
+}
+template <>
+inline const char* key_name<std::string>() {
+  return "string";
+}
+template <>
+inline const char* key_name<blob64>() {
+  return "struct64";
+}
+
+inline std::uint64_t checksum(int v) { return v; }
+inline std::uint64_t checksum(float v) {
+  return static_cast<std::uint64_t>(v);
+}
+inline std::uint64_t checksum(const std::string& v) {
+  return v.size() + v.back();
+}
+inline std::uint64_t checksum(const blob64& v) { return v.v[0]; }
+template <class A, class B>
+std::uint64_t checksum(const std::pair<A, B>& v) {
+  return checksum(v.first) + checksum(v.second);
+}
+
+// Keys 0..n-1 in a fixed random order.
+template <class T>
+std::vector<T> shuffled_keys(size_t n) {
+  std::vector<std::uint64_t> order(n);
+  for (size_t i = 0; i < n; i++) {
+    order[i] = i;
+  }
+  std::shuffle(order.begin(), order.end(), std::mt19937_64(n));
+  std::vector<T> ret;
+  ret.reserve(n);
+  for (auto i : order) {
+    ret.push_back(make_key<T>(i));
+  }
+  return ret;
+}
+
+// Keeps the compiler from dropping a result that is otherwise unused.
+template <class T>
+inline void keep(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// CONFIGURATION
+struct options {
+  std::vector<size_t> sizes = {10, 1000, 100000, 10000000};
+  size_t max_size = 10000000;
+  std::string filter;
+  const char* opt = "";
+  double min_seconds = 0.05;
+  std::FILE* out = stdout;
+};
+inline options& config() {
+  static options ret;
+  return ret;
+}
+inline std::vector<size_t> sizes() {
+  std::vector<size_t> ret;
+  for (size_t n : config().sizes) {
+    if (n <= config().max_size) ret.push_back(n);
+  }
+  return ret;
+}
+
+inline void print_header() {
+  std::fprintf(config().out,
+               "opt\tcontainer\timpl\top\tkey\tsize\tns_per_op\tmops_per_s\n");
+}
+inline void report(const char* container, const char* impl, const char* op,
+                   const char* key, size_t n, double ns_per_op) {
+  std::fprintf(config().out, "%s\t%s\t%s\t%s\t%s\t%zu\t%.3f\t%.3f\n",
+               config().opt, container, impl, op, key, n, ns_per_op,
+               1e3 / ns_per_op);
+  std::fflush(config().out);
+}
+
+// Builds a fresh state with setup() and times run(state), which performs
+// ops operations, until min_seconds of timed work have accumulated. The
+// fastest repetition is reported; setup and teardown are not timed.
+template <class Setup, class Run>
+void measure(const char* container, const char* impl, const char* op,
+             const char* key, size_t n, size_t ops, Setup setup, Run run) {
+  using clock = std::chrono::steady_clock;
+  double best = 0, total = 0;
+  for (int reps = 0; total < config().min_seconds && reps < 100000; reps++) {
+    auto state = setup();
+    auto start = clock::now();
+    run(state);
+    double t = std::chrono::duration<double>(clock::now() - start).count();
+    best = reps == 0 ? t : std::min(best, t);
+    total += t;
+  }
+  report(container, impl, op, key, n, best * 1e9 / (ops ? ops : 1));
+}
+
+// REGISTRY
+struct entry {
+  const char* name;
+  void (*run)();
+};
+inline std::vector<entry>& registry() {
+  static std::vector<entry> ret;
+  return ret;
+}
+struct registrar {
+  registrar(const char* name, void (*run)()) {
+    registry().push_back({name, run});
+  }
+};
+
+}  // namespace bench
+}  // namespace s21
+
+#endif  // SRC_BENCH
@@ -0,0 +1,48 @@
+// Runs every registered benchmark and writes the result table.
+//
+//   bench [--opt=LABEL] [--max-size=N] [--filter=NAME] [--no-header] [FILE]
+//
+// --opt labels the rows (make bench builds at -O2 and -O3), --filter keeps
+// the benchmarks whose name contains NAME, FILE defaults to stdout and is
+// appended to.
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "bench.h"
+
+int main(int argc, char** argv) {
+  auto& config = s21::bench::config();
+  bool header = true;
+  for (int i = 1; i < argc; i++) {
+    if (std::strncmp(argv[i], "--opt=", 6) == 0) {
+      config.opt = argv[i] + 6;
+    } else if (std::strncmp(argv[i], "--max-size=", 11) == 0) {
+      config.max_size = std::strtoull(argv[i] + 11, nullptr, 10);
+    } else if (std::strncmp(argv[i], "--filter=", 9) == 0) {
+      config.filter = argv[i] + 9;
+    } else if (std::strcmp(argv[i], "--no-header") == 0) {
+      header = false;
+    } else {
+      config.out = std::fopen(argv[i], "a");
+      if (config.out == nullptr) {
+        std::perror(argv[i]);
+        return 1;
+      }
+    }
+  }
+  auto entries = s21::bench::registry();
+  std::sort(entries.begin(), entries.end(),
+            [](const s21::bench::entry& a, const s21::bench::entry& b) {
+              return std::strcmp(a.name, b.name) < 0;
+            });
+  if (header) s21::bench::print_header();
+  for (auto& i : entries) {
+    if (std::strstr(i.name, config.filter.c_str()) != nullptr) {
+      i.run();
+    }
+  }
+  if (config.out != stdout) std::fclose(config.out);
+  return 0;
+}
@@ -0,0 +1,1053 @@
+#ifndef SRC_BPLUS_TREE
+#define SRC_BPLUS_TREE
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "allocator.h"
+
+namespace s21 {
+
+// Node sizes of the B+ tree. Fan-out is derived from the key and value sizes
+// so that a node fills about node_bytes (four cache lines); both node kinds
+// keep one spare slot so that an insert can overflow before it is split.
+template <class K, class V>
+struct bplus_layout {
+  static constexpr size_t node_bytes = 256;
+  static constexpr size_t min_capacity = 4;
+
+  static constexpr size_t leaf_fit() {
+    return (node_bytes - 4 * sizeof(void*)) / sizeof(V);
+  }
+  static constexpr size_t inner_fit() {
+    return (node_bytes - 4 * sizeof(void*)) / (sizeof(K) + sizeof(void*));
+  }
+  static constexpr size_t leaf_capacity =
+      leaf_fit() > min_capacity + 1 ? leaf_fit() - 1 : min_capacity;
+  static constexpr size_t inner_capacity =
+      inner_fit() > min_capacity + 1 ? inner_fit() - 1 : min_capacity;
+};
+
+template <class K, class V>
+struct bplus_inner;
+
+template <class K, class V>
+struct bplus_node {
+  bplus_inner<K, V>* parent;
+  unsigned count;
+  bool leaf;
+};
+
+template <class K, class V>
+struct bplus_inner : bplus_node<K, V> {
+  static constexpr size_t capacity = bplus_layout<K, V>::inner_capacity;
+
+  alignas(K) unsigned char raw[(capacity + 1) * sizeof(K)];
+  bplus_node<K, V>* children[capacity + 2];
+
+  K* keys() { return std::launder(reinterpret_cast<K*>(raw)); }
+  const K* keys() const {
+    return std::launder(reinterpret_cast<const K*>(raw));
+  }
+};
+
+template <class K, class V>
+struct bplus_leaf : bplus_node<K, V> {
+  using value_type = V;
+  static constexpr size_t capacity = bplus_layout<K, V>::leaf_capacity;
+
+  bplus_leaf* prev;
+  bplus_leaf* next;
+  alignas(V) unsigned char raw[(capacity + 1) * sizeof(V)];
+
+  V* vals() { return std::launder(reinterpret_cast<V*>(raw)); }
+  const V* vals() const {
+    return std::launder(reinterpret_cast<const V*>(raw));
+  }
+};
+
+template <class Leaf>
+class iterator_bplus;
+
+template <class Leaf>
+class const_iterator_bplus;
+
+// Cache-conscious B+ tree with the same interface as btree. Values live only
+// in the leaves, which are chained for scans, inner nodes hold copies of the
+// separating keys. Unlike btree, inserting or erasing may move other values
+// between nodes and so invalidates iterators.
+template <class K, class M, class Node, bool MULTI,
+          class Compare = std::less<K>,
+          class Allocator = slab_allocator<typename Node::value_type>>
+class bplus_tree {
+ public:
+  using key_type = K;
+  using value_type = typename Node::value_type;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+ protected:
+  using base_node = bplus_node<K, value_type>;
+  using leaf_node = bplus_leaf<K, value_type>;
+  using inner_node = bplus_inner<K, value_type>;
+  using leaf_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<leaf_node>;
+  using inner_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<inner_node>;
+  using leaf_traits = std::allocator_traits<leaf_allocator>;
+  using inner_traits = std::allocator_traits<inner_allocator>;
+
+  static constexpr unsigned leaf_capacity = leaf_node::capacity;
+  static constexpr unsigned inner_capacity = inner_node::capacity;
+  static constexpr unsigned min_leaf = leaf_capacity / 2;
+  static constexpr unsigned min_inner = inner_capacity / 2;
+
+ public:
+  using iterator = iterator_bplus<leaf_node>;
+  using const_iterator = const_iterator_bplus<leaf_node>;
+
+ protected:
+  base_node* root_;
+  leaf_node* first_;
+  leaf_node* last_;
+  size_t size_;
+  Compare comp_;
+  leaf_allocator leaf_alloc_;
+  inner_allocator inner_alloc_;
+
+ public:
+  // CONSTRUCTORS
+  bplus_tree()
+      : root_(nullptr), first_(nullptr), last_(nullptr), size_(0) {}
+  explicit bplus_tree(const Compare& comp)
+      : root_(nullptr),
+        first_(nullptr),
+        last_(nullptr),
+        size_(0),
+        comp_(comp) {}
+  bplus_tree(std::initializer_list<value_type> const& values)
+      : bplus_tree() {
+    assign(values.begin(), values.end());
+  }
+  template <class InputIt, class = typename std::iterator_traits<
+                               InputIt>::iterator_category>
+  bplus_tree(InputIt first, InputIt last) : bplus_tree() {
+    assign(first, last);
+  }
+  bplus_tree(const bplus_tree& other) : bplus_tree(other.comp_) {
+    copy_from_(other);
+  }
+  bplus_tree(bplus_tree&& other) noexcept
+      : root_(other.root_),
+        first_(other.first_),
+        last_(other.last_),
+        size_(other.size_),
+        comp_(other.comp_),
+        leaf_alloc_(std::move(other.leaf_alloc_)),
+        inner_alloc_(std::move(other.inner_alloc_)) {
+    other.root_ = nullptr;
+    other.first_ = other.last_ = nullptr;
+    other.size_ = 0;
+  }
+  ~bplus_tree() { clear(); }
+
+  // OPERATORS
+  bplus_tree& operator=(std::initializer_list<value_type> const& values) {
+    assign(values.begin(), values.end());
+    return *this;
+  }
+  bplus_tree& operator=(const bplus_tree& other) {
+    if (this == &other) return *this;
+    clear();
+    comp_ = other.comp_;
+    copy_from_(other);
+    return *this;
+  }
+  bplus_tree& operator=(bplus_tree&& other) noexcept {
+    if (this == &other) return *this;
+    clear();
+    swap(other);
+    return *this;
+  }
+
+  bool is_equal(const value_type& a, const value_type& b) const {
+    return !comp_(key_of_(a), key_of_(b)) && !comp_(key_of_(b), key_of_(a));
+  }
+
+  // METHODS
+  void clear() {
+    if (root_ != nullptr) {
+      if constexpr (has_release<leaf_allocator>::value &&
+                    has_release<inner_allocator>::value) {
+        if constexpr (!std::is_trivially_destructible<value_type>::value ||
+                      !std::is_trivially_destructible<K>::value) {
+          destroy_values_(root_);
+        }
+        leaf_alloc_.release();
+        inner_alloc_.release();
+      } else {
+        destroy_subtree_(root_);
+      }
+    }
+    root_ = nullptr;
+    first_ = last_ = nullptr;
+    size_ = 0;
+  }
+  // Replaces the contents with [first, last). Sorted input is appended leaf
+  // by leaf in O(n), anything else is sorted into a buffer first.
+  template <class InputIt>
+  void assign(InputIt first, InputIt last) {
+    clear();
+    using category =
+        typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag,
+                                  category>::value) {
+      if (is_sorted_(first, last)) {
+        reserve(std::distance(first, last));
+        for (; first != last; ++first) {
+          append_(*first);
+        }
+        return;
+      }
+    }
+    std::vector<value_type> buffer(first, last);
+    std::stable_sort(buffer.begin(), buffer.end(),
+                     [this](const value_type& a, const value_type& b) {
+                       return comp_(key_of_(a), key_of_(b));
+                     });
+    if (!MULTI) {
+      buffer.erase(std::unique(buffer.begin(), buffer.end(),
+                               [this](const value_type& a,
+                                      const value_type& b) {
+                                 return !comp_(key_of_(a), key_of_(b));
+                               }),
+                   buffer.end());
+    }
+    reserve(buffer.size());
+    for (auto& i : buffer) {
+      append_(std::move(i));
+    }
+  }
+  iterator begin() { return iterator(first_, 0); }
+  iterator end() {
+    return last_ != nullptr ? iterator(last_, last_->count) : iterator();
+  }
+  const_iterator begin() const { return const_iterator(first_, 0); }
+  const_iterator end() const {
+    return last_ != nullptr ? const_iterator(last_, last_->count)
+                            : const_iterator();
+  }
+
+  void erase(iterator pos) {
+    leaf_node* l = pos.leaf_;
+    erase_slot_(l->vals(), l->count, pos.idx_);
+    l->count--;
+    size_--;
+    if (l == root_) {
+      if (l->count == 0) {
+        free_leaf_(l);
+        root_ = nullptr;
+        first_ = last_ = nullptr;
+      }
+    } else if (l->count < min_leaf) {
+      rebalance_leaf_(l);
+    }
+  }
+  void merge(bplus_tree& other) {
+    if (this == &other) return;
+    for (auto& i : other) {
+      insert_iter(i);
+    }
+    other.clear();
+  }
+  // Same contract as btree::set_union and friends. Leaves are already in
+  // order, so the result is streamed into a new tree in a single linear
+  // pass instead of being split and joined.
+  void set_union(bplus_tree&& other) {
+    combine_with_(other, [](auto... args) { std::set_union(args...); });
+  }
+  void set_union(const bplus_tree& other) {
+    combine_with_(other, [](auto... args) { std::set_union(args...); });
+  }
+  void set_intersection(bplus_tree&& other) {
+    combine_with_(other,
+                  [](auto... args) { std::set_intersection(args...); });
+  }
+  void set_intersection(const bplus_tree& other) {
+    combine_with_(other,
+                  [](auto... args) { std::set_intersection(args...); });
+  }
+  void set_difference(bplus_tree&& other) {
+    combine_with_(other, [](auto... args) { std::set_difference(args...); });
+  }
+  void set_difference(const bplus_tree& other) {
+    combine_with_(other, [](auto... args) { std::set_difference(args...); });
+  }
+  size_type size() const { return size_; }
+  void reserve(size_type n) {
+    if (n <= size_) return;
+    size_type leaves = (n - size_) / min_leaf + 1;
+    if constexpr (has_reserve<leaf_allocator>::value) {
+      leaf_alloc_.reserve(leaves);
+    }
+    if constexpr (has_reserve<inner_allocator>::value) {
+      inner_alloc_.reserve(leaves / min_inner + 1);
+    }
+  }
+  allocator_type get_allocator() const { return allocator_type(leaf_alloc_); }
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(value_type);
+  }
+  bool empty() const { return root_ == nullptr; }
+  void swap(bplus_tree& other) noexcept {
+    std::swap(root_, other.root_);
+    std::swap(first_, other.first_);
+    std::swap(last_, other.last_);
+    std::swap(size_, other.size_);
+    std::swap(comp_, other.comp_);
+    swap_allocators(leaf_alloc_, other.leaf_alloc_);
+    swap_allocators(inner_alloc_, other.inner_alloc_);
+  }
+  key_compare key_comp() const { return comp_; }
+  size_type count(const key_type& key) const { return count_(key); }
+  iterator find(const key_type& key) { return find_(key); }
+  const_iterator find(const key_type& key) const { return find_(key); }
+  iterator lower_bound(const key_type& key) { return lower_pos_(key); }
+  const_iterator lower_bound(const key_type& key) const {
+    return lower_pos_(key);
+  }
+  // Last element equivalent to key, end() if there is none.
+  iterator upper_bound(const key_type& key) { return last_equal_(key); }
+  const_iterator upper_bound(const key_type& key) const {
+    return last_equal_(key);
+  }
+
+  template <class Key, class C = Compare, class = typename C::is_transparent>
+  size_type count(const Key& key) const {
+    return count_(key);
+  }
+  template <class Key, class C = Compare, class = typename C::is_transparent>
+  iterator find(const Key& key) {
+    return find_(key);
+  }
+  template <class Key, class C = Compare, class = typename C::is_transparent>
+  const_iterator find(const Key& key) const {
+    return find_(key);
+  }
+  template <class Key, class C = Compare, class = typename C::is_transparent>
+  iterator lower_bound(const Key& key) {
+    return lower_pos_(key);
+  }
+  template <class Key, class C = Compare, class = typename C::is_transparent>
+  const_iterator lower_bound(const Key& key) const {
+    return lower_pos_(key);
+  }
+
+  // Same contract as btree::for_each and for_each_range: a plain walk along
+  // the leaf chain that prefetches the next leaf while the current one is
+  // being visited.
+  template <class Fn>
+  void for_each(Fn fn) {
+    scan_(first_, 0, nullptr, fn);
+  }
+  template <class Fn>
+  void for_each(Fn fn) const {
+    auto visit = [&fn](const value_type& v) { fn(v); };
+    scan_(first_, 0, nullptr, visit);
+  }
+  template <class Fn>
+  void for_each_range(const key_type& lo, const key_type& hi, Fn fn) {
+    iterator i = lower_pos_(lo);
+    scan_(i.leaf_, i.idx_, &hi, fn);
+  }
+  template <class Fn>
+  void for_each_range(const key_type& lo, const key_type& hi, Fn fn) const {
+    iterator i = lower_pos_(lo);
+    auto visit = [&fn](const value_type& v) { fn(v); };
+    scan_(i.leaf_, i.idx_, &hi, visit);
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insert_iter(value_type(std::forward<Args>(args)...));
+  }
+
+ protected:
+  // HELPER FUNCTIONS
+  static const K& key_of_(const value_type& v) {
+    if constexpr (std::is_same<value_type, K>::value) {
+      return v;
+    } else {
+      return v.first;
+    }
+  }
+
+  template <class It>
+  bool is_sorted_(It first, It last) const {
+    if (first == last) return true;
+    for (It next = std::next(first); next != last; ++first, ++next) {
+      bool ordered = MULTI ? !comp_(key_of_(*next), key_of_(*first))
+                           : comp_(key_of_(*first), key_of_(*next));
+      if (!ordered) return false;
+    }
+    return true;
+  }
+  // Appends to result through append_, for the std:: set algorithms.
+  struct append_iterator_ {
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+
+    bplus_tree* result;
+    append_iterator_& operator*() { return *this; }
+    append_iterator_& operator++() { return *this; }
+    append_iterator_ operator++(int) { return *this; }
+    template <class V>
+    append_iterator_& operator=(V&& value) {
+      result->append_(std::forward<V>(value));
+      return *this;
+    }
+  };
+  template <class Other, class Op>
+  void combine_with_(Other&& other, Op op) {
+    if (this == &other) {
+      bplus_tree copy(other);
+      combine_with_(std::move(copy), op);
+      return;
+    }
+    auto less = [this](const value_type& a, const value_type& b) {
+      return comp_(key_of_(a), key_of_(b));
+    };
+    bplus_tree result(comp_);
+    op(std::make_move_iterator(begin()), std::make_move_iterator(end()),
+       other.begin(), other.end(), append_iterator_{&result}, less);
+    swap(result);
+    if constexpr (!std::is_const<std::remove_reference_t<Other>>::value) {
+      other.clear();
+    }
+  }
+  // Adds a value that is not less than everything already stored.
+  template <class V>
+  void append_(V&& value) {
+    if (last_ == nullptr) {
+      insert_value_(std::forward<V>(value));
+      return;
+    }
+    leaf_node* l = last_;
+    ::new (static_cast<void*>(l->vals() + l->count))
+        value_type(std::forward<V>(value));
+    l->count++;
+    size_++;
+    if (l->count > leaf_capacity) {
+      split_leaf_(l, true);
+    }
+  }
+
+  template <class InputIt>
+  void insert_range_(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert_iter(*first);
+    }
+  }
+  std::pair<iterator, bool> insert_iter(const value_type& value) {
+    return insert_value_(value);
+  }
+  std::pair<iterator, bool> insert_iter(value_type&& value) {
+    return insert_value_(std::move(value));
+  }
+  template <class V>
+  std::pair<iterator, bool> insert_value_(V&& value) {
+    if (root_ == nullptr) {
+      leaf_node* l = new_leaf_();
+      ::new (static_cast<void*>(l->vals())) value_type(std::forward<V>(value));
+      l->count = 1;
+      root_ = first_ = last_ = l;
+      size_ = 1;
+      return std::make_pair(iterator(l, 0), true);
+    }
+    const K& key = key_of_(value);
+    base_node* n = root_;
+    while (!n->leaf) {
+      inner_node* in = static_cast<inner_node*>(n);
+      n = in->children[inner_upper_(in, key)];
+    }
+    leaf_node* l = static_cast<leaf_node*>(n);
+    unsigned p = leaf_upper_(l, key);
+    if (!MULTI && p > 0 && !comp_(key_of_(l->vals()[p - 1]), key)) {
+      return std::make_pair(iterator(l, p - 1), false);
+    }
+    insert_slot_(l->vals(), l->count, p, std::forward<V>(value));
+    l->count++;
+    size_++;
+    if (l->count > leaf_capacity) {
+      bool append = l == last_ && p + 1 == l->count;
+      leaf_node* r = split_leaf_(l, append);
+      if (p >= l->count) {
+        return std::make_pair(iterator(r, p - l->count), true);
+      }
+    }
+    return std::make_pair(iterator(l, p), true);
+  }
+
+  // Binary searches inside a node, one comp_ call per step.
+  template <class Key>
+  unsigned leaf_lower_(const leaf_node* l, const Key& key) const {
+    unsigned lo = 0, hi = l->count;
+    while (lo < hi) {
+      unsigned mid = (lo + hi) / 2;
+      if (comp_(key_of_(l->vals()[mid]), key)) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+  template <class Key>
+  unsigned leaf_upper_(const leaf_node* l, const Key& key) const {
+    unsigned lo = 0, hi = l->count;
+    while (lo < hi) {
+      unsigned mid = (lo + hi) / 2;
+      if (comp_(key, key_of_(l->vals()[mid]))) {
+        hi = mid;
+      } else {
+        lo = mid + 1;
+      }
+    }
+    return lo;
+  }
+  template <class Key>
+  unsigned inner_lower_(const inner_node* n, const Key& key) const {
+    unsigned lo = 0, hi = n->count;
+    while (lo < hi) {
+      unsigned mid = (lo + hi) / 2;
+      if (comp_(n->keys()[mid], key)) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+  template <class Key>
+  unsigned inner_upper_(const inner_node* n, const Key& key) const {
+    unsigned lo = 0, hi = n->count;
+    while (lo < hi) {
+      unsigned mid = (lo + hi) / 2;
+      if (comp_(key, n->keys()[mid])) {
+        hi = mid;
+      } else {
+        lo = mid + 1;
+      }
+    }
+    return lo;
+  }
+
+  // Visits from position p of l onwards, up to (not including) *hi if set.
+  template <class Fn>
+  void scan_(leaf_node* l, unsigned p, const key_type* hi, Fn& fn) const {
+    for (; l != nullptr; l = l->next, p = 0) {
+      __builtin_prefetch(l->next);
+      value_type* vals = l->vals();
+      for (; p < l->count; p++) {
+        if (hi != nullptr && !comp_(key_of_(vals[p]), *hi)) return;
+        fn(vals[p]);
+      }
+    }
+  }
+  // First element not less than key.
+  template <class Key>
+  iterator lower_pos_(const Key& key) const {
+    if (root_ == nullptr) return iterator();
+    base_node* n = root_;
+    while (!n->leaf) {
+      inner_node* in = static_cast<inner_node*>(n);
+      n = in->children[inner_lower_(in, key)];
+    }
+    leaf_node* l = static_cast<leaf_node*>(n);
+    unsigned p = leaf_lower_(l, key);
+    if (p == l->count && l->next != nullptr) {
+      l = l->next;
+      p = 0;
+    }
+    return iterator(l, p);
+  }
+  // First element greater than key.
+  template <class Key>
+  iterator upper_pos_(const Key& key) const {
+    if (root_ == nullptr) return iterator();
+    base_node* n = root_;
+    while (!n->leaf) {
+      inner_node* in = static_cast<inner_node*>(n);
+      n = in->children[inner_upper_(in, key)];
+    }
+    leaf_node* l = static_cast<leaf_node*>(n);
+    unsigned p = leaf_upper_(l, key);
+    if (p == l->count && l->next != nullptr) {
+      l = l->next;
+      p = 0;
+    }
+    return iterator(l, p);
+  }
+  template <class Key>
+  iterator find_(const Key& key) const {
+    iterator ret = lower_pos_(key);
+    iterator last = last_ != nullptr ? iterator(last_, last_->count)
+                                     : iterator();
+    if (ret == last || comp_(key, key_of_(*ret))) {
+      return last;
+    }
+    return ret;
+  }
+  template <class Key>
+  iterator last_equal_(const Key& key) const {
+    iterator ret = upper_pos_(key);
+    iterator last = last_ != nullptr ? iterator(last_, last_->count)
+                                     : iterator();
+    if (ret == iterator(first_, 0)) {
+      return last;
+    }
+    --ret;
+    if (comp_(key_of_(*ret), key)) {
+      return last;
+    }
+    return ret;
+  }
+  template <class Key>
+  size_type count_(const Key& key) const {
+    size_type ret = 0;
+    iterator last = last_ != nullptr ? iterator(last_, last_->count)
+                                     : iterator();
+    for (iterator i = lower_pos_(key); i != last && !comp_(key, key_of_(*i));
+         ++i) {
+      ret++;
+    }
+    return ret;
+  }
+
+  // Slot manipulation inside the raw arrays of a node.
+  template <class T, class... Args>
+  static void insert_slot_(T* a, unsigned count, unsigned pos,
+                           Args&&... args) {
+    if (pos == count) {
+      ::new (static_cast<void*>(a + count)) T(std::forward<Args>(args)...);
+      return;
+    }
+    T tmp(std::forward<Args>(args)...);
+    ::new (static_cast<void*>(a + count)) T(std::move(a[count - 1]));
+    std::move_backward(a + pos, a + count - 1, a + count);
+    a[pos] = std::move(tmp);
+  }
+  template <class T>
+  static void erase_slot_(T* a, unsigned count, unsigned pos) {
+    std::move(a + pos + 1, a + count, a + pos);
+    a[count - 1].~T();
+  }
+  template <class T>
+  static void relocate_(T* src, unsigned n, T* dst) {
+    std::uninitialized_move(src, src + n, dst);
+    std::destroy(src, src + n);
+  }
+
+  leaf_node* new_leaf_() {
+    leaf_node* l = leaf_traits::allocate(leaf_alloc_, 1);
+    l->parent = nullptr;
+    l->count = 0;
+    l->leaf = true;
+    l->prev = l->next = nullptr;
+    return l;
+  }
+  inner_node* new_inner_() {
+    inner_node* n = inner_traits::allocate(inner_alloc_, 1);
+    n->parent = nullptr;
+    n->count = 0;
+    n->leaf = false;
+    return n;
+  }
+  void free_leaf_(leaf_node* l) { leaf_traits::deallocate(leaf_alloc_, l, 1); }
+  void free_inner_(inner_node* n) {
+    inner_traits::deallocate(inner_alloc_, n, 1);
+  }
+
+  static unsigned child_index_(const inner_node* p, const base_node* c) {
+    unsigned i = 0;
+    while (p->children[i] != c) {
+      i++;
+    }
+    return i;
+  }
+
+  // A full leaf is normally split in half. When the overflow came from
+  // appending to the rightmost leaf (sorted input) the left part is kept
+  // full instead, so bulk loads end up with packed leaves.
+  leaf_node* split_leaf_(leaf_node* l, bool append) {
+    leaf_node* r = new_leaf_();
+    unsigned keep = append ? l->count - 1 : l->count / 2;
+    relocate_(l->vals() + keep, l->count - keep, r->vals());
+    r->count = l->count - keep;
+    l->count = keep;
+    r->prev = l;
+    r->next = l->next;
+    if (l->next != nullptr) {
+      l->next->prev = r;
+    } else {
+      last_ = r;
+    }
+    l->next = r;
+    insert_parent_(l, key_of_(r->vals()[0]), r, append);
+    return r;
+  }
+  void split_inner_(inner_node* n, bool append) {
+    inner_node* r = new_inner_();
+    unsigned mid = append ? n->count - 2 : n->count / 2;
+    relocate_(n->keys() + mid + 1, n->count - mid - 1, r->keys());
+    for (unsigned j = mid + 1; j <= n->count; j++) {
+      r->children[j - mid - 1] = n->children[j];
+      n->children[j]->parent = r;
+    }
+    r->count = n->count - mid - 1;
+    K up(std::move(n->keys()[mid]));
+    n->keys()[mid].~K();
+    n->count = mid;
+    insert_parent_(n, up, r, append);
+  }
+  void insert_parent_(base_node* left, const K& key, base_node* right,
+                      bool append) {
+    inner_node* p = left->parent;
+    if (p == nullptr) {
+      p = new_inner_();
+      ::new (static_cast<void*>(p->keys())) K(key);
+      p->children[0] = left;
+      p->children[1] = right;
+      p->count = 1;
+      left->parent = right->parent = p;
+      root_ = p;
+      return;
+    }
+    unsigned i = child_index_(p, left);
+    insert_slot_(p->keys(), p->count, i, key);
+    for (unsigned j = p->count + 1; j > i + 1; j--) {
+      p->children[j] = p->children[j - 1];
+    }
+    p->children[i + 1] = right;
+    right->parent = p;
+    p->count++;
+    if (p->count > inner_capacity) {
+      split_inner_(p, append);
+    }
+  }
+
+  void remove_child_(inner_node* p, unsigned key_pos, unsigned child_pos) {
+    erase_slot_(p->keys(), p->count, key_pos);
+    for (unsigned j = child_pos; j < p->count; j++) {
+      p->children[j] = p->children[j + 1];
+    }
+    p->count--;
+  }
+  void rebalance_leaf_(leaf_node* l) {
+    inner_node* p = l->parent;
+    unsigned i = child_index_(p, l);
+    leaf_node* left =
+        i > 0 ? static_cast<leaf_node*>(p->children[i - 1]) : nullptr;
+    leaf_node* right =
+        i < p->count ? static_cast<leaf_node*>(p->children[i + 1]) : nullptr;
+    if (left != nullptr && left->count > min_leaf) {
+      value_type* from = left->vals() + left->count - 1;
+      insert_slot_(l->vals(), l->count, 0, std::move(*from));
+      from->~value_type();
+      left->count--;
+      l->count++;
+      p->keys()[i - 1] = key_of_(l->vals()[0]);
+    } else if (right != nullptr && right->count > min_leaf) {
+      ::new (static_cast<void*>(l->vals() + l->count))
+          value_type(std::move(right->vals()[0]));
+      l->count++;
+      erase_slot_(right->vals(), right->count, 0);
+      right->count--;
+      p->keys()[i] = key_of_(right->vals()[0]);
+    } else {
+      if (left != nullptr) {
+        merge_leaves_(left, l);
+        remove_child_(p, i - 1, i);
+      } else {
+        merge_leaves_(l, right);
+        remove_child_(p, i, i + 1);
+      }
+      rebalance_inner_(p);
+    }
+  }
+  void merge_leaves_(leaf_node* a, leaf_node* b) {
+    relocate_(b->vals(), b->count, a->vals() + a->count);
+    a->count += b->count;
+    a->next = b->next;
+    if (b->next != nullptr) {
+      b->next->prev = a;
+    } else {
+      last_ = a;
+    }
+    free_leaf_(b);
+  }
+  void rebalance_inner_(inner_node* n) {
+    if (n == root_) {
+      if (n->count == 0) {
+        root_ = n->children[0];
+        root_->parent = nullptr;
+        free_inner_(n);
+      }
+      return;
+    }
+    if (n->count >= min_inner) return;
+    inner_node* p = n->parent;
+    unsigned i = child_index_(p, n);
+    inner_node* left =
+        i > 0 ? static_cast<inner_node*>(p->children[i - 1]) : nullptr;
+    inner_node* right =
+        i < p->count ? static_cast<inner_node*>(p->children[i + 1]) : nullptr;
+    if (left != nullptr && left->count > min_inner) {
+      insert_slot_(n->keys(), n->count, 0, std::move(p->keys()[i - 1]));
+      for (unsigned j = n->count + 1; j > 0; j--) {
+        n->children[j] = n->children[j - 1];
+      }
+      n->children[0] = left->children[left->count];
+      n->children[0]->parent = n;
+      n->count++;
+      p->keys()[i - 1] = std::move(left->keys()[left->count - 1]);
+      left->keys()[left->count - 1].~K();
+      left->count--;
+    } else if (right != nullptr && right->count > min_inner) {
+      ::new (static_cast<void*>(n->keys() + n->count))
+          K(std::move(p->keys()[i]));
+      n->children[n->count + 1] = right->children[0];
+      n->children[n->count + 1]->parent = n;
+      n->count++;
+      p->keys()[i] = std::move(right->keys()[0]);
+      erase_slot_(right->keys(), right->count, 0);
+      for (unsigned j = 0; j < right->count; j++) {
+        right->children[j] = right->children[j + 1];
+      }
+      right->count--;
+    } else {
+      if (left != nullptr) {
+        merge_inner_(left, p->keys()[i - 1], n);
+        remove_child_(p, i - 1, i);
+      } else {
+        merge_inner_(n, p->keys()[i], right);
+        remove_child_(p, i, i + 1);
+      }
+      rebalance_inner_(p);
+    }
+  }
+  void merge_inner_(inner_node* a, const K& separator, inner_node* b) {
+    ::new (static_cast<void*>(a->keys() + a->count)) K(separator);
+    relocate_(b->keys(), b->count, a->keys() + a->count + 1);
+    for (unsigned j = 0; j <= b->count; j++) {
+      a->children[a->count + 1 + j] = b->children[j];
+      b->children[j]->parent = a;
+    }
+    a->count += b->count + 1;
+    free_inner_(b);
+  }
+
+  void copy_from_(const bplus_tree& other) {
+    if (other.root_ == nullptr) return;
+    leaf_node* prev = nullptr;
+    root_ = copy_node_(other.root_, nullptr, prev);
+    last_ = prev;
+    size_ = other.size_;
+  }
+  base_node* copy_node_(const base_node* src, inner_node* parent,
+                        leaf_node*& prev) {
+    if (src->leaf) {
+      const leaf_node* s = static_cast<const leaf_node*>(src);
+      leaf_node* l = new_leaf_();
+      std::uninitialized_copy(s->vals(), s->vals() + s->count, l->vals());
+      l->count = s->count;
+      l->parent = parent;
+      l->prev = prev;
+      if (prev != nullptr) {
+        prev->next = l;
+      } else {
+        first_ = l;
+      }
+      prev = l;
+      return l;
+    }
+    const inner_node* s = static_cast<const inner_node*>(src);
+    inner_node* n = new_inner_();
+    std::uninitialized_copy(s->keys(), s->keys() + s->count, n->keys());
+    n->count = s->count;
+    n->parent = parent;
+    for (unsigned j = 0; j <= s->count; j++) {
+      n->children[j] = copy_node_(s->children[j], n, prev);
+    }
+    return n;
+  }
+
+  void destroy_values_(base_node* n) {
+    if (n->leaf) {
+      leaf_node* l = static_cast<leaf_node*>(n);
+      std::destroy(l->vals(), l->vals() + l->count);
+      return;
+    }
+    inner_node* in = static_cast<inner_node*>(n);
+    std::destroy(in->keys(), in->keys() + in->count);
+    for (unsigned j = 0; j <= in->count; j++) {
+      destroy_values_(in->children[j]);
+    }
+  }
+  void destroy_subtree_(base_node* n) {
+    if (n->leaf) {
+      leaf_node* l = static_cast<leaf_node*>(n);
+      std::destroy(l->vals(), l->vals() + l->count);
+      free_leaf_(l);
+      return;
+    }
+    inner_node* in = static_cast<inner_node*>(n);
+    std::destroy(in->keys(), in->keys() + in->count);
+    for (unsigned j = 0; j <= in->count; j++) {
+      destroy_subtree_(in->children[j]);
+    }
+    free_inner_(in);
+  }
+};
+
+template <class Leaf>
+class iterator_bplus {
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = typename Leaf::value_type;
+  using pointer = value_type*;
+  using reference = value_type&;
+
+  template <class, class, class, bool, class, class>
+  friend class bplus_tree;
+  friend class const_iterator_bplus<Leaf>;
+
+  iterator_bplus() : leaf_(nullptr), idx_(0) {}
+  iterator_bplus(Leaf* leaf, unsigned idx) : leaf_(leaf), idx_(idx) {}
+  reference operator*() const { return leaf_->vals()[idx_]; }
+  pointer operator->() const { return leaf_->vals() + idx_; }
+  iterator_bplus& operator++() {
+    if (++idx_ == leaf_->count && leaf_->next != nullptr) {
+      leaf_ = leaf_->next;
+      idx_ = 0;
+    }
+    return *this;
+  }
+  iterator_bplus& operator--() {
+    if (idx_ == 0) {
+      leaf_ = leaf_->prev;
+      idx_ = leaf_->count;
+    }
+    idx_--;
+    return *this;
+  }
+  iterator_bplus operator++(int) {
+    iterator_bplus tmp = *this;
+    ++(*this);
+    return tmp;
+  }
+  iterator_bplus operator--(int) {
+    iterator_bplus tmp = *this;
+    --(*this);
+    return tmp;
+  }
+  operator const_iterator_bplus<Leaf>() const {
+    return const_iterator_bplus<Leaf>(leaf_, idx_);
+  }
+  friend bool operator==(const iterator_bplus& a, const iterator_bplus& b) {
+    return a.leaf_ == b.leaf_ && a.idx_ == b.idx_;
+  }
+  friend bool operator!=(const iterator_bplus& a, const iterator_bplus& b) {
+    return !(a == b);
+  }
+
+ private:
+  Leaf* leaf_;
+  unsigned idx_;
+};
+
+template <class Leaf>
+class const_iterator_bplus {
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = typename Leaf::value_type;
+  using pointer = const value_type*;
+  using reference = const value_type&;
+
+  template <class, class, class, bool, class, class>
+  friend class bplus_tree;
+  friend class iterator_bplus<Leaf>;
+
+  const_iterator_bplus() : leaf_(nullptr), idx_(0) {}
+  const_iterator_bplus(Leaf* leaf, unsigned idx) : leaf_(leaf), idx_(idx) {}
+  reference operator*() const { return leaf_->vals()[idx_]; }
+  pointer operator->() const { return leaf_->vals() + idx_; }
+  const_iterator_bplus& operator++() {
+    if (++idx_ == leaf_->count && leaf_->next != nullptr) {
+      leaf_ = leaf_->next;
+      idx_ = 0;
+    }
+    return *this;
+  }
+  const_iterator_bplus& operator--() {
+    if (idx_ == 0) {
+      leaf_ = leaf_->prev;
+      idx_ = leaf_->count;
+    }
+    idx_--;
+    return *this;
+  }
+  const_iterator_bplus operator++(int) {
+    const_iterator_bplus tmp = *this;
+    ++(*this);
+    return tmp;
+  }
+  const_iterator_bplus operator--(int) {
+    const_iterator_bplus tmp = *this;
+    --(*this);
+    return tmp;
+  }
+  operator iterator_bplus<Leaf>() const {
+    return iterator_bplus<Leaf>(leaf_, idx_);
+  }
+  friend bool operator==(const const_iterator_bplus& a,
+                         const const_iterator_bplus& b) {
+    return a.leaf_ == b.leaf_ && a.idx_ == b.idx_;
+  }
+  friend bool operator!=(const const_iterator_bplus& a,
+                         const const_iterator_bplus& b) {
+    return !(a == b);
+  }
+
+ private:
+  Leaf* leaf_;
+  unsigned idx_;
+};
+
+// Selects bplus_tree as the engine of set, map and multiset.
+struct bplus_tree_engine {
+  static constexpr bool ranked = false;
+  template <class K, class M, class Node, bool MULTI, class Compare,
+            class Allocator>
+  using type = bplus_tree<K, M, Node, MULTI, Compare, Allocator>;
+};
+
+}  // namespace s21
+
+#endif  // SRC_BPLUS_TREE
@@ -0,0 +1,237 @@
+#include "bplus_tree.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "map.h"
+#include "multiset.h"
+#include "set.h"
+
+template <class T>
+using set = s21::set<T, std::less<T>, s21::slab_allocator<T>,
+                     s21::bplus_tree_engine>;
+
+template <class T>
+using multiset = s21::multiset<T, std::less<T>, s21::slab_allocator<T>,
+                               s21::bplus_tree_engine>;
+
+template <class K, class V>
+using map = s21::map<K, V, std::less<K>, s21::slab_allocator<std::pair<K, V>>,
+                     s21::bplus_tree_engine>;
+
+class BplusTreeTest : public ::testing::Test {};
+
+TEST(BplusTreeTest, InsertAndIterate) {
+  set<int> A = {5, 3, 8, 1, 9, 2, 7};
+  std::set<int> B = {5, 3, 8, 1, 9, 2, 7};
+  EXPECT_EQ(A.size(), B.size());
+  auto j = B.begin();
+  for (auto i : A) {
+    EXPECT_EQ(i, *j);
+    j++;
+  }
+  auto ans = A.insert(5);
+  EXPECT_FALSE(ans.second);
+  EXPECT_EQ(*ans.first, 5);
+}
+
+TEST(BplusTreeTest, RandomAgainstStd) {
+  set<int> A;
+  std::set<int> B;
+  srand(21);
+  for (int i = 0; i < 20000; i++) {
+    int v = rand() % 5000;
+    auto a = A.insert(v);
+    auto b = B.insert(v);
+    EXPECT_EQ(a.second, b.second);
+    EXPECT_EQ(*a.first, *b.first);
+  }
+  for (int i = 0; i < 6000; i++) {
+    int v = rand() % 5000;
+    auto a = A.find(v);
+    auto b = B.find(v);
+    EXPECT_EQ(a == A.end(), b == B.end());
+    if (b != B.end()) {
+      A.erase(a);
+      B.erase(b);
+    }
+  }
+  EXPECT_EQ(A.size(), B.size());
+  auto j = B.begin();
+  for (auto i : A) {
+    EXPECT_EQ(i, *j);
+    j++;
+  }
+  auto k = B.end();
+  for (auto i = A.end(); i != A.begin();) {
+    --i;
+    --k;
+    EXPECT_EQ(*i, *k);
+  }
+}
+
+TEST(BplusTreeTest, EraseEverything) {
+  set<int> A;
+  for (int i = 0; i < 10000; i++) {
+    A.insert(i);
+  }
+  for (int i = 0; i < 10000; i++) {
+    EXPECT_EQ(*A.begin(), i);
+    A.erase(A.begin());
+  }
+  EXPECT_TRUE(A.empty());
+  EXPECT_TRUE(A.begin() == A.end());
+  for (int i = 10000; i > 0; i--) {
+    A.insert(i);
+  }
+  for (int i = 10000; i > 0; i--) {
+    A.erase(--A.end());
+  }
+  EXPECT_TRUE(A.empty());
+}
+
+TEST(BplusTreeTest, Bounds) {
+  set<int> A;
+  for (int i = 0; i < 1000; i += 2) {
+    A.insert(i);
+  }
+  EXPECT_EQ(*A.lower_bound(501), 502);
+  EXPECT_EQ(*A.lower_bound(500), 500);
+  EXPECT_TRUE(A.lower_bound(1000) == A.end());
+  EXPECT_EQ(*A.upper_bound(500), 500);
+  EXPECT_TRUE(A.upper_bound(501) == A.end());
+  EXPECT_TRUE(A.contains(998));
+  EXPECT_FALSE(A.contains(999));
+}
+
+TEST(BplusTreeTest, Multiset) {
+  multiset<int> A;
+  std::multiset<int> B;
+  for (int i = 0; i < 3000; i++) {
+    A.insert(i % 7);
+    B.insert(i % 7);
+  }
+  for (int i = 0; i < 7; i++) {
+    EXPECT_EQ(A.count(i), B.count(i));
+  }
+  for (int i = 0; i < 200; i++) {
+    A.erase(A.find(3));
+    B.erase(B.find(3));
+  }
+  EXPECT_EQ(A.count(3), B.count(3));
+  EXPECT_EQ(*A.lower_bound(3), 3);
+  EXPECT_EQ(*(++A.upper_bound(3)), 4);
+  auto j = B.begin();
+  for (auto i : A) {
+    EXPECT_EQ(i, *j);
+    j++;
+  }
+}
+
+TEST(BplusTreeTest, StringsCopyAndMove) {
+  set<std::string> A;
+  for (int i = 0; i < 500; i++) {
+    A.insert(std::to_string(i * 7919 % 1000) + std::string(20, 'x'));
+  }
+  set<std::string> B(A);
+  EXPECT_EQ(A.size(), B.size());
+  auto j = B.begin();
+  for (auto &i : A) {
+    EXPECT_EQ(i, *j);
+    j++;
+  }
+  set<std::string> C = std::move(A);
+  EXPECT_EQ(C.size(), B.size());
+  EXPECT_TRUE(A.empty());
+  B.clear();
+  EXPECT_TRUE(B.empty());
+}
+
+TEST(BplusTreeTest, Map) {
+  map<int, int> A;
+  std::map<int, int> B;
+  for (int i = 0; i < 2000; i++) {
+    A[i % 300] += i;
+    B[i % 300] += i;
+  }
+  for (int i = 0; i < 300; i++) {
+    EXPECT_EQ(A.at(i), B.at(i));
+  }
+  A.insert_or_assign(5, -1);
+  EXPECT_EQ(A.at(5), -1);
+  EXPECT_THROW(A.at(300), std::out_of_range);
+  EXPECT_EQ(A.size(), B.size());
+}
+
+TEST(BplusTreeTest, MergeAndSwap) {
+  set<int> A = {1, 3, 5};
+  set<int> B = {2, 4, 6};
+  A.merge(B);
+  EXPECT_TRUE(B.empty());
+  int e = 1;
+  for (auto i : A) {
+    EXPECT_EQ(i, e);
+    e++;
+  }
+  A.swap(B);
+  EXPECT_TRUE(A.empty());
+  EXPECT_EQ(B.size(), 6);
+}
+
+TEST(BplusTreeTest, Assign) {
+  std::vector<int> sorted;
+  for (int i = 0; i < 5000; i++) {
+    sorted.push_back(i);
+  }
+  set<int> A(sorted.begin(), sorted.end());
+  EXPECT_EQ(A.size(), sorted.size());
+  for (int i = 0; i < 5000; i += 2) {
+    A.erase(A.find(i));
+  }
+  EXPECT_EQ(A.size(), 2500);
+  std::vector<int> unsorted = {9, 2, 7, 2, 5};
+  A.assign(unsorted.begin(), unsorted.end());
+  std::vector<int> expected = {2, 5, 7, 9};
+  auto j = expected.begin();
+  for (auto i : A) {
+    EXPECT_EQ(i, *j);
+    j++;
+  }
+}
+
+TEST(BplusTreeTest, SetAlgebra) {
+  multiset<int> A = {1, 1, 2, 3, 3, 3};
+  multiset<int> B = {1, 3, 3, 4};
+  std::vector<int> expected = {1, 1, 2, 3, 3, 3, 4};
+  multiset<int> U = s21::set_union(A, B);
+  EXPECT_EQ(U.size(), expected.size());
+  EXPECT_TRUE(std::equal(U.begin(), U.end(), expected.begin()));
+  expected = {1, 3, 3};
+  multiset<int> I = s21::set_intersection(A, B);
+  EXPECT_EQ(I.size(), expected.size());
+  EXPECT_TRUE(std::equal(I.begin(), I.end(), expected.begin()));
+  expected = {1, 2, 3};
+  A.set_difference(std::move(B));
+  EXPECT_TRUE(B.empty());
+  EXPECT_EQ(A.size(), expected.size());
+  EXPECT_TRUE(std::equal(A.begin(), A.end(), expected.begin()));
+}
+
+TEST(BplusTreeTest, ForEach) {
+  set<int> A;
+  for (int i = 0; i < 3000; i++) {
+    A.insert(i * 2);
+  }
+  long sum = 0;
+  A.for_each([&sum](int v) { sum += v; });
+  EXPECT_EQ(sum, 2999L * 3000);
+  std::vector<int> visited;
+  A.for_each_range(101, 111, [&visited](int v) { visited.push_back(v); });
+  std::vector<int> expected = {102, 104, 106, 108, 110};
+  EXPECT_EQ(visited, expected);
+}
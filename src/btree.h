@@ -1,12 +1,20 @@
 #ifndef srcbtree
 #define srcbtree
+#include <algorithm>
 #include <cmath>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <memory>
 #include <queue>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "allocator.h"
+#include "thread_pool.h"
+
 namespace s21 {
 
 template <class K, class M, class Node, bool MULTI>
@@ -17,7 +25,30 @@ class const_iterator_btree;
 
 enum Color { RED, BLACK };
 
-template <class K, class M, class Node, bool MULTI>
+// Nodes of ranked_rb_tree_engine also count the elements of their subtree,
+// which turns the tree into an order statistics tree.
+template <bool Ranked>
+struct subtree_size {
+  static constexpr bool ranked = false;
+};
+template <>
+struct subtree_size<true> {
+  static constexpr bool ranked = true;
+  size_t size = 1;
+};
+
+// A node type with `static constexpr bool shared_links = true` is walked by
+// readers that take no lock (concurrent_map), so the tree stores its child
+// and root links atomically. Other trees keep plain stores.
+template <class Node, class = void>
+struct has_shared_links : std::false_type {};
+template <class Node>
+struct has_shared_links<Node, std::void_t<decltype(Node::shared_links)>>
+    : std::bool_constant<Node::shared_links> {};
+
+template <class K, class M, class Node, bool MULTI,
+          class Compare = std::less<K>,
+          class Allocator = slab_allocator<typename Node::value_type>>
 class btree {
  public:
   using key_type = K;
@@ -27,33 +58,37 @@ class btree {
   using iterator = iterator_btree<K, M, Node, MULTI>;
   using const_iterator = const_iterator_btree<K, M, Node, MULTI>;
   using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
 
  protected:
+  using node_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
   Node* root_;
   Node* front_;
   Node* back_;
   size_t size_;
+  Compare comp_;
+  node_allocator alloc_;
 
  public:
   // CONSTRUCTORS
 
   btree();
+  explicit btree(const Compare& comp);
   btree(std::initializer_list<value_type> const& keys);
+  template <class InputIt, class = typename std::iterator_traits<
+                               InputIt>::iterator_category>
+  btree(InputIt first, InputIt last);
   btree(const btree& ms);
   btree(btree&& ms);
   ~btree();
 
-  bool is_equal(K a, K b) const {
-    if (a == b) {
-      return true;
-    }
-    return false;
-  }
-  bool is_equal(std::pair<K, M> a, std::pair<K, M> b) const {
-    if (a.first == b.first) {
-      return true;
-    }
-    return false;
+  bool is_equal(const value_type& a, const value_type& b) const {
+    return !comp_(key_of_(a), key_of_(b)) && !comp_(key_of_(b), key_of_(a));
   }
 
   // OPERATORS
@@ -63,6 +98,36 @@ class btree {
 
   // METHODS
   void clear();
+  // Replaces the contents with [first, last). Input that is already sorted
+  // (strictly, for unique containers) is linked up in O(n) as a perfectly
+  // balanced tree, anything else is sorted into a buffer first.
+  template <class InputIt>
+  void assign(InputIt first, InputIt last) {
+    clear();
+    using category =
+        typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag,
+                                  category>::value) {
+      if (is_sorted_(first, last)) {
+        build_sorted_(first, std::distance(first, last));
+        return;
+      }
+    }
+    std::vector<value_type> buffer(first, last);
+    std::stable_sort(buffer.begin(), buffer.end(),
+                     [this](const value_type& a, const value_type& b) {
+                       return comp_(key_of_(a), key_of_(b));
+                     });
+    if (!MULTI) {
+      buffer.erase(std::unique(buffer.begin(), buffer.end(),
+                               [this](const value_type& a,
+                                      const value_type& b) {
+                                 return !comp_(key_of_(a), key_of_(b));
+                               }),
+                   buffer.end());
+    }
+    build_sorted_(std::make_move_iterator(buffer.begin()), buffer.size());
+  }
   iterator begin() {
     iterator ret(front_);
     return ret;
@@ -80,87 +145,41 @@ class btree {
     return ret;
   }
 
-  void erase(iterator pos) {
-    if (pos.ptr_ == front_) {
-      auto temp = this->begin();
-      temp++;
-      front_ = temp.ptr_;
-    }
-    // Case 1: node is leaf -> both children are nullptr.
-    if (pos->left == nullptr && pos->right == nullptr) {
-      replace_node_(pos.ptr_, pos->right);
-      if (pos.ptr_->color == BLACK) {
-        fixDoubleBlack(nullptr, pos.ptr_->parent);
-      }
-    } else
-        // Case2: one kid is nullptr
-        if (pos->left == nullptr) {
-      replace_node_(pos.ptr_, pos.ptr_->right);
-      if (pos.ptr_->color == BLACK && pos.ptr_->right->color == BLACK) {
-        fixDoubleBlack(pos->right);
-      } else {
-        pos.ptr_->right->color = BLACK;
-      }
-    } else if (pos->right == nullptr) {
-      replace_node_(pos.ptr_, pos.ptr_->left);
-      if (pos.ptr_->color == BLACK && pos.ptr_->left->color == BLACK) {
-        fixDoubleBlack(pos->left);
-      } else {
-        pos.ptr_->left->color = BLACK;
-      }
-    } else {  // case 3 - both kids exist
-      Node* successor = pos->right;
-      while (successor->left != nullptr) {
-        successor = successor->left;
-      }
-      if (successor->parent == pos.ptr_) {
-        replace_node_(pos.ptr_, successor);
-        if (successor->right != nullptr) {
-          if (successor->right->color == BLACK && successor->color == BLACK) {
-            fixDoubleBlack(successor->right);
-          } else {
-            successor->right->color = BLACK;
-            successor->color = pos.ptr_->color;
-          }
-        } else {
-          successor->color = pos.ptr_->color;
-          fixDoubleBlack(nullptr, successor);
-        }
-      } else {
-        if (successor->right != nullptr) {
-          successor->right->parent = successor->parent;
-        }
-        if (successor == successor->parent->left) {
-          successor->parent->left = successor->right;
-        } else {
-          successor->parent->right = successor->right;
-        }
-        if (successor->right != nullptr) {
-          if (successor->color == BLACK && successor->right->color == BLACK) {
-            fixDoubleBlack(successor->right);
-          } else {
-            successor->right->color = BLACK;
-          }
-        } else {
-          if (successor->color == BLACK) {
-            fixDoubleBlack(nullptr, successor->parent);
-            successor->color = pos.ptr_->color;
-          }
-        }
-        replace_node_(pos.ptr_, successor);
+  void erase(iterator pos) { destroy_node_(extract_node_(pos)); }
+  void merge(btree& other) { combine_with_(other, set_op_::merge); }
+  // Set algebra in place. An rvalue argument has its nodes relinked into
+  // *this and is left empty, an lvalue argument is copied first. Keys
+  // present in both keep the element of *this; multisets follow the
+  // multiplicities of std::set_union, std::set_intersection and
+  // std::set_difference. Big trees are split across fork_join_pool.
+  void set_union(btree&& other) { combine_with_(other, set_op_::unite); }
+  void set_union(const btree& other) {
+    btree copy(other);
+    combine_with_(copy, set_op_::unite);
+  }
+  void set_intersection(btree&& other) {
+    combine_with_(other, set_op_::intersect);
+  }
+  void set_intersection(const btree& other) {
+    btree copy(other);
+    combine_with_(copy, set_op_::intersect);
+  }
+  void set_difference(btree&& other) {
+    combine_with_(other, set_op_::subtract);
+  }
+  void set_difference(const btree& other) {
+    btree copy(other);
+    combine_with_(copy, set_op_::subtract);
+  }
+  size_type size() const { return size_; }
+  void reserve(size_type n) {
+    if constexpr (has_reserve<node_allocator>::value) {
+      if (n > size_) {
+        alloc_.reserve(n - size_);
       }
     }
-    delete pos.ptr_;
-  }
-  void merge(btree& other) {
-    size_ = size_ + other.size_;
-    Node* n = merge_(root_, other.root_);
-    other.root_ = nullptr;
-    other.size_ = 0;
-    root_ = n;
-    front_ = findFront(root_);
   }
-  size_type size() const { return size_; }
+  allocator_type get_allocator() const { return allocator_type(alloc_); }
   size_type max_size() const { return std::numeric_limits<value_type>::max(); }
   bool empty() const {
     if (root_ == nullptr) {
@@ -169,75 +188,325 @@ class btree {
       return false;
     }
   }
-  void swap(btree& other) {
-    btree<K, M, Node, MULTI> temp = other;
-    other = *this;
-    *this = temp;
+  // Exchanges the roots and counters, no node is touched.
+  void swap(btree& other) noexcept {
+    std::swap(root_, other.root_);
+    std::swap(front_, other.front_);
+    std::swap(back_, other.back_);
+    std::swap(size_, other.size_);
+    std::swap(comp_, other.comp_);
+    swap_allocators(alloc_, other.alloc_);
   }
-  size_type count(const value_type& key) const { return count_(key, root_); }
-  iterator find(const value_type& value) {
-    Node* ret = find_(value, root_);
-    return iterator(ret);
+  key_compare key_comp() const { return comp_; }
+  size_type count(const key_type& key) const { return count_(key); }
+  iterator find(const key_type& key) { return iterator(find_(key, root_)); }
+  const_iterator find(const key_type& key) const {
+    return const_iterator(find_(key, root_));
   }
-  const_iterator find(const value_type& value) const {
-    Node* ret = find_(value, root_);
-    return const_iterator(ret);
+  iterator lower_bound(const key_type& key) {
+    return iterator(lower_bound_(key));
   }
-  iterator lower_bound(const value_type& value) {
-    Node* ret = find_(value, root_);
-    Node* ans = ret;
-    while (ans->left != nullptr && (ans = find_(value, ans->left)) != nullptr) {
-      ret = ans;
-    }
-    return iterator(ret);
+  const_iterator lower_bound(const key_type& key) const {
+    return const_iterator(lower_bound_(key));
   }
-  iterator upper_bound(const value_type& value) {
-    Node* ret = find_(value, root_);
-    Node* ans = ret;
-    while (ans->right != nullptr &&
-           (ans = find_(value, ans->right)) != nullptr) {
-      ret = ans;
-    }
-    return iterator(ret);
+  // Last element equivalent to key, end() if there is none.
+  iterator upper_bound(const key_type& key) {
+    return iterator(last_equal_(key));
   }
-  const_iterator lower_bound(const value_type& value) const {
-    Node* ret = find_(value, root_);
-    Node* ans = ret;
-    while (ans->left != nullptr && (ans = find_(value, ans->left)) != nullptr) {
-      ret = ans;
-    }
-    return const_iterator(ret);
+  const_iterator upper_bound(const key_type& key) const {
+    return const_iterator(last_equal_(key));
   }
-  const_iterator upper_bound(const value_type& value) const {
-    Node* ret = find_(value, root_);
-    Node* ans = ret;
-    while (ans->right != nullptr &&
-           (ans = find_(value, ans->right)) != nullptr) {
-      ret = ans;
-    }
-    return const_iterator(ret);
+
+  // Heterogeneous lookup, only available with a transparent comparator such
+  // as std::less<>: the argument is compared as is, no key_type is built.
+  template <class Key, class C = Compare, class = typename C::is_transparent>
+  size_type count(const Key& key) const {
+    return count_(key);
+  }
+  template <class Key, class C = Compare, class = typename C::is_transparent>
+  iterator find(const Key& key) {
+    return iterator(find_(key, root_));
+  }
+  template <class Key, class C = Compare, class = typename C::is_transparent>
+  const_iterator find(const Key& key) const {
+    return const_iterator(find_(key, root_));
+  }
+  template <class Key, class C = Compare, class = typename C::is_transparent>
+  iterator lower_bound(const Key& key) {
+    return iterator(lower_bound_(key));
+  }
+  template <class Key, class C = Compare, class = typename C::is_transparent>
+  const_iterator lower_bound(const Key& key) const {
+    return const_iterator(lower_bound_(key));
   }
 
+  // Builds the element in its node; for unique containers the node is
+  // thrown away again if the key is already present.
   template <class... Args>
   std::pair<iterator, bool> emplace(Args&&... args) {
-    value_type val(args...);
-    return insert_iter(val);
+    return insert_node_(create_node_(std::forward<Args>(args)...));
+  }
+
+  // SCANS
+  // In-order visits without iterators: the path is kept on a small stack
+  // instead of being rediscovered through parent links, and the right
+  // subtree of every node is prefetched when the node is pushed, long before
+  // the walk gets there.
+  template <class Fn>
+  void for_each(Fn fn) {
+    scan_(root_, fn);
+  }
+  template <class Fn>
+  void for_each(Fn fn) const {
+    auto visit = [&fn](const value_type& v) { fn(v); };
+    scan_(root_, visit);
+  }
+  // Visits the elements in [lo, hi).
+  template <class Fn>
+  void for_each_range(const key_type& lo, const key_type& hi, Fn fn) {
+    scan_range_(lo, hi, fn);
+  }
+  template <class Fn>
+  void for_each_range(const key_type& lo, const key_type& hi, Fn fn) const {
+    auto visit = [&fn](const value_type& v) { fn(v); };
+    scan_range_(lo, hi, visit);
+  }
+
+  // ORDER STATISTICS
+  // O(log n), only available with ranked_rb_tree_engine. Positions count
+  // from zero in iteration order; end() sits at position size().
+  iterator nth(size_type k) { return iterator(nth_(k)); }
+  const_iterator nth(size_type k) const { return const_iterator(nth_(k)); }
+  // Number of elements that go before key.
+  size_type rank(const key_type& key) const { return rank_(key); }
+  template <class Key, class C = Compare, class = typename C::is_transparent>
+  size_type rank(const Key& key) const {
+    return rank_(key);
+  }
+  // Number of elements in [lo, hi).
+  size_type count_range(const key_type& lo, const key_type& hi) const {
+    size_type a = rank_(lo), b = rank_(hi);
+    return b > a ? b - a : 0;
+  }
+  size_type index_of(const_iterator it) const { return index_of_(it.ptr_); }
+  size_type index_of(iterator it) const { return index_of_(it.ptr_); }
+  void advance(iterator& it, difference_type n) const {
+    it = iterator(nth_(index_of_(it.ptr_) + n));
+  }
+  void advance(const_iterator& it, difference_type n) const {
+    it = const_iterator(nth_(index_of_(it.ptr_) + n));
+  }
+  difference_type distance(const_iterator first, const_iterator last) const {
+    return static_cast<difference_type>(index_of_(last.ptr_)) -
+           static_cast<difference_type>(index_of_(first.ptr_));
+  }
+  difference_type distance(iterator first, iterator last) const {
+    return static_cast<difference_type>(index_of_(last.ptr_)) -
+           static_cast<difference_type>(index_of_(first.ptr_));
   }
 
  protected:
   void show() { display(root_); }
   // HELPER FUNCTIONS
+  static const K& key_of_(const value_type& v) {
+    if constexpr (std::is_same<value_type, K>::value) {
+      return v;
+    } else {
+      return v.first;
+    }
+  }
+  // No red-black tree addressable in 64 bits is taller than this.
+  static constexpr int max_height_ = 128;
+
+  static void push_(Node** stack, int& top, Node* n) {
+    for (; n != nullptr; n = n->left) {
+      __builtin_prefetch(n->right);
+      stack[top++] = n;
+    }
+  }
+  template <class Fn>
+  static void scan_(Node* root, Fn& fn) {
+    Node* stack[max_height_];
+    int top = 0;
+    push_(stack, top, root);
+    while (top > 0) {
+      Node* n = stack[--top];
+      fn(n->key);
+      push_(stack, top, n->right);
+    }
+  }
+  template <class Fn>
+  void scan_range_(const key_type& lo, const key_type& hi, Fn& fn) const {
+    Node* stack[max_height_];
+    int top = 0;
+    for (Node* n = root_; n != nullptr;) {
+      if (comp_(key_of_(n->key), lo)) {
+        n = n->right;
+      } else {
+        __builtin_prefetch(n->right);
+        stack[top++] = n;
+        n = n->left;
+      }
+    }
+    while (top > 0) {
+      Node* n = stack[--top];
+      if (!comp_(key_of_(n->key), hi)) break;
+      fn(n->key);
+      push_(stack, top, n->right);
+    }
+  }
+  static size_type size_of_(const Node* n) {
+    if constexpr (Node::ranked) {
+      return n == nullptr ? 0 : n->size;
+    } else {
+      return 0;
+    }
+  }
+  static void update_size_(Node* n) {
+    if constexpr (Node::ranked) {
+      n->size = 1 + size_of_(n->left) + size_of_(n->right);
+    }
+  }
+  Node* nth_(size_type k) const {
+    static_assert(Node::ranked, "order statistics need ranked_rb_tree_engine");
+    Node* n = root_;
+    while (n != nullptr) {
+      size_type left = size_of_(n->left);
+      if (k < left) {
+        n = n->left;
+      } else if (k == left) {
+        return n;
+      } else {
+        k -= left + 1;
+        n = n->right;
+      }
+    }
+    return nullptr;
+  }
+  template <class Key>
+  size_type rank_(const Key& key) const {
+    static_assert(Node::ranked, "order statistics need ranked_rb_tree_engine");
+    size_type ret = 0;
+    for (Node* n = root_; n != nullptr;) {
+      if (comp_(key_of_(n->key), key)) {
+        ret += size_of_(n->left) + 1;
+        n = n->right;
+      } else {
+        n = n->left;
+      }
+    }
+    return ret;
+  }
+  size_type index_of_(const Node* n) const {
+    static_assert(Node::ranked, "order statistics need ranked_rb_tree_engine");
+    if (n == nullptr) return size_;
+    size_type ret = size_of_(n->left);
+    for (; n->parent != nullptr; n = n->parent) {
+      if (n == n->parent->right) {
+        ret += size_of_(n->parent->left) + 1;
+      }
+    }
+    return ret;
+  }
+  template <class It>
+  bool is_sorted_(It first, It last) const {
+    if (first == last) return true;
+    for (It next = std::next(first); next != last; ++first, ++next) {
+      bool ordered = MULTI ? !comp_(key_of_(*next), key_of_(*first))
+                           : comp_(key_of_(*first), key_of_(*next));
+      if (!ordered) return false;
+    }
+    return true;
+  }
+  // Builds the tree in order from n sorted values in a single pass. Subtree
+  // sizes never differ by more than one, so only the lowest level can be
+  // incomplete; it is coloured red and everything above it black.
+  template <class It>
+  void build_sorted_(It it, size_type n) {
+    reserve(n);
+    auto next = [this, &it] {
+      Node* node = create_node_(*it);
+      ++it;
+      return node;
+    };
+    root_ = build_(next, n, 0, red_depth_(n));
+    front_ = findFront(root_);
+    size_ = n;
+  }
+  // Depth of the lowest level of a perfectly balanced tree of n nodes, which
+  // is also its black height.
+  static int red_depth_(size_type n) {
+    int depth = 0;
+    while ((size_type(2) << depth) <= n + 1) {
+      depth++;
+    }
+    return depth;
+  }
+  template <class Next>
+  static Node* build_(Next& next, size_type n, int depth, int red_depth) {
+    if (n == 0) {
+      return nullptr;
+    }
+    Node* left = build_(next, n / 2, depth + 1, red_depth);
+    Node* node = next();
+    node->color = depth == red_depth ? RED : BLACK;
+    node->parent = nullptr;
+    node->left = left;
+    if (left != nullptr) {
+      left->parent = node;
+    }
+    node->right = build_(next, n - n / 2 - 1, depth + 1, red_depth);
+    if (node->right != nullptr) {
+      node->right->parent = node;
+    }
+    update_size_(node);
+    return node;
+  }
+  template <class... Args>
+  Node* create_node_(Args&&... args) {
+    Node* n = node_traits::allocate(alloc_, 1);
+    try {
+      node_traits::construct(alloc_, n, std::in_place,
+                             std::forward<Args>(args)...);
+    } catch (...) {
+      node_traits::deallocate(alloc_, n, 1);
+      throw;
+    }
+    return n;
+  }
+  void destroy_node_(Node* n) {
+    node_traits::destroy(alloc_, n);
+    node_traits::deallocate(alloc_, n, 1);
+  }
+  // Nodes of other are about to be linked into this tree, so whatever
+  // allocated them has to be able to free them through alloc_.
+  void adopt_nodes_(btree& other) {
+    if constexpr (has_adopt<node_allocator>::value) {
+      alloc_.adopt(other.alloc_);
+    }
+  }
+  template <class InputIt>
+  void insert_range_(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert_iter(*first);
+    }
+  }
   std::pair<iterator, bool> insert_iter(const value_type& key) {
+    return insert_node_(create_node_(key));
+  }
+  std::pair<iterator, bool> insert_iter(value_type&& key) {
+    return insert_node_(create_node_(std::move(key)));
+  }
+  std::pair<iterator, bool> insert_node_(Node* pt) {
     size_t increment = 1;
     size_ = increment + size_;
-    Node* pt = new Node(key, nullptr);
     Node* retret = pt;
     if (root_ == nullptr) {
       auto temp = this->BSTInsert(root_, pt);
       if (!temp.second) {
         return std::make_pair(iterator(temp.first), temp.second);
       }
-      root_ = temp.first;
+      publish_(root_, temp.first);
 
       front_ = root_;
     } else {
@@ -245,43 +514,67 @@ class btree {
       if (!temp.second) {
         return std::make_pair(iterator(temp.first), temp.second);
       }
-      root_ = temp.first;
     }
     this->fixViolation(root_, pt);
     return std::make_pair(iterator(retret), true);
   }
+  // One comparison per level: equal keys go right, so the last node we
+  // stepped right from is the only one that can be equivalent to pt.
   std::pair<Node*, bool> BSTInsert(Node*& root, Node* pt) {
     if (root == nullptr) return std::make_pair(pt, true);
-    if (pt->key <= root->key) {
-      if (is_equal(pt->key, root->key) && !MULTI) {
-        delete pt;
-        size_--;
-        return std::make_pair(root, false);
+    const K& key = key_of_(pt->key);
+    Node* parent = nullptr;
+    Node* candidate = nullptr;
+    bool left = false;
+    for (Node* r = root; r != nullptr;) {
+      parent = r;
+      left = comp_(key, key_of_(r->key));
+      if (left) {
+        r = r->left;
+      } else {
+        candidate = r;
+        r = r->right;
       }
-      if (root == front_) {
+    }
+    if (!MULTI && candidate != nullptr &&
+        !comp_(key_of_(candidate->key), key)) {
+      destroy_node_(pt);
+      size_--;
+      return std::make_pair(candidate, false);
+    }
+    pt->parent = parent;
+    if (left) {
+      publish_(parent->left, pt);
+      if (parent == front_) {
         front_ = pt;
       }
-      auto temp = BSTInsert(root->left, pt);
-      if (!temp.second) {
-        return std::make_pair(temp.first, temp.second);
-      }
-      root->left = temp.first;
-      root->left->parent = root;
-    } else if (pt->key > root->key) {
-      if (is_equal(pt->key, root->key) && !MULTI) {
-        delete pt;
-        size_--;
-        return std::make_pair(root, false);
-      }
-      auto temp = BSTInsert(root->right, pt);
-      if (!temp.second) {
-        return std::make_pair(temp.first, temp.second);
+    } else {
+      publish_(parent->right, pt);
+    }
+    if constexpr (Node::ranked) {
+      for (Node* n = parent; n != nullptr; n = n->parent) {
+        n->size++;
       }
-      root->right = temp.first;
-      root->right->parent = root;
     }
     return std::make_pair(root, true);
   }
+  // Stores a child or root link. With shared links readers may be walking
+  // the tree, so the store is atomic; publish_ is for a link to a new node,
+  // whose contents must be visible before the node is.
+  static void store_link_(Node*& slot, Node* value) {
+    if constexpr (has_shared_links<Node>::value) {
+      __atomic_store_n(&slot, value, __ATOMIC_RELAXED);
+    } else {
+      slot = value;
+    }
+  }
+  static void publish_(Node*& slot, Node* value) {
+    if constexpr (has_shared_links<Node>::value) {
+      __atomic_store_n(&slot, value, __ATOMIC_RELEASE);
+    } else {
+      slot = value;
+    }
+  }
   void clear_(Node* r);
   Node* findFront(Node* root_);
   void CopyTree(Node*& first_root, Node* second_root);
@@ -306,31 +599,35 @@ class btree {
 
   void rotateLeft(Node*& root, Node*& pt) {
     Node* pt_right = pt->right;
-    pt->right = pt_right->left;
+    store_link_(pt->right, pt_right->left);
     if (pt->right != nullptr) pt->right->parent = pt;
     pt_right->parent = pt->parent;
     if (pt->parent == nullptr)
-      root = pt_right;
+      store_link_(root, pt_right);
     else if (pt == pt->parent->left)
-      pt->parent->left = pt_right;
+      store_link_(pt->parent->left, pt_right);
     else
-      pt->parent->right = pt_right;
-    pt_right->left = pt;
+      store_link_(pt->parent->right, pt_right);
+    store_link_(pt_right->left, pt);
     pt->parent = pt_right;
+    update_size_(pt);
+    update_size_(pt_right);
   }
   void rotateRight(Node*& root, Node*& pt) {
     Node* pt_left = pt->left;
-    pt->left = pt_left->right;
+    store_link_(pt->left, pt_left->right);
     if (pt->left != nullptr) pt->left->parent = pt;
     pt_left->parent = pt->parent;
     if (pt->parent == nullptr)
-      root = pt_left;
+      store_link_(root, pt_left);
     else if (pt == pt->parent->left)
-      pt->parent->left = pt_left;
+      store_link_(pt->parent->left, pt_left);
     else
-      pt->parent->right = pt_left;
-    pt_left->right = pt;
+      store_link_(pt->parent->right, pt_left);
+    store_link_(pt_left->right, pt);
     pt->parent = pt_left;
+    update_size_(pt);
+    update_size_(pt_left);
   }
   void fixViolation(Node*& root, Node*& pt) {
     Node* parent_pt = nullptr;
@@ -376,155 +673,121 @@ class btree {
     }
     root->color = BLACK;
   }
-  void replace_node_(Node* old_node, Node* new_node) {
-    if (old_node->parent != nullptr) {
-      if (old_node == old_node->parent->left) {
-        old_node->parent->left = new_node;
-      } else {
-        old_node->parent->right = new_node;
-      }
+  // Unlinks the node (or, with two children, its successor, which then
+  // takes its place) and repairs the colours bottom-up from where a black
+  // node went missing. The node itself is left for the caller to free.
+  Node* extract_node_(iterator pos) {
+    Node* z = pos.ptr_;
+    if (z == front_) {
+      ++pos;
+      front_ = pos.ptr_;
     }
-    if (new_node != nullptr) {
-      new_node->parent = old_node->parent;
-      if (old_node->left != new_node) {
-        new_node->left = old_node->left;
-        if (old_node->left != nullptr) {
-          old_node->left->parent = new_node;
-        }
+    size_--;
+    Color removed = z->color;
+    Node* x;
+    Node* x_parent;
+    if (z->left == nullptr || z->right == nullptr) {
+      x = z->left != nullptr ? z->left : z->right;
+      x_parent = z->parent;
+      transplant_(z, x);
+    } else {
+      Node* y = z->right;
+      while (y->left != nullptr) {
+        y = y->left;
       }
-      if (old_node->right != new_node) {
-        new_node->right = old_node->right;
-        if (old_node->right != nullptr) {
-          old_node->right->parent = new_node;
-        }
+      removed = y->color;
+      x = y->right;
+      if (y->parent == z) {
+        x_parent = y;
+      } else {
+        x_parent = y->parent;
+        transplant_(y, x);
+        store_link_(y->right, z->right);
+        y->right->parent = y;
       }
+      transplant_(z, y);
+      store_link_(y->left, z->left);
+      y->left->parent = y;
+      y->color = z->color;
     }
-    if (old_node == root_) {
-      root_ = new_node;
+    for (Node* n = x_parent; n != nullptr; n = n->parent) {
+      update_size_(n);
     }
-  }
-  Node* get_sibling(Node* u) {
-    // Assume u no root
-    if (u == u->parent->left) {
-      return u->parent->right;
-    } else {
-      return u->parent->left;
-    }
-  }
-  Node* get_red_kid(Node* n) {
-    Node* ret = nullptr;
-    if (n->left->color == RED) {
-      ret = n->left;
-    } else if (n->right->color == RED) {
-      ret = n->right;
-    }
-    return ret;
-  }
-  void fix_tree_after_erase(Node* u, Node* v) {
-    // Simple case - either u or v is RED
-    if (v->color == RED || (u != nullptr && u->color == RED)) {
-      u->color = BLACK;
-    } else {
-      fixDoubleBlack(u);
+    if (removed == BLACK) {
+      fix_erase_(x, x_parent);
     }
+    return z;
   }
-  bool is_on_left(Node* n) {
-    if (n->parent == nullptr) {
-      return false;
-    } else if (n->parent->left == n) {
-      return true;
+  void transplant_(Node* old_node, Node* new_node) {
+    if (old_node->parent == nullptr) {
+      store_link_(root_, new_node);
+    } else if (old_node == old_node->parent->left) {
+      store_link_(old_node->parent->left, new_node);
     } else {
-      return false;
-    }
-  }
-  bool has_red_kid(Node* n) {
-    bool ret = false;
-    if (n->left != nullptr && n->left->color == RED) {
-      ret = true;
+      store_link_(old_node->parent->right, new_node);
     }
-    if (n->right != nullptr && n->right->color == RED) {
-      ret = true;
+    if (new_node != nullptr) {
+      new_node->parent = old_node->parent;
     }
-    return ret;
   }
-  void fixDoubleBlack(Node* x, Node* y = nullptr) {
-    if (x == root_)
-      // Reached root
-      return;
-
-    Node *sibling, *parent;
-    if (y == nullptr) {
-      sibling = get_sibling(x);
-      parent = x->parent;
-    } else {
-      parent = y;
-      if (y->left != nullptr) {
-        sibling = y->left;
-      } else {
-        sibling = y->right;
-      }
-    }
-    if (sibling == NULL) {
-      // No sibiling, double black pushed up
-      fixDoubleBlack(parent);
-    } else {
-      if (sibling->color == RED) {
-        // Sibling red
-        parent->color = RED;
-        sibling->color = BLACK;
-        if (is_on_left(sibling)) {
-          // left case
-          rotateRight(root_, parent);
-        } else {
-          // right case
+  // x (possibly nullptr, hence the separate parent) is one black short.
+  void fix_erase_(Node* x, Node* parent) {
+    while (x != root_ && is_black_(x)) {
+      if (x == parent->left) {
+        Node* sibling = parent->right;
+        if (sibling->color == RED) {
+          sibling->color = BLACK;
+          parent->color = RED;
           rotateLeft(root_, parent);
+          sibling = parent->right;
         }
-        if (x != nullptr) {
-          fixDoubleBlack(x);
+        if (is_black_(sibling->left) && is_black_(sibling->right)) {
+          sibling->color = RED;
+          x = parent;
+          parent = x->parent;
         } else {
-          fixDoubleBlack(x, parent);
-        }
-      } else {
-        // Sibling black
-        if (has_red_kid(sibling)) {
-          // at least 1 red children
-          if (sibling->left != NULL and sibling->left->color == RED) {
-            if (is_on_left(sibling)) {
-              // left left
-              sibling->left->color = sibling->color;
-              sibling->color = parent->color;
-              rotateRight(root_, parent);
-            } else {
-              // right left
-              sibling->left->color = parent->color;
-              rotateRight(root_, sibling);
-              rotateLeft(root_, parent);
-            }
-          } else {
-            if (is_on_left(sibling)) {
-              // left right
-              sibling->right->color = parent->color;
-              rotateLeft(root_, sibling);
-              rotateRight(root_, parent);
-            } else {
-              // right right
-              sibling->right->color = sibling->color;
-              sibling->color = parent->color;
-              rotateLeft(root_, parent);
-            }
+          if (is_black_(sibling->right)) {
+            sibling->left->color = BLACK;
+            sibling->color = RED;
+            rotateRight(root_, sibling);
+            sibling = parent->right;
           }
+          sibling->color = parent->color;
           parent->color = BLACK;
-        } else {
-          // 2 black children
+          sibling->right->color = BLACK;
+          rotateLeft(root_, parent);
+          x = root_;
+        }
+      } else {
+        Node* sibling = parent->left;
+        if (sibling->color == RED) {
+          sibling->color = BLACK;
+          parent->color = RED;
+          rotateRight(root_, parent);
+          sibling = parent->left;
+        }
+        if (is_black_(sibling->left) && is_black_(sibling->right)) {
           sibling->color = RED;
-          if (parent->color == BLACK) {
-            fixDoubleBlack(parent);
-          } else {
-            parent->color = BLACK;
+          x = parent;
+          parent = x->parent;
+        } else {
+          if (is_black_(sibling->left)) {
+            sibling->right->color = BLACK;
+            sibling->color = RED;
+            rotateLeft(root_, sibling);
+            sibling = parent->left;
           }
+          sibling->color = parent->color;
+          parent->color = BLACK;
+          sibling->left->color = BLACK;
+          rotateRight(root_, parent);
+          x = root_;
         }
       }
     }
+    if (x != nullptr) {
+      x->color = BLACK;
+    }
   }
   Node*& getRoot() { return root_; }
   int isRedBlack(Node* n) {
@@ -542,189 +805,435 @@ class btree {
       return a;
     }
   }
-  int getTreeHeight(Node* root) {
-    if (root == nullptr) {
-      return 1;
-    } else if (root->color == BLACK) {
-      return getTreeHeight(root->right) + 1;
+  // JOIN-BASED SET ALGEBRA
+  // The operations below never allocate: nodes of both trees are relinked,
+  // a subtree travels together with its black height, and nodes that drop
+  // out are collected and only destroyed after all parallel work is done.
+  enum class set_op_ { merge, unite, intersect, subtract };
+  struct part_ {
+    Node* root;
+    int bh;
+  };
+  struct graveyard_ {
+    Node* head = nullptr;
+    Node* tail = nullptr;
+    size_type count = 0;
+
+    void bury(Node* n) {
+      n->right = head;
+      head = n;
+      if (tail == nullptr) tail = n;
+      count++;
+    }
+    // Buries the first k nodes of a list threaded through right links and
+    // returns the rest.
+    Node* bury_first(Node* list, size_type k) {
+      for (; k > 0; k--) {
+        Node* next = list->right;
+        bury(list);
+        list = next;
+      }
+      return list;
+    }
+    void bury_tree(Node* n) {
+      if (n == nullptr) return;
+      Node* l = n->left;
+      Node* r = n->right;
+      bury(n);
+      bury_tree(l);
+      bury_tree(r);
+    }
+    void splice(graveyard_& other) {
+      if (other.head == nullptr) return;
+      other.tail->right = head;
+      head = other.head;
+      if (tail == nullptr) tail = other.tail;
+      count += other.count;
+    }
+  };
+  // Below this black height (at least 2^h - 1 nodes) on both sides forking
+  // costs more than it saves.
+  static constexpr int fork_height_ = 9;
+
+  void combine_with_(btree& other, set_op_ op) {
+    if (this == &other) {
+      if (op == set_op_::subtract) clear();
+      return;
+    }
+    adopt_nodes_(other);
+    graveyard_ dead;
+    part_ r = combine_({root_, black_height_(root_)},
+                       {other.root_, black_height_(other.root_)}, op, dead);
+    size_ = size_ + other.size_ - dead.count;
+    other.root_ = other.front_ = nullptr;
+    other.size_ = 0;
+    for (Node* n = dead.head; n != nullptr;) {
+      Node* next = n->right;
+      destroy_node_(n);
+      n = next;
+    }
+    root_ = r.root;
+    if (root_ != nullptr) {
+      root_->parent = nullptr;
+      root_->color = BLACK;
+    }
+    front_ = findFront(root_);
+  }
+  // The root of b is the pivot: a is split around its key, both halves are
+  // combined recursively (in parallel for big trees) and joined again.
+  part_ combine_(part_ a, part_ b, set_op_ op, graveyard_& dead) const {
+    if (a.root == nullptr || b.root == nullptr) {
+      if (op == set_op_::merge || op == set_op_::unite) {
+        return a.root != nullptr ? a : b;
+      }
+      dead.bury_tree(b.root);
+      if (op == set_op_::subtract) return a;
+      dead.bury_tree(a.root);
+      return {nullptr, 0};
+    }
+    part_ al, ae, ar, bl, be, br;
+    split3_(a, key_of_(b.root->key), al, ae, ar);
+    if constexpr (MULTI) {
+      split3_(b, key_of_(b.root->key), bl, be, br);
     } else {
-      return getTreeHeight(root->right);
-    }
-  }
-  Node* joinSimple(Node* tl, value_type k, Node* tr, Color c) {
-    Node* kk = new Node(k, nullptr);
-    if (tl != nullptr) tl->parent = kk;
-    if (tr != nullptr) tr->parent = kk;
-    kk->left = tl;
-    kk->right = tr;
-    kk->color = c;
-    // delete k;
-    return kk;
-  }
-  Color getColor(Node* n) {
-    if (n != nullptr) {
-      return n->color;
+      int h = child_bh_(b);
+      bl = {b.root->left, h};
+      br = {b.root->right, h};
+      be = {b.root, 1};
+      be.root->left = be.root->right = nullptr;
+      be.root->color = BLACK;
+      update_size_(be.root);
+    }
+    part_ l, r;
+    graveyard_ right_dead;
+    auto left_half = [&] { l = combine_(al, bl, op, dead); };
+    auto right_half = [&] { r = combine_(ar, br, op, right_dead); };
+    if (std::min(a.bh, b.bh) >= fork_height_) {
+      fork_join_pool::instance().invoke(left_half, right_half);
     } else {
-      return BLACK;
+      left_half();
+      right_half();
+    }
+    dead.splice(right_dead);
+    part_ m = equal_run_(ae, be, op, dead);
+    if (m.root != nullptr && m.root->left == nullptr &&
+        m.root->right == nullptr) {
+      return join_(l, m.root, r);
+    }
+    return join2_(join2_(l, m), r);
+  }
+  // Decides which of the elements equivalent to the pivot survive: a's
+  // element for unique containers, the multiplicities of std::set_union,
+  // std::set_intersection and std::set_difference for multisets.
+  part_ equal_run_(part_ a, part_ b, set_op_ op, graveyard_& dead) const {
+    if constexpr (!MULTI) {
+      if (op == set_op_::subtract || a.root == nullptr) {
+        dead.bury_tree(a.root);
+        if (op == set_op_::merge || op == set_op_::unite) return b;
+        dead.bury_tree(b.root);
+        return {nullptr, 0};
+      }
+      dead.bury_tree(b.root);
+      return a;
+    } else {
+      if (op == set_op_::merge) return join2_(a, b);
+      Node* last = a.root;
+      while (last != nullptr && last->right != nullptr) last = last->right;
+      size_type nx = 0, ny = 0;
+      Node* keep = thread_(a.root, nullptr, nx);
+      Node* y = thread_(b.root, nullptr, ny);
+      size_type common = std::min(nx, ny);
+      size_type n = common;
+      if (op == set_op_::unite) {
+        y = dead.bury_first(y, common);
+        if (last != nullptr) {
+          last->right = y;
+        } else {
+          keep = y;
+        }
+        n = nx + ny - common;
+      } else {
+        dead.bury_first(y, ny);
+        if (op == set_op_::intersect) {
+          Node* rest = keep;
+          for (size_type i = 0; i < common; i++) rest = rest->right;
+          dead.bury_first(rest, nx - common);
+        } else {
+          keep = dead.bury_first(keep, common);
+          n = nx - common;
+        }
+      }
+      int red_depth = red_depth_(n);
+      auto next = [&keep] {
+        Node* node = keep;
+        keep = keep->right;
+        return node;
+      };
+      return {build_(next, n, 0, red_depth), red_depth};
     }
   }
-  Node* joinRightRB(Node* tl, value_type k, Node* tr) {
-    int tl_height = getTreeHeight(tl);
-    int tr_height = getTreeHeight(tr);
-    if (getColor(tl) == BLACK && tl_height == tr_height) {
-      Node* ret = joinSimple(tl, k, tr, RED);
-      return ret;
+  // Threads the nodes of t in order through their right links, followed by
+  // rest, and adds their number to count.
+  static Node* thread_(Node* t, Node* rest, size_type& count) {
+    if (t == nullptr) return rest;
+    Node* l = t->left;
+    t->right = thread_(t->right, rest, count);
+    count++;
+    return thread_(l, t, count);
+  }
+  static bool is_black_(const Node* n) {
+    return n == nullptr || n->color == BLACK;
+  }
+  static int black_height_(const Node* t) {
+    int h = 0;
+    for (; t != nullptr; t = t->left) {
+      h += t->color == BLACK;
     }
-    Node* t = joinSimple(tl->left, tl->key, joinRightRB(tl->right, k, tr),
-                         getColor(tl));
-    t->parent = tl->parent;
-
-    if (getColor(tl) == BLACK && getColor(t->right) == RED &&
-        getColor(t->right->right) == RED) {
-      t->right->right->color = BLACK;
-      rotateLeft(root_, t);
-      delete tl;
-      return t->parent;
-    }
-    delete tl;
-    return t;
-  }
-  Node* joinLeftRB(Node* tl, value_type k, Node* tr) {
-    int tl_height = getTreeHeight(tl);
-    int tr_height = getTreeHeight(tr);
-    if (getColor(tr) == BLACK && tl_height == tr_height) {
-      Node* ret = joinSimple(tl, k, tr, RED);
-      return ret;
-    }
-    Node* t = joinSimple(joinLeftRB(tl, k, tr->left), tr->key, tr->right,
-                         getColor(tr));
-    t->parent = tr->parent;
-
-    if (getColor(tr) == BLACK && getColor(t->left) == RED &&
-        getColor(t->left->left) == RED) {
-      t->left->left->color = BLACK;
-      rotateRight(root_, t);
-      delete tr;
-      return t->parent;
-    }
-    delete tr;
-    return t;
-  }
-  Node* join(Node* tl, value_type k, Node* tr) {
-    int tl_height = getTreeHeight(tl);
-    int tr_height = getTreeHeight(tr);
-    if (tl_height > tr_height) {
-      Node* t = joinRightRB(tl, k, tr);
-      if (getColor(t) == RED && getColor(t->right) == RED) {
+    return h;
+  }
+  static int child_bh_(const part_& t) {
+    return t.bh - (t.root->color == BLACK);
+  }
+  static Node* link_(Node* p, Node* l, Node* r) {
+    p->left = l;
+    p->right = r;
+    if (l != nullptr) l->parent = p;
+    if (r != nullptr) r->parent = p;
+    update_size_(p);
+    return p;
+  }
+  // Walks down the right spine of the taller tree l until the black heights
+  // match; the result may have a red root with a red right child, which
+  // join_ repairs by blackening the root.
+  static Node* join_right_(Node* l, int hl, Node* k, Node* r, int hr) {
+    if (is_black_(l) && hl == hr) {
+      k->color = RED;
+      return link_(k, l, r);
+    }
+    Node* t = join_right_(l->right, hl - (l->color == BLACK), k, r, hr);
+    link_(l, l->left, t);
+    if (l->color == BLACK && !is_black_(t) && !is_black_(t->right)) {
+      t->right->color = BLACK;
+      link_(l, l->left, t->left);
+      return link_(t, l, t->right);
+    }
+    return l;
+  }
+  static Node* join_left_(Node* l, int hl, Node* k, Node* r, int hr) {
+    if (is_black_(r) && hl == hr) {
+      k->color = RED;
+      return link_(k, l, r);
+    }
+    Node* t = join_left_(l, hl, k, r->left, hr - (r->color == BLACK));
+    link_(r, t, r->right);
+    if (r->color == BLACK && !is_black_(t) && !is_black_(t->left)) {
+      t->left->color = BLACK;
+      link_(r, t->right, r->right);
+      return link_(t, t->left, r);
+    }
+    return r;
+  }
+  // Every key of l goes before k and every key of r after it.
+  static part_ join_(part_ l, Node* k, part_ r) {
+    Node* t;
+    int h;
+    if (l.bh > r.bh) {
+      t = join_right_(l.root, l.bh, k, r.root, r.bh);
+      h = l.bh;
+      if (!is_black_(t) && !is_black_(t->right)) {
         t->color = BLACK;
+        h++;
       }
-      return t;
-    }
-    if (tr_height > tl_height) {
-      Node* t = joinLeftRB(tl, k, tr);
-      if (getColor(t) == RED && getColor(t->left) == RED) {
+    } else if (r.bh > l.bh) {
+      t = join_left_(l.root, l.bh, k, r.root, r.bh);
+      h = r.bh;
+      if (!is_black_(t) && !is_black_(t->left)) {
         t->color = BLACK;
+        h++;
       }
-      return t;
+    } else {
+      t = link_(k, l.root, r.root);
+      t->color = is_black_(l.root) && is_black_(r.root) ? RED : BLACK;
+      h = l.bh + (t->color == BLACK);
     }
-    if (getColor(tl) == BLACK && getColor(tr) == BLACK) {
-      return joinSimple(tl, k, tr, RED);
+    t->parent = nullptr;
+    return {t, h};
+  }
+  static part_ join2_(part_ l, part_ r) {
+    if (l.root == nullptr) return r;
+    Node* last;
+    part_ rest = split_last_(l, last);
+    return join_(rest, last, r);
+  }
+  static part_ split_last_(part_ t, Node*& last) {
+    int h = child_bh_(t);
+    if (t.root->right == nullptr) {
+      last = t.root;
+      return {t.root->left, h};
+    }
+    part_ rest = split_last_({t.root->right, h}, last);
+    return join_({t.root->left, h}, t.root, rest);
+  }
+  // Keys before key go to l, the rest to r; with after set, keys equivalent
+  // to key go to l as well.
+  template <class Key>
+  void split2_(part_ t, const Key& key, bool after, part_& l,
+               part_& r) const {
+    if (t.root == nullptr) {
+      l = r = {nullptr, 0};
+      return;
+    }
+    Node* n = t.root;
+    int h = child_bh_(t);
+    bool to_right = after ? comp_(key, key_of_(n->key))
+                          : !comp_(key_of_(n->key), key);
+    part_ x;
+    if (to_right) {
+      Node* right = n->right;
+      split2_({n->left, h}, key, after, l, x);
+      r = join_(x, n, {right, h});
+    } else {
+      Node* left = n->left;
+      split2_({n->right, h}, key, after, x, r);
+      l = join_({left, h}, n, x);
     }
-    return joinSimple(tl, k, tr, BLACK);
   }
-  struct triplet {
-    Node* first;
-    bool second;
-    Node* third;
-    triplet(Node* a, bool b, Node* c) : first(a), second(b), third(c) {}
-  };
-  triplet split(Node*& t, value_type k) {
-    if (t == nullptr) {
-      return triplet(nullptr, false, nullptr);
+  // Splits t into keys before key, keys equivalent to it and keys after it.
+  template <class Key>
+  void split3_(part_ t, const Key& key, part_& l, part_& e,
+               part_& r) const {
+    if (t.root == nullptr) {
+      l = e = r = {nullptr, 0};
+      return;
     }
-    if (k == t->key) {
-      triplet a = triplet(t->left, true, t->right);
-      return a;
+    Node* n = t.root;
+    Node* left = n->left;
+    Node* right = n->right;
+    int h = child_bh_(t);
+    part_ x;
+    if (comp_(key, key_of_(n->key))) {
+      split3_({left, h}, key, l, e, x);
+      r = join_(x, n, {right, h});
+    } else if (comp_(key_of_(n->key), key)) {
+      split3_({right, h}, key, x, e, r);
+      l = join_({left, h}, n, x);
+    } else if constexpr (!MULTI) {
+      l = {left, h};
+      r = {right, h};
+      n->left = n->right = nullptr;
+      n->color = BLACK;
+      update_size_(n);
+      e = {n, 1};
+    } else {
+      part_ y;
+      split2_({left, h}, key, false, l, x);
+      split2_({right, h}, key, true, y, r);
+      e = join_(x, n, y);
     }
-    if (k <= t->key) {
-      triplet a = split(t->left, k);
-      triplet ret = triplet(a.first, a.second, join(a.third, t->key, t->right));
-      size_--;
-      delete t;
-      return ret;
+  }
+  template <class Key>
+  size_type count_(const Key& key) const {
+    size_type ret = 0;
+    const_iterator i(lower_bound_(key));
+    while (i.ptr_ != nullptr && !comp_(key, key_of_(i.ptr_->key))) {
+      ret++;
+      ++i;
     }
-    triplet a = split(t->right, k);
-    triplet ret = triplet(join(t->left, t->key, a.first), a.second, a.third);
-    delete t;
     return ret;
   }
-  Node* merge_(Node*& t1, Node*& t2) {
-    if (t1 == nullptr) {
-      return t2;
-    }
-    if (t2 == nullptr) {
-      return t1;
+  // Lookups walk down with a single comp_ call per node and settle
+  // equivalence with one extra call at the end.
+  template <class Key>
+  Node* lower_bound_(const Key& key) const {
+    Node* ret = nullptr;
+    Node* r = root_;
+    while (r != nullptr) {
+      if (!comp_(key_of_(r->key), key)) {
+        ret = r;
+        r = r->left;
+      } else {
+        r = r->right;
+      }
     }
-    triplet a = split(t1, t2->key);
-    Node* tl = merge_(a.first, t2->left);
-    Node* tr = merge_(a.third, t2->right);
-    Node* ret = join(tl, t2->key, tr);
-
-    delete t2;
     return ret;
   }
-  size_type count_(value_type key, Node* r) const {
-    if (r == nullptr) {
-      return 0;
+  template <class Key>
+  Node* last_equal_(const Key& key) const {
+    Node* ret = nullptr;
+    Node* r = root_;
+    while (r != nullptr) {
+      if (!comp_(key, key_of_(r->key))) {
+        ret = r;
+        r = r->right;
+      } else {
+        r = r->left;
+      }
     }
-    size_type ret = 0;
-    if (r->key == key) {
-      ret += 1;
-      ret += count_(key, r->left);
-      ret += count_(key, r->right);
-    } else if (r->key < key) {
-      ret += count_(key, r->right);
-    } else if (r->key > key) {
-      ret += count_(key, r->left);
+    if (ret != nullptr && comp_(key_of_(ret->key), key)) {
+      ret = nullptr;
     }
     return ret;
   }
-  Node* find_(const value_type& key, Node* r) const {
-    if (r == nullptr) {
-      return nullptr;
-    }
-    if (is_equal(r->key, key)) {
-      return r;
+  template <class Key>
+  Node* find_(const Key& key, Node* r) const {
+    Node* ret = nullptr;
+    while (r != nullptr) {
+      if (!comp_(key_of_(r->key), key)) {
+        ret = r;
+        r = r->left;
+      } else {
+        r = r->right;
+      }
     }
-    if (r->key > key) {
-      return find_(key, r->left);
-    } else {
-      return find_(key, r->right);
+    if (ret != nullptr && comp_(key, key_of_(ret->key))) {
+      ret = nullptr;
     }
+    return ret;
   }
 };
-template <class K, class M, class Node, bool MULTI>
-btree<K, M, Node, MULTI>::btree() {
+template <class K, class M, class Node, bool MULTI, class Compare,
+          class Allocator>
+btree<K, M, Node, MULTI, Compare, Allocator>::btree() {
   root_ = nullptr;
   front_ = back_ = nullptr;
   size_ = 0;
 }
-template <class K, class M, class Node, bool MULTI>
-btree<K, M, Node, MULTI>::btree(
+template <class K, class M, class Node, bool MULTI, class Compare,
+          class Allocator>
+btree<K, M, Node, MULTI, Compare, Allocator>::btree(const Compare& comp)
+    : comp_(comp) {
+  root_ = nullptr;
+  front_ = back_ = nullptr;
+  size_ = 0;
+}
+template <class K, class M, class Node, bool MULTI, class Compare,
+          class Allocator>
+btree<K, M, Node, MULTI, Compare, Allocator>::btree(
     std::initializer_list<value_type> const& values) {
   root_ = nullptr;
   front_ = back_ = nullptr;
   size_ = 0;
-  for (auto i : values) {
-    this->insert_iter(i);
-  }
+  assign(values.begin(), values.end());
 }
 
-template <class K, class M, class Node, bool MULTI>
-btree<K, M, Node, MULTI>::btree(const btree& ms) {
+template <class K, class M, class Node, bool MULTI, class Compare,
+          class Allocator>
+template <class InputIt, class>
+btree<K, M, Node, MULTI, Compare, Allocator>::btree(InputIt first,
+                                                    InputIt last) {
+  root_ = nullptr;
+  front_ = back_ = nullptr;
+  size_ = 0;
+  assign(first, last);
+}
+
+template <class K, class M, class Node, bool MULTI, class Compare,
+          class Allocator>
+btree<K, M, Node, MULTI, Compare, Allocator>::btree(const btree& ms)
+    : comp_(ms.comp_) {
   back_ = nullptr;
   if (ms.root_ != nullptr) {
-    this->root_ = new Node;
+    this->root_ = create_node_(ms.root_->key);
     CopyTree(root_, ms.root_);
     front_ = findFront(root_);
     size_ = ms.size_;
@@ -734,37 +1243,39 @@ btree<K, M, Node, MULTI>::btree(const btree& ms) {
   }
 }
 
-template <class K, class M, class Node, bool MULTI>
-btree<K, M, Node, MULTI>::btree(btree&& ms)
-    : root_(ms.root_), front_(ms.front_), size_(ms.size_) {
+template <class K, class M, class Node, bool MULTI, class Compare,
+          class Allocator>
+btree<K, M, Node, MULTI, Compare, Allocator>::btree(btree&& ms)
+    : root_(ms.root_),
+      front_(ms.front_),
+      size_(ms.size_),
+      comp_(ms.comp_),
+      alloc_(std::move(ms.alloc_)) {
   back_ = nullptr;
   ms.root_ = nullptr;
   ms.front_ = nullptr;
   ms.size_ = 0;
 }
 
-template <class K, class M, class Node, bool MULTI>
-btree<K, M, Node, MULTI>::~btree() {
+template <class K, class M, class Node, bool MULTI, class Compare,
+          class Allocator>
+btree<K, M, Node, MULTI, Compare, Allocator>::~btree() {
   this->clear();
 }
 
-template <class K, class M, class Node, bool MULTI>
-btree<K, M, Node, MULTI>& btree<K, M, Node, MULTI>::operator=(
+template <class K, class M, class Node, bool MULTI, class Compare,
+          class Allocator>
+btree<K, M, Node, MULTI, Compare, Allocator>&
+btree<K, M, Node, MULTI, Compare, Allocator>::operator=(
     std::initializer_list<value_type> const& keys) {
-  if (root_ != nullptr) {
-    this->clear();
-  }
-  size_ = 0;
-  root_ = nullptr;
-  front_ = back_ = nullptr;
-  for (auto i : keys) {
-    this->insert_iter(i);
-  }
+  assign(keys.begin(), keys.end());
   return *this;
 }
 
-template <class K, class M, class Node, bool MULTI>
-btree<K, M, Node, MULTI>& btree<K, M, Node, MULTI>::operator=(const btree& ms) {
+template <class K, class M, class Node, bool MULTI, class Compare,
+          class Allocator>
+btree<K, M, Node, MULTI, Compare, Allocator>&
+btree<K, M, Node, MULTI, Compare, Allocator>::operator=(const btree& ms) {
   if (root_ == ms.root_) {
     return *this;
   }
@@ -772,8 +1283,9 @@ btree<K, M, Node, MULTI>& btree<K, M, Node, MULTI>::operator=(const btree& ms) {
     this->clear();
   }
   back_ = nullptr;
+  comp_ = ms.comp_;
   if (ms.root_ != nullptr) {
-    this->root_ = new Node;
+    this->root_ = create_node_(ms.root_->key);
     CopyTree(root_, ms.root_);
     front_ = findFront(root_);
     size_ = ms.size_;
@@ -785,18 +1297,31 @@ btree<K, M, Node, MULTI>& btree<K, M, Node, MULTI>::operator=(const btree& ms) {
   return *this;
 }
 
-template <class K, class M, class Node, bool MULTI>
-btree<K, M, Node, MULTI>& btree<K, M, Node, MULTI>::operator=(btree&& other) {
-  if (root_ == other.root_) {
+template <class K, class M, class Node, bool MULTI, class Compare,
+          class Allocator>
+btree<K, M, Node, MULTI, Compare, Allocator>&
+btree<K, M, Node, MULTI, Compare, Allocator>::operator=(btree&& other) {
+  if (this == &other) {
     return *this;
   }
-  if (root_ != nullptr) {
-    this->clear();
+  this->clear();
+  if (!can_steal_memory(alloc_, other.alloc_)) {
+    // The nodes of other cannot be freed through alloc_, so only the
+    // elements move.
+    comp_ = other.comp_;
+    assign(std::make_move_iterator(other.begin()),
+           std::make_move_iterator(other.end()));
+    other.clear();
+    return *this;
   }
   root_ = other.root_;
   front_ = other.front_;
   size_ = other.size_;
   back_ = nullptr;
+  comp_ = other.comp_;
+  if constexpr (node_traits::propagate_on_container_move_assignment::value) {
+    alloc_ = std::move(other.alloc_);
+  }
   other.root_ = nullptr;
   other.front_ = nullptr;
   other.size_ = 0;
@@ -804,41 +1329,42 @@ btree<K, M, Node, MULTI>& btree<K, M, Node, MULTI>::operator=(btree&& other) {
 }
 
 // METHODS
-template <class K, class M, class Node, bool MULTI>
-void btree<K, M, Node, MULTI>::clear() {
+template <class K, class M, class Node, bool MULTI, class Compare,
+          class Allocator>
+void btree<K, M, Node, MULTI, Compare, Allocator>::clear() {
+  // With a pool allocator nodes are not freed one by one: they are only
+  // destroyed (if needed at all) and the chunks go back in one sweep.
+  if constexpr (has_release<node_allocator>::value) {
+    if constexpr (!std::is_trivially_destructible<Node>::value) {
+      clear_(root_);
+    }
+    alloc_.release();
+  } else {
+    clear_(root_);
+  }
   this->size_ = 0;
-  clear_(root_);
   root_ = front_ = back_ = nullptr;
 }
 
 // HELPER FUNCTIONS
-template <class K, class M, class Node, bool MULTI>
-void btree<K, M, Node, MULTI>::clear_(Node* r) {
+template <class K, class M, class Node, bool MULTI, class Compare,
+          class Allocator>
+void btree<K, M, Node, MULTI, Compare, Allocator>::clear_(Node* r) {
   if (r == nullptr) {
     return;
   }
-  if (r->left != nullptr) {
-    clear_(r->left);
-  }
-  if (r->right != nullptr) {
-    clear_(r->right);
-  }
-  if (r->parent != nullptr) {
-    Node* p = r->parent;
-    if (r == p->left) {
-      if (r == front_) {
-        front_ = p;
-      }
-      p->left = nullptr;
-    } else {
-      p->right = nullptr;
-    }
+  clear_(r->left);
+  clear_(r->right);
+  if constexpr (has_release<node_allocator>::value) {
+    node_traits::destroy(alloc_, r);
+  } else {
+    destroy_node_(r);
   }
-  delete r;
 }
 
-template <class K, class M, class Node, bool MULTI>
-Node* btree<K, M, Node, MULTI>::findFront(Node* root_) {
+template <class K, class M, class Node, bool MULTI, class Compare,
+          class Allocator>
+Node* btree<K, M, Node, MULTI, Compare, Allocator>::findFront(Node* root_) {
   if (root_ == nullptr) {
     return nullptr;
   }
@@ -849,34 +1375,37 @@ Node* btree<K, M, Node, MULTI>::findFront(Node* root_) {
   }
 }
 
-template <class K, class M, class Node, bool MULTI>
-void btree<K, M, Node, MULTI>::CopyTree(Node*& first_root, Node* second_root) {
-  first_root->key = second_root->key;
+template <class K, class M, class Node, bool MULTI, class Compare,
+          class Allocator>
+void btree<K, M, Node, MULTI, Compare, Allocator>::CopyTree(Node*& first_root,
+                                                   Node* second_root) {
   first_root->color = second_root->color;
   if (second_root->left != nullptr) {
-    Node* l = new Node;
+    Node* l = create_node_(second_root->left->key);
     l->parent = first_root;
     first_root->left = l;
     CopyTree(l, second_root->left);
   }
   if (second_root->right != nullptr) {
-    Node* r = new Node;
+    Node* r = create_node_(second_root->right->key);
     r->parent = first_root;
     first_root->right = r;
     CopyTree(r, second_root->right);
   }
+  update_size_(first_root);
 }
 
 template <class K, class M, class Node, bool MULTI>
 class iterator_btree {
+ public:
   using iterator_category = std::bidirectional_iterator_tag;
   using difference_type = std::ptrdiff_t;
   using value_type = typename Node::value_type;
   using pointer = typename Node::value_type*;    // or also value_type*
   using reference = typename Node::value_type&;  // or also value_type&
 
- public:
-  friend class btree<K, M, Node, MULTI>;
+  template <class, class, class, bool, class, class>
+  friend class btree;
 
   iterator_btree() : ptr_(nullptr){};
   iterator_btree(Node* ptr) : ptr_(ptr){};
@@ -891,15 +1420,11 @@ class iterator_btree {
       }
     } else {
       Node* temp = ptr_->parent;
-      while (ptr_ == temp->right && temp->parent != nullptr) {
+      while (temp != nullptr && ptr_ == temp->right) {
         ptr_ = temp;
         temp = temp->parent;
       }
-      if (ptr_ == temp->left) {
-        ptr_ = temp;
-      } else {
-        ptr_ = nullptr;
-      }
+      ptr_ = temp;
     }
     return *this;
   }
@@ -912,15 +1437,11 @@ class iterator_btree {
       }
     } else {
       Node* temp = ptr_->parent;
-      while (ptr_ == temp->left && temp->parent != nullptr) {
+      while (temp != nullptr && ptr_ == temp->left) {
         ptr_ = temp;
         temp = temp->parent;
       }
-      if (ptr_ == temp->right) {
-        ptr_ = temp;
-      } else {
-        ptr_ = nullptr;
-      }
+      ptr_ = temp;
     }
     return *this;
   }
@@ -955,18 +1476,19 @@ class iterator_btree {
 
 template <class K, class M, class Node, bool MULTI>
 class const_iterator_btree {
+ public:
   using iterator_category = std::bidirectional_iterator_tag;
   using difference_type = std::ptrdiff_t;
   using value_type = typename Node::value_type;
   using pointer = typename Node::value_type*;    // or also value_type*
   using reference = typename Node::value_type&;  // or also value_type&
 
- public:
-  friend class btree<K, M, Node, MULTI>;
+  template <class, class, class, bool, class, class>
+  friend class btree;
 
   const_iterator_btree() : ptr_(nullptr){};
   const_iterator_btree(Node* ptr) : ptr_(ptr){};
-  value_type operator*() const { return (ptr_->key); }
+  const value_type& operator*() const { return (ptr_->key); }
   Node* operator->() const { return ptr_; }
   // Prefix increment
   const_iterator_btree& operator++() {
@@ -978,15 +1500,11 @@ class const_iterator_btree {
       }
     } else {
       Node* temp = ptr_->parent;
-      while (ptr_ == temp->right && temp->parent != nullptr) {
+      while (temp != nullptr && ptr_ == temp->right) {
         ptr_ = temp;
         temp = temp->parent;
       }
-      if (ptr_ == temp->left) {
-        ptr_ = temp;
-      } else {
-        ptr_ = nullptr;
-      }
+      ptr_ = temp;
     }
     return *this;
   }
@@ -1021,5 +1539,22 @@ class const_iterator_btree {
  private:
   Node* ptr_;
 };
+
+// Selects the red-black btree as the engine of set, map and multiset.
+struct rb_tree_engine {
+  static constexpr bool ranked = false;
+  template <class K, class M, class Node, bool MULTI, class Compare,
+            class Allocator>
+  using type = btree<K, M, Node, MULTI, Compare, Allocator>;
+};
+// Red-black btree whose nodes keep subtree sizes: adds nth, rank,
+// count_range and O(log n) advance and distance at the cost of one word per
+// node and a walk up to the root on insert and erase.
+struct ranked_rb_tree_engine {
+  static constexpr bool ranked = true;
+  template <class K, class M, class Node, bool MULTI, class Compare,
+            class Allocator>
+  using type = btree<K, M, Node, MULTI, Compare, Allocator>;
+};
 }  // namespace s21
 #endif
\ No newline at end of file
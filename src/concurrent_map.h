@@ -0,0 +1,260 @@
+#ifndef SRC_CONCURRENT_MAP
+#define SRC_CONCURRENT_MAP
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "btree.h"
+#include "map.h"
+
+namespace s21 {
+
+// Ordered map for read-mostly sharing between threads, built on the
+// red-black btree. Writers take a mutex and make the tree's sequence counter
+// odd for the duration of the change, rotations and colour fix-ups included.
+// Readers take no lock: they walk the tree optimistically and retry if the
+// counter moved underneath them. Elements are never modified in place
+// (assignment swaps in a new node), and unlinked nodes are only freed after
+// every reader that could still see them has left.
+template <class K, class V, class Compare = std::less<K>,
+          class Allocator = slab_allocator<std::pair<K, V>>>
+class concurrent_map
+    : private btree<K, V, MapNode<K, V, false, true>, false, Compare,
+                    Allocator> {
+  using Node = MapNode<K, V, false, true>;
+  using base = btree<K, V, Node, false, Compare, Allocator>;
+
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<K, V>;
+  using size_type = size_t;
+  using key_compare = Compare;
+
+  // CONSTRUCTORS
+  concurrent_map() : seq_(0), count_(0), epoch_(0) {}
+  explicit concurrent_map(const Compare& comp)
+      : base(comp), seq_(0), count_(0), epoch_(0) {}
+  concurrent_map(std::initializer_list<value_type> const& items)
+      : concurrent_map() {
+    for (auto& i : items) {
+      insert(i.first, i.second);
+    }
+  }
+  concurrent_map(const concurrent_map&) = delete;
+  concurrent_map& operator=(const concurrent_map&) = delete;
+  ~concurrent_map() { free_retired_(); }
+
+  // READERS
+  std::optional<V> get(const key_type& key) const {
+    read_guard_ guard(*this);
+    for (;;) {
+      unsigned long s = read_begin_();
+      const Node* n = find_node_(key);
+      if (!read_valid_(s)) continue;
+      if (n == nullptr) return std::nullopt;
+      return n->key.second;
+    }
+  }
+  bool contains(const key_type& key) const {
+    read_guard_ guard(*this);
+    for (;;) {
+      unsigned long s = read_begin_();
+      const Node* n = find_node_(key);
+      if (read_valid_(s)) return n != nullptr;
+    }
+  }
+  size_type size() const { return count_.load(std::memory_order_acquire); }
+  bool empty() const { return size() == 0; }
+
+  // WRITERS
+  // The new node is built before the write section starts, so a throwing
+  // copy of K or V leaves readers undisturbed.
+  bool insert(const key_type& key, const V& obj) {
+    std::lock_guard<std::mutex> lock(write_);
+    Node* fresh = this->create_node_(key, obj);
+    bool ret;
+    {
+      write_guard_ guard(*this);
+      ret = this->insert_node_(fresh).second;
+    }
+    if (ret) count_.fetch_add(1, std::memory_order_release);
+    return ret;
+  }
+  // Returns true if the key was not there before.
+  bool insert_or_assign(const key_type& key, const V& obj) {
+    std::lock_guard<std::mutex> lock(write_);
+    Node* fresh = this->create_node_(key, obj);
+    Node* old = nullptr;
+    {
+      write_guard_ guard(*this);
+      auto found = base::find(key);
+      if (found != base::end()) {
+        old = this->extract_node_(found);
+      }
+      this->insert_node_(fresh);
+    }
+    if (old == nullptr) {
+      count_.fetch_add(1, std::memory_order_release);
+      return true;
+    }
+    retire_(old);
+    return false;
+  }
+  bool erase(const key_type& key) {
+    std::lock_guard<std::mutex> lock(write_);
+    auto found = base::find(key);
+    if (found == base::end()) return false;
+    Node* old;
+    {
+      write_guard_ guard(*this);
+      old = this->extract_node_(found);
+    }
+    count_.fetch_sub(1, std::memory_order_release);
+    retire_(old);
+    return true;
+  }
+  void clear() {
+    std::lock_guard<std::mutex> lock(write_);
+    Node* old = this->root_;
+    {
+      write_guard_ guard(*this);
+      this->store_link_(this->root_, nullptr);
+      this->front_ = nullptr;
+      this->size_ = 0;
+    }
+    count_.store(0, std::memory_order_release);
+    synchronize_();
+    destroy_tree_(old);
+  }
+
+ private:
+  // A reader counts itself in one of two sets of striped counters, picked
+  // by the parity of epoch_. A writer that wants to free nodes flips the
+  // epoch and waits for the counters of the old parity to drain.
+  static constexpr size_t stripes_ = 32;
+  static constexpr size_t retire_batch_ = 64;
+  // A walk longer than any red-black tree can be tall means the reader
+  // followed links in the middle of a rotation.
+  static constexpr int max_steps_ = 2 * 64;
+
+  struct alignas(64) stripe_ {
+    std::atomic<long> readers{0};
+  };
+  struct read_guard_ {
+    std::atomic<long>* counter;
+    explicit read_guard_(const concurrent_map& m) {
+      for (;;) {
+        unsigned e = m.epoch_.load();
+        counter = &m.active_[e & 1][stripe_index_()].readers;
+        counter->fetch_add(1);
+        if (m.epoch_.load() == e) break;
+        counter->fetch_sub(1);
+      }
+    }
+    ~read_guard_() { counter->fetch_sub(1, std::memory_order_release); }
+  };
+  // Keeps the sequence counter odd for its lifetime, so that readers retry
+  // and the counter is even again even if the write throws.
+  struct write_guard_ {
+    concurrent_map& m;
+    explicit write_guard_(concurrent_map& map) : m(map) { m.write_begin_(); }
+    ~write_guard_() { m.write_end_(); }
+  };
+
+  static size_t stripe_index_() {
+    static std::atomic<size_t> next(0);
+    thread_local size_t mine = next.fetch_add(1) % stripes_;
+    return mine;
+  }
+  unsigned long read_begin_() const {
+    for (;;) {
+      unsigned long s = seq_.load(std::memory_order_acquire);
+      if ((s & 1) == 0) return s;
+      std::this_thread::yield();
+    }
+  }
+  bool read_valid_(unsigned long s) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return seq_.load(std::memory_order_relaxed) == s;
+  }
+  void write_begin_() {
+    seq_.store(seq_.load(std::memory_order_relaxed) + 1,
+               std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+  void write_end_() {
+    seq_.store(seq_.load(std::memory_order_relaxed) + 1,
+               std::memory_order_release);
+  }
+  // Same descent as btree::find_, but every link is loaded atomically and
+  // the walk gives up after max_steps_.
+  const Node* find_node_(const key_type& key) const {
+    const Node* candidate = nullptr;
+    const Node* n = __atomic_load_n(&this->root_, __ATOMIC_ACQUIRE);
+    for (int steps = 0; n != nullptr && steps < max_steps_; steps++) {
+      if (this->comp_(key, n->key.first)) {
+        n = __atomic_load_n(&n->left, __ATOMIC_ACQUIRE);
+      } else {
+        candidate = n;
+        n = __atomic_load_n(&n->right, __ATOMIC_ACQUIRE);
+      }
+    }
+    if (n != nullptr) return nullptr;
+    if (candidate != nullptr && !this->comp_(candidate->key.first, key)) {
+      return candidate;
+    }
+    return nullptr;
+  }
+  void retire_(Node* n) {
+    retired_.push_back(n);
+    if (retired_.size() >= retire_batch_) {
+      synchronize_();
+      free_retired_();
+    }
+  }
+  // Waits until no reader can still hold a pointer to a node unlinked before
+  // the call.
+  void synchronize_() {
+    unsigned e = epoch_.fetch_add(1);
+    for (auto& i : active_[e & 1]) {
+      while (i.readers.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+      }
+    }
+  }
+  // Frees a detached subtree node by node: with a pool allocator
+  // btree::clear_ only destroys nodes and leaves the freeing to release(),
+  // which would also take the nodes still waiting in retired_.
+  void destroy_tree_(Node* n) {
+    if (n == nullptr) return;
+    destroy_tree_(n->left);
+    destroy_tree_(n->right);
+    this->destroy_node_(n);
+  }
+  void free_retired_() {
+    for (Node* n : retired_) {
+      this->destroy_node_(n);
+    }
+    retired_.clear();
+  }
+
+  std::atomic<unsigned long> seq_;
+  // Element count for size(), kept apart from the tree's own size_ so that
+  // readers need not touch the tree.
+  std::atomic<size_type> count_;
+  mutable std::atomic<unsigned> epoch_;
+  mutable stripe_ active_[2][stripes_];
+  std::mutex write_;
+  std::vector<Node*> retired_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_CONCURRENT_MAP
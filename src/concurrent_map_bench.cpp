@@ -0,0 +1,95 @@
+// Read throughput of concurrent_map against std::map behind a mutex, for a
+// growing number of reader threads and one occasional writer.
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "concurrent_map.h"
+
+namespace {
+
+using namespace s21::bench;
+
+const auto kDuration = std::chrono::milliseconds(200);
+
+// Reports aggregate reader throughput, so ns_per_op is wall time per read
+// across all readers.
+template <class Read, class Write>
+void run_readers(const char* impl, int threads, size_t n, Read read,
+                 Write write) {
+  std::atomic<bool> stop(false);
+  std::atomic<long> total(0), sink(0);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < threads; t++) {
+    readers.emplace_back([&, t] {
+      unsigned k = t + 1;
+      long done = 0, sum = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        k = k * 1103515245 + 12345;
+        sum += read(static_cast<int>((k >> 4) % n));
+        done++;
+      }
+      total += done;
+      sink += sum;
+    });
+  }
+  std::thread writer([&] {
+    unsigned k = 7;
+    while (!stop.load(std::memory_order_relaxed)) {
+      k = k * 1103515245 + 12345;
+      write(static_cast<int>((k >> 4) % n));
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  });
+  std::this_thread::sleep_for(kDuration);
+  stop = true;
+  for (auto& i : readers) {
+    i.join();
+  }
+  writer.join();
+  keep(sink.load());
+  std::string op = "read_" + std::to_string(threads) + "_threads";
+  double ns = std::chrono::duration<double, std::nano>(kDuration).count();
+  report("concurrent_map", impl, op.c_str(), "int", n,
+         ns / std::max(total.load(), 1L));
+}
+
+void run() {
+  int max_threads = static_cast<int>(std::thread::hardware_concurrency());
+  if (max_threads < 1) max_threads = 1;
+  if (max_threads > 32) max_threads = 32;
+  for (size_t n : sizes()) {
+    s21::concurrent_map<int, int> lock_free;
+    std::map<int, int> locked;
+    std::mutex mutex;
+    for (size_t i = 0; i < n; i++) {
+      lock_free.insert(i, i);
+      locked.emplace(i, i);
+    }
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+      run_readers(
+          "s21", threads, n, [&](int key) { return *lock_free.get(key); },
+          [&](int key) { lock_free.insert_or_assign(key, -key); });
+      run_readers(
+          "std", threads, n,
+          [&](int key) {
+            std::lock_guard<std::mutex> lock(mutex);
+            return locked.find(key)->second;
+          },
+          [&](int key) {
+            std::lock_guard<std::mutex> lock(mutex);
+            locked.insert_or_assign(key, -key);
+          });
+    }
+  }
+}
+
+registrar reg("concurrent_map", run);
+
+}  // namespace
@@ -0,0 +1,151 @@
+#include "concurrent_map.h"
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+// Counts live allocations. Like slab_allocator it has release(), so the
+// tree treats its nodes as pooled and does not free them one by one.
+long live_nodes = 0;
+template <class T>
+struct counting_allocator {
+  using value_type = T;
+  counting_allocator() = default;
+  template <class U>
+  counting_allocator(const counting_allocator<U>&) {}
+  T* allocate(size_t n) {
+    live_nodes += n;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* p, size_t n) {
+    live_nodes -= n;
+    std::allocator<T>().deallocate(p, n);
+  }
+  void release() {}
+  friend bool operator==(const counting_allocator&, const counting_allocator&) {
+    return true;
+  }
+  friend bool operator!=(const counting_allocator&, const counting_allocator&) {
+    return false;
+  }
+};
+
+struct throws_on_copy {
+  int value;
+  explicit throws_on_copy(int v) : value(v) {}
+  throws_on_copy(const throws_on_copy& other) : value(other.value) {
+    if (value < 0) throw std::runtime_error("copy");
+  }
+};
+
+}  // namespace
+
+class ConcurrentMapTest : public ::testing::Test {};
+
+TEST(ConcurrentMapTest, SingleThread) {
+  s21::concurrent_map<int, std::string> A = {{1, "one"}, {2, "two"}};
+  EXPECT_EQ(A.size(), 2);
+  EXPECT_EQ(*A.get(1), "one");
+  EXPECT_FALSE(A.get(3).has_value());
+  EXPECT_TRUE(A.insert(3, "three"));
+  EXPECT_FALSE(A.insert(3, "drei"));
+  EXPECT_EQ(*A.get(3), "three");
+  EXPECT_FALSE(A.insert_or_assign(3, "drei"));
+  EXPECT_EQ(*A.get(3), "drei");
+  EXPECT_TRUE(A.erase(1));
+  EXPECT_FALSE(A.erase(1));
+  EXPECT_FALSE(A.contains(1));
+  EXPECT_EQ(A.size(), 2);
+  for (int i = 0; i < 1000; i++) {
+    A.insert_or_assign(i, std::to_string(i));
+  }
+  for (int i = 0; i < 1000; i += 2) {
+    A.erase(i);
+  }
+  EXPECT_EQ(A.size(), 500);
+  EXPECT_EQ(*A.get(501), "501");
+  A.clear();
+  EXPECT_TRUE(A.empty());
+  EXPECT_FALSE(A.contains(501));
+}
+
+// Even keys stay in the map and only flip the sign of their value, odd keys
+// come and go; readers must never see anything else.
+TEST(ConcurrentMapTest, ReadersDuringWrites) {
+  s21::concurrent_map<int, std::string> A;
+  const int keys = 2000;
+  for (int i = 0; i < keys; i += 2) {
+    A.insert(i, std::to_string(i));
+  }
+  std::atomic<bool> stop(false);
+  std::atomic<long> errors(0), reads(0);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; t++) {
+    readers.emplace_back([&, t] {
+      unsigned k = t;
+      while (!stop.load()) {
+        k = k * 1103515245 + 12345;
+        int key = (k >> 8) % keys;
+        auto v = A.get(key);
+        if (key % 2 == 0) {
+          if (!v || (*v != std::to_string(key) &&
+                     *v != std::to_string(-key))) {
+            errors++;
+          }
+        } else if (v && *v != std::to_string(key)) {
+          errors++;
+        }
+        reads++;
+      }
+    });
+  }
+  for (int round = 0; round < 6; round++) {
+    for (int i = 1; i < keys; i += 2) {
+      A.insert(i, std::to_string(i));
+    }
+    for (int i = 0; i < keys; i += 2) {
+      A.insert_or_assign(i, std::to_string(round % 2 ? i : -i));
+    }
+    for (int i = 1; i < keys; i += 2) {
+      A.erase(i);
+    }
+  }
+  stop = true;
+  for (auto& i : readers) {
+    i.join();
+  }
+  EXPECT_EQ(errors.load(), 0);
+  EXPECT_GT(reads.load(), 0);
+  EXPECT_EQ(A.size(), static_cast<size_t>(keys / 2));
+}
+
+TEST(ConcurrentMapTest, ClearFreesNodes) {
+  s21::concurrent_map<int, int, std::less<int>,
+                      counting_allocator<std::pair<int, int>>>
+      A;
+  for (int i = 0; i < 1000; i++) {
+    A.insert(i, i);
+  }
+  EXPECT_EQ(live_nodes, 1000);
+  A.clear();
+  EXPECT_EQ(live_nodes, 0);
+  EXPECT_TRUE(A.empty());
+}
+
+TEST(ConcurrentMapTest, ThrowingWriteLeavesMapReadable) {
+  s21::concurrent_map<int, throws_on_copy> A;
+  A.insert(1, throws_on_copy(1));
+  EXPECT_THROW(A.insert(2, throws_on_copy(-2)), std::runtime_error);
+  EXPECT_THROW(A.insert_or_assign(1, throws_on_copy(-1)), std::runtime_error);
+  EXPECT_TRUE(A.contains(1));
+  EXPECT_FALSE(A.contains(2));
+  EXPECT_EQ(A.size(), 1U);
+  EXPECT_EQ(A.get(1)->value, 1);
+}
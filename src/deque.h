@@ -0,0 +1,412 @@
+#ifndef SRC_DEQUE
+#define SRC_DEQUE
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "allocator.h"
+
+namespace s21 {
+
+// Elements per deque block: a power of two, about 4 KiB of them but never
+// fewer than 16.
+template <class T>
+struct deque_block {
+  static constexpr size_t shift = [] {
+    size_t s = 4;
+    while (sizeof(T) << (s + 1) <= 4096) s++;
+    return s;
+  }();
+  static constexpr size_t size = size_t(1) << shift;
+  static constexpr size_t mask = size - 1;
+};
+
+template <class T, bool Const>
+class iterator_deque;
+
+// Double-ended queue made of fixed-size blocks that are indexed through a
+// map of block pointers. Element i lives at position start_ + i of the map,
+// that is in block (start_ + i) / block_size, so both ends grow in O(1)
+// and indexing is two loads. Elements never move once constructed, so
+// references stay valid across pushes and pops at either end; only the
+// block pointers are shuffled when the map is recentred or grown. Blocks
+// emptied by pops are kept for reuse until shrink_to_fit() or destruction.
+template <class T, class Allocator = std::allocator<T>>
+class deque {
+  using traits = std::allocator_traits<Allocator>;
+  using map_allocator = typename traits::template rebind_alloc<T*>;
+  using map_traits = std::allocator_traits<map_allocator>;
+  using block = deque_block<T>;
+
+ public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using allocator_type = Allocator;
+  using iterator = iterator_deque<T, false>;
+  using const_iterator = iterator_deque<T, true>;
+
+ private:
+  T** map_;
+  size_type map_size_;
+  size_type start_;
+  size_type size_;
+  Allocator alloc_;
+
+ public:
+  // CONSTRUCTORS
+  deque() : map_(nullptr), map_size_(0), start_(0), size_(0) {}
+  explicit deque(size_type n) : deque() {
+    reserve(n);
+    while (size_ < n) {
+      emplace_back();
+    }
+  }
+  deque(std::initializer_list<value_type> const& items) : deque() {
+    reserve(items.size());
+    for (auto& i : items) {
+      push_back(i);
+    }
+  }
+  template <class InputIt, class = typename std::iterator_traits<
+                               InputIt>::iterator_category>
+  deque(InputIt first, InputIt last) : deque() {
+    for (; first != last; ++first) {
+      push_back(*first);
+    }
+  }
+  deque(const deque& other) : deque() {
+    reserve(other.size_);
+    for (auto& i : other) {
+      push_back(i);
+    }
+  }
+  deque(deque&& other) noexcept
+      : map_(other.map_),
+        map_size_(other.map_size_),
+        start_(other.start_),
+        size_(other.size_),
+        alloc_(std::move(other.alloc_)) {
+    other.map_ = nullptr;
+    other.map_size_ = other.start_ = other.size_ = 0;
+  }
+  ~deque() { release_(); }
+
+  // OPERATORS
+  deque& operator=(const deque& other) {
+    if (this != &other) {
+      deque copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+  deque& operator=(deque&& other) noexcept {
+    if (this != &other) {
+      release_();
+      swap(other);
+    }
+    return *this;
+  }
+
+  // ELEMENT ACCESS
+  reference at(size_type pos) {
+    if (pos >= size_) throw std::out_of_range("index out of range");
+    return (*this)[pos];
+  }
+  const_reference at(size_type pos) const {
+    if (pos >= size_) throw std::out_of_range("index out of range");
+    return (*this)[pos];
+  }
+  reference operator[](size_type pos) { return slot_(start_ + pos); }
+  const_reference operator[](size_type pos) const {
+    return slot_(start_ + pos);
+  }
+  reference front() { return slot_(start_); }
+  const_reference front() const { return slot_(start_); }
+  reference back() { return slot_(start_ + size_ - 1); }
+  const_reference back() const { return slot_(start_ + size_ - 1); }
+
+  // ITERATORS
+  iterator begin() { return iterator(map_, start_); }
+  iterator end() { return iterator(map_, start_ + size_); }
+  const_iterator begin() const { return const_iterator(map_, start_); }
+  const_iterator end() const { return const_iterator(map_, start_ + size_); }
+
+  // CAPACITY
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+  [[nodiscard]] size_type size() const { return size_; }
+  [[nodiscard]] size_type max_size() const {
+    return std::numeric_limits<difference_type>::max() / sizeof(T);
+  }
+  // Number of elements the allocated blocks can hold.
+  size_type capacity() const {
+    size_type blocks = 0;
+    for (size_type i = 0; i < map_size_; i++) {
+      blocks += map_[i] != nullptr;
+    }
+    return blocks << block::shift;
+  }
+  // Allocates the blocks needed to hold n elements from the front, so
+  // pushing at the back up to size n does not allocate.
+  void reserve(size_type n) {
+    if (n == 0) return;
+    size_type last = 0;
+    while (map_size_ == 0 ||
+           (last = (start_ + n - 1) >> block::shift) >= map_size_) {
+      remap_(std::max<size_type>(8, 2 * map_size_), true);
+    }
+    for (size_type i = start_ >> block::shift; i <= last; i++) {
+      if (map_[i] == nullptr) map_[i] = traits::allocate(alloc_, block::size);
+    }
+  }
+  // Frees the spare blocks and fits the map to the blocks in use.
+  void shrink_to_fit() {
+    size_type first = first_block_();
+    size_type used = used_blocks_();
+    for (size_type i = 0; i < map_size_; i++) {
+      if ((i < first || i >= first + used) && map_[i] != nullptr) {
+        traits::deallocate(alloc_, map_[i], block::size);
+      }
+    }
+    T** map = nullptr;
+    if (used != 0) {
+      map = allocate_map_(used);
+      std::copy(map_ + first, map_ + first + used, map);
+    }
+    deallocate_map_();
+    map_ = map;
+    map_size_ = used;
+    start_ = used != 0 ? start_ & block::mask : 0;
+  }
+
+  // MODIFIERS
+  void clear() {
+    while (size_ != 0) {
+      pop_back();
+    }
+  }
+  void push_back(const_reference value) { emplace_back(value); }
+  void push_back(value_type&& value) { emplace_back(std::move(value)); }
+  void push_front(const_reference value) { emplace_front(value); }
+  void push_front(value_type&& value) { emplace_front(std::move(value)); }
+  template <class... Args>
+  reference emplace_back(Args&&... args) {
+    size_type pos = start_ + size_;
+    if (pos == map_size_ << block::shift) {
+      make_room_(true);
+      pos = start_ + size_;
+    }
+    T* slot = block_at_(pos) + (pos & block::mask);
+    traits::construct(alloc_, slot, std::forward<Args>(args)...);
+    size_++;
+    return *slot;
+  }
+  template <class... Args>
+  reference emplace_front(Args&&... args) {
+    if (start_ == 0) make_room_(false);
+    size_type pos = start_ - 1;
+    T* slot = block_at_(pos) + (pos & block::mask);
+    traits::construct(alloc_, slot, std::forward<Args>(args)...);
+    start_ = pos;
+    size_++;
+    return *slot;
+  }
+  void pop_back() {
+    traits::destroy(alloc_, &slot_(start_ + size_ - 1));
+    if (--size_ == 0) recentre_empty_();
+  }
+  void pop_front() {
+    traits::destroy(alloc_, &slot_(start_));
+    start_++;
+    if (--size_ == 0) recentre_empty_();
+  }
+  void swap(deque& other) noexcept {
+    std::swap(map_, other.map_);
+    std::swap(map_size_, other.map_size_);
+    std::swap(start_, other.start_);
+    std::swap(size_, other.size_);
+    swap_allocators(alloc_, other.alloc_);
+  }
+
+ private:
+  // HELPER FUNCTIONS
+  T& slot_(size_type pos) const {
+    return map_[pos >> block::shift][pos & block::mask];
+  }
+  // Block that holds map position pos, allocated on first use.
+  T* block_at_(size_type pos) {
+    T*& b = map_[pos >> block::shift];
+    if (b == nullptr) b = traits::allocate(alloc_, block::size);
+    return b;
+  }
+  T** allocate_map_(size_type n) {
+    map_allocator alloc(alloc_);
+    return map_traits::allocate(alloc, n);
+  }
+  void deallocate_map_() {
+    map_allocator alloc(alloc_);
+    if (map_ != nullptr) map_traits::deallocate(alloc, map_, map_size_);
+  }
+  size_type first_block_() const {
+    return size_ != 0 ? start_ >> block::shift : 0;
+  }
+  size_type used_blocks_() const {
+    if (size_ == 0) return 0;
+    return ((start_ + size_ - 1) >> block::shift) - first_block_() + 1;
+  }
+  void recentre_empty_() { start_ = (map_size_ / 2) << block::shift; }
+  // Called when an end reaches the edge of the map: recentres the blocks in
+  // use if the map is at most half full, grows it otherwise.
+  void make_room_(bool at_back) {
+    if (map_size_ >= 2 * used_blocks_() + 2) {
+      remap_(map_size_, at_back);
+    } else {
+      remap_(std::max<size_type>(8, 2 * map_size_), at_back);
+    }
+  }
+  // Rebuilds the map with map_size slots and the blocks in use in the
+  // middle. Spare blocks are lined up next to the end that is growing, so a
+  // deque used as a queue keeps cycling through the same blocks; only those
+  // that do not fit in the map are freed.
+  void remap_(size_type map_size, bool at_back) {
+    size_type first = first_block_();
+    size_type used = used_blocks_();
+    size_type new_first = (map_size - used) / 2;
+    T** map = allocate_map_(map_size);
+    std::fill(map, map + map_size, nullptr);
+    std::copy(map_ + first, map_ + first + used, map + new_first);
+    size_type spare = at_back ? new_first + used : new_first;
+    for (size_type i = 0; i < map_size_; i++) {
+      if (map_[i] == nullptr || (i >= first && i < first + used)) continue;
+      if (at_back && spare < map_size) {
+        map[spare++] = map_[i];
+      } else if (!at_back && spare > 0) {
+        map[--spare] = map_[i];
+      } else {
+        traits::deallocate(alloc_, map_[i], block::size);
+      }
+    }
+    deallocate_map_();
+    map_ = map;
+    map_size_ = map_size;
+    if (size_ != 0) {
+      start_ = (new_first << block::shift) + (start_ & block::mask);
+    } else {
+      recentre_empty_();
+    }
+  }
+  void release_() {
+    clear();
+    for (size_type i = 0; i < map_size_; i++) {
+      if (map_[i] != nullptr) {
+        traits::deallocate(alloc_, map_[i], block::size);
+      }
+    }
+    deallocate_map_();
+    map_ = nullptr;
+    map_size_ = start_ = 0;
+  }
+};
+
+// Random-access iterator over a deque: the block map plus a map position.
+// Pushing at either end may replace the map and invalidate it.
+template <class T, bool Const>
+class iterator_deque {
+  template <class, class>
+  friend class deque;
+  friend class iterator_deque<T, !Const>;
+  using block = deque_block<T>;
+
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = T;
+  using pointer = std::conditional_t<Const, const T*, T*>;
+  using reference = std::conditional_t<Const, const T&, T&>;
+
+  iterator_deque() : map_(nullptr), pos_(0) {}
+  iterator_deque(T* const* map, size_t pos) : map_(map), pos_(pos) {}
+  operator iterator_deque<T, true>() const {
+    return iterator_deque<T, true>(map_, pos_);
+  }
+
+  reference operator*() const {
+    return map_[pos_ >> block::shift][pos_ & block::mask];
+  }
+  pointer operator->() const { return &**this; }
+  reference operator[](difference_type n) const { return *(*this + n); }
+  iterator_deque& operator++() {
+    ++pos_;
+    return *this;
+  }
+  iterator_deque operator++(int) {
+    iterator_deque tmp = *this;
+    ++pos_;
+    return tmp;
+  }
+  iterator_deque& operator--() {
+    --pos_;
+    return *this;
+  }
+  iterator_deque operator--(int) {
+    iterator_deque tmp = *this;
+    --pos_;
+    return tmp;
+  }
+  iterator_deque& operator+=(difference_type n) {
+    pos_ += n;
+    return *this;
+  }
+  iterator_deque& operator-=(difference_type n) {
+    pos_ -= n;
+    return *this;
+  }
+  friend iterator_deque operator+(iterator_deque it, difference_type n) {
+    return it += n;
+  }
+  friend iterator_deque operator+(difference_type n, iterator_deque it) {
+    return it += n;
+  }
+  friend iterator_deque operator-(iterator_deque it, difference_type n) {
+    return it -= n;
+  }
+  friend difference_type operator-(const iterator_deque& a,
+                                   const iterator_deque& b) {
+    return static_cast<difference_type>(a.pos_ - b.pos_);
+  }
+  friend bool operator==(const iterator_deque& a, const iterator_deque& b) {
+    return a.pos_ == b.pos_;
+  }
+  friend bool operator!=(const iterator_deque& a, const iterator_deque& b) {
+    return a.pos_ != b.pos_;
+  }
+  friend bool operator<(const iterator_deque& a, const iterator_deque& b) {
+    return a.pos_ < b.pos_;
+  }
+  friend bool operator>(const iterator_deque& a, const iterator_deque& b) {
+    return a.pos_ > b.pos_;
+  }
+  friend bool operator<=(const iterator_deque& a, const iterator_deque& b) {
+    return a.pos_ <= b.pos_;
+  }
+  friend bool operator>=(const iterator_deque& a, const iterator_deque& b) {
+    return a.pos_ >= b.pos_;
+  }
+
+ private:
+  T* const* map_;
+  size_t pos_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_DEQUE
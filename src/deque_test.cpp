@@ -0,0 +1,99 @@
+#include "deque.h"
+
+#include <algorithm>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+class DequeTest : public ::testing::Test {};
+
+TEST(DequeTest, BothEnds) {
+  s21::deque<std::string> A;
+  std::deque<std::string> B;
+  for (int i = 1; i < 5000; i++) {
+    std::string s = std::to_string(i);
+    if (i % 3 == 0) {
+      A.push_front(s);
+      B.push_front(s);
+    } else {
+      A.push_back(s);
+      B.push_back(s);
+    }
+    if (i % 7 == 0) {
+      A.pop_back();
+      B.pop_back();
+    }
+    if (i % 11 == 0) {
+      A.pop_front();
+      B.pop_front();
+    }
+  }
+  ASSERT_EQ(A.size(), B.size());
+  EXPECT_TRUE(std::equal(A.begin(), A.end(), B.begin()));
+  for (size_t i = 0; i < B.size(); i += 97) {
+    EXPECT_EQ(A[i], B[i]);
+  }
+  EXPECT_EQ(A.front(), B.front());
+  EXPECT_EQ(A.back(), B.back());
+  EXPECT_THROW(A.at(A.size()), std::out_of_range);
+}
+
+TEST(DequeTest, StableAddresses) {
+  s21::deque<int> A;
+  A.push_back(1);
+  int* first = &A.front();
+  for (int i = 0; i < 100000; i++) {
+    A.push_back(i);
+    A.push_front(i);
+  }
+  EXPECT_EQ(first, &A[100000]);
+  EXPECT_EQ(*first, 1);
+}
+
+TEST(DequeTest, QueueReusesBlocks) {
+  s21::deque<int> A;
+  for (int i = 0; i < 1000; i++) {
+    A.push_back(i);
+  }
+  size_t capacity = 0;
+  for (int i = 1000; i < 200000; i++) {
+    A.push_back(i);
+    EXPECT_EQ(A.front(), i - 1000);
+    A.pop_front();
+    if (i == 100000) capacity = A.capacity();
+  }
+  EXPECT_EQ(A.capacity(), capacity);
+  A.clear();
+  A.shrink_to_fit();
+  EXPECT_EQ(A.capacity(), 0U);
+  A.push_front(5);
+  EXPECT_EQ(A.back(), 5);
+}
+
+TEST(DequeTest, CopyMoveAndIterators) {
+  s21::deque<int> A{5, 3, 9, 1};
+  s21::deque<int> B(A);
+  s21::deque<int> C(std::move(A));
+  EXPECT_TRUE(A.empty());
+  std::sort(B.begin(), B.end());
+  EXPECT_EQ(B.end() - B.begin(), 4);
+  EXPECT_EQ(*(B.begin() + 2), 5);
+  EXPECT_EQ(B.begin()[3], 9);
+  const s21::deque<int>& D = C;
+  std::vector<int> v(D.begin(), D.end());
+  EXPECT_EQ(v, (std::vector<int>{5, 3, 9, 1}));
+  A = B;
+  B = std::move(C);
+  EXPECT_EQ(A[0], 1);
+  EXPECT_EQ(B[0], 5);
+  A.swap(B);
+  EXPECT_EQ(A[0], 5);
+  s21::deque<int> E(3);
+  EXPECT_EQ(E.size(), 3U);
+  EXPECT_EQ(E[2], 0);
+  E.reserve(10000);
+  EXPECT_GE(E.capacity(), 10000U);
+}
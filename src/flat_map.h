@@ -0,0 +1,20 @@
+#ifndef SRC_FLAT_MAP
+#define SRC_FLAT_MAP
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "flat_tree.h"
+#include "map.h"
+
+namespace s21 {
+
+// map over a sorted s21::vector of pairs, see flat_tree.
+template <class K, class V, class Compare = std::less<K>>
+using flat_map =
+    map<K, V, Compare, std::allocator<std::pair<K, V>>, flat_tree_engine>;
+
+}  // namespace s21
+
+#endif  // SRC_FLAT_MAP
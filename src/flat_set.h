@@ -0,0 +1,23 @@
+#ifndef SRC_FLAT_SET
+#define SRC_FLAT_SET
+
+#include <functional>
+#include <memory>
+
+#include "flat_tree.h"
+#include "multiset.h"
+#include "set.h"
+
+namespace s21 {
+
+// set and multiset over a sorted s21::vector, see flat_tree.
+template <class K, class Compare = std::less<K>>
+using flat_set = set<K, Compare, std::allocator<K>, flat_tree_engine>;
+
+template <class K, class Compare = std::less<K>>
+using flat_multiset =
+    multiset<K, Compare, std::allocator<K>, flat_tree_engine>;
+
+}  // namespace s21
+
+#endif  // SRC_FLAT_SET
@@ -0,0 +1,346 @@
+#ifndef SRC_FLAT_TREE
+#define SRC_FLAT_TREE
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "vector.h"
+
+namespace s21 {
+
+// Sorted s21::vector with the same interface as btree, for small and
+// read-mostly tables: lookups are binary searches over contiguous storage
+// and iterators are plain pointers, so they are random access. Inserting or
+// erasing shifts the elements behind the position and invalidates
+// iterators. Node and Allocator are only there to fit the engine interface.
+template <class K, class M, class Node, bool MULTI,
+          class Compare = std::less<K>, class Allocator = void>
+class flat_tree {
+ public:
+  using key_type = K;
+  using value_type = typename Node::value_type;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using key_compare = Compare;
+  using sequence_type = vector<value_type>;
+  using iterator = value_type*;
+  using const_iterator = const value_type*;
+
+ protected:
+  sequence_type data_;
+  Compare comp_;
+
+ public:
+  // CONSTRUCTORS
+  flat_tree() : comp_() {}
+  explicit flat_tree(const Compare& comp) : comp_(comp) {}
+  flat_tree(std::initializer_list<value_type> const& values) : comp_() {
+    insert_range_(values.begin(), values.end());
+  }
+  template <class InputIt, class = typename std::iterator_traits<
+                               InputIt>::iterator_category>
+  flat_tree(InputIt first, InputIt last) : comp_() {
+    insert_range_(first, last);
+  }
+  flat_tree(const flat_tree& other) = default;
+  flat_tree(flat_tree&& other) noexcept
+      : data_(std::move(other.data_)), comp_(other.comp_) {}
+
+  // OPERATORS
+  flat_tree& operator=(std::initializer_list<value_type> const& values) {
+    assign(values.begin(), values.end());
+    return *this;
+  }
+  flat_tree& operator=(const flat_tree& other) = default;
+  flat_tree& operator=(flat_tree&& other) noexcept {
+    data_ = std::move(other.data_);
+    comp_ = other.comp_;
+    return *this;
+  }
+  bool is_equal(const value_type& a, const value_type& b) const {
+    return !comp_(key_of_(a), key_of_(b)) && !comp_(key_of_(b), key_of_(a));
+  }
+
+  // METHODS
+  // Keeps the buffer, so reserve() followed by assign() does not reallocate.
+  void clear() { data_.clear(); }
+  template <class InputIt>
+  void assign(InputIt first, InputIt last) {
+    clear();
+    insert_range_(first, last);
+  }
+  iterator begin() { return data_.data(); }
+  iterator end() { return data_.data() + data_.size(); }
+  const_iterator begin() const { return data_.data(); }
+  const_iterator end() const { return data_.data() + data_.size(); }
+
+  void erase(iterator pos) { data_.erase(iterator_vector<value_type>(pos)); }
+  void merge(flat_tree& other) {
+    if (this == &other) return;
+    insert_range_(other.begin(), other.end());
+    other.clear();
+  }
+  // Same contract as btree::set_union and friends, computed by the std::
+  // algorithms into a fresh vector.
+  void set_union(flat_tree&& other) {
+    combine_with_(other, [](auto... args) { std::set_union(args...); });
+  }
+  void set_union(const flat_tree& other) {
+    combine_with_(other, [](auto... args) { std::set_union(args...); });
+  }
+  void set_intersection(flat_tree&& other) {
+    combine_with_(other,
+                  [](auto... args) { std::set_intersection(args...); });
+  }
+  void set_intersection(const flat_tree& other) {
+    combine_with_(other,
+                  [](auto... args) { std::set_intersection(args...); });
+  }
+  void set_difference(flat_tree&& other) {
+    combine_with_(other, [](auto... args) { std::set_difference(args...); });
+  }
+  void set_difference(const flat_tree& other) {
+    combine_with_(other, [](auto... args) { std::set_difference(args...); });
+  }
+  size_type size() const { return data_.size(); }
+  size_type capacity() const { return data_.capacity(); }
+  void reserve(size_type n) { data_.reserve(n); }
+  void shrink_to_fit() { data_.shrink_to_fit(); }
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(value_type);
+  }
+  bool empty() const { return data_.empty(); }
+  void swap(flat_tree& other) noexcept {
+    data_.swap(other.data_);
+    std::swap(comp_, other.comp_);
+  }
+  key_compare key_comp() const { return comp_; }
+
+  // Hands the underlying sorted vector over without copying it; the
+  // container is left empty.
+  sequence_type extract_sequence() {
+    sequence_type ret(std::move(data_));
+    data_ = sequence_type();
+    return ret;
+  }
+  // Takes ownership of seq. Sorted input is kept as is, anything else is
+  // sorted (and, for unique containers, deduplicated) in place.
+  void adopt_sequence(sequence_type&& seq) {
+    data_ = std::move(seq);
+    if (!std::is_sorted(begin(), end(), less_())) {
+      std::stable_sort(begin(), end(), less_());
+    }
+    if (!MULTI) unique_();
+  }
+
+  size_type count(const key_type& key) const { return count_(key); }
+  iterator find(const key_type& key) { return find_(key); }
+  const_iterator find(const key_type& key) const { return find_(key); }
+  iterator lower_bound(const key_type& key) { return lower_(key); }
+  const_iterator lower_bound(const key_type& key) const {
+    return lower_(key);
+  }
+  // Last element equivalent to key, end() if there is none.
+  iterator upper_bound(const key_type& key) { return last_equal_(key); }
+  const_iterator upper_bound(const key_type& key) const {
+    return last_equal_(key);
+  }
+
+  template <class Key, class C = Compare, class = typename C::is_transparent>
+  size_type count(const Key& key) const {
+    return count_(key);
+  }
+  template <class Key, class C = Compare, class = typename C::is_transparent>
+  iterator find(const Key& key) {
+    return find_(key);
+  }
+  template <class Key, class C = Compare, class = typename C::is_transparent>
+  const_iterator find(const Key& key) const {
+    return find_(key);
+  }
+  template <class Key, class C = Compare, class = typename C::is_transparent>
+  iterator lower_bound(const Key& key) {
+    return lower_(key);
+  }
+  template <class Key, class C = Compare, class = typename C::is_transparent>
+  const_iterator lower_bound(const Key& key) const {
+    return lower_(key);
+  }
+
+  // Same contract as btree::for_each and for_each_range.
+  template <class Fn>
+  void for_each(Fn fn) {
+    std::for_each(begin(), end(), fn);
+  }
+  template <class Fn>
+  void for_each(Fn fn) const {
+    std::for_each(begin(), end(), [&fn](const value_type& v) { fn(v); });
+  }
+  template <class Fn>
+  void for_each_range(const key_type& lo, const key_type& hi, Fn fn) {
+    iterator first = lower_(lo), last = lower_(hi);
+    if (first < last) std::for_each(first, last, fn);
+  }
+  template <class Fn>
+  void for_each_range(const key_type& lo, const key_type& hi, Fn fn) const {
+    const_iterator first = lower_(lo), last = lower_(hi);
+    if (first < last) {
+      std::for_each(first, last, [&fn](const value_type& v) { fn(v); });
+    }
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insert_iter(value_type(std::forward<Args>(args)...));
+  }
+
+ protected:
+  // HELPER FUNCTIONS
+  static const K& key_of_(const value_type& v) {
+    if constexpr (std::is_same<value_type, K>::value) {
+      return v;
+    } else {
+      return v.first;
+    }
+  }
+  auto less_() const {
+    return [this](const value_type& a, const value_type& b) {
+      return comp_(key_of_(a), key_of_(b));
+    };
+  }
+  // First position whose key is not less than key.
+  template <class Key>
+  iterator lower_(const Key& key) const {
+    value_type* first = const_cast<value_type*>(data_.data());
+    return std::partition_point(first, first + data_.size(),
+                                [&](const value_type& v) {
+                                  return comp_(key_of_(v), key);
+                                });
+  }
+  // First position whose key is greater than key.
+  template <class Key>
+  iterator upper_(const Key& key) const {
+    value_type* first = const_cast<value_type*>(data_.data());
+    return std::partition_point(first, first + data_.size(),
+                                [&](const value_type& v) {
+                                  return !comp_(key, key_of_(v));
+                                });
+  }
+  template <class Key>
+  iterator find_(const Key& key) const {
+    iterator ret = lower_(key);
+    iterator last = const_cast<value_type*>(data_.data()) + data_.size();
+    if (ret != last && comp_(key, key_of_(*ret))) return last;
+    return ret;
+  }
+  template <class Key>
+  iterator last_equal_(const Key& key) const {
+    iterator ret = upper_(key);
+    iterator first = const_cast<value_type*>(data_.data());
+    if (ret == first || comp_(key_of_(*(ret - 1)), key)) {
+      return first + data_.size();
+    }
+    return ret - 1;
+  }
+  template <class Key>
+  size_type count_(const Key& key) const {
+    return upper_(key) - lower_(key);
+  }
+  // Drops every element equivalent to its predecessor.
+  void unique_() {
+    iterator last = std::unique(begin(), end(),
+                                [this](const value_type& a,
+                                       const value_type& b) {
+                                  return !comp_(key_of_(a), key_of_(b));
+                                });
+    while (end() != last) {
+      data_.pop_back();
+    }
+  }
+  template <class Other, class Op>
+  void combine_with_(Other&& other, Op op) {
+    sequence_type result;
+    result.reserve(std::max(size(), other.size()));
+    op(begin(), end(), other.begin(), other.end(), append_iterator_{&result},
+       less_());
+    data_ = std::move(result);
+    if constexpr (!std::is_const<std::remove_reference_t<Other>>::value) {
+      if (this != &other) other.clear();
+    }
+  }
+  // Appends to a sequence, for the std:: set algorithms.
+  struct append_iterator_ {
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+
+    sequence_type* result;
+    append_iterator_& operator*() { return *this; }
+    append_iterator_& operator++() { return *this; }
+    append_iterator_ operator++(int) { return *this; }
+    template <class V>
+    append_iterator_& operator=(const V& value) {
+      result->push_back(value);
+      return *this;
+    }
+  };
+  // Appends [first, last), sorts only the new tail and merges it into the
+  // old contents in one pass instead of shifting once per element. For
+  // unique containers the element already stored, or the first one
+  // inserted, wins.
+  template <class InputIt>
+  void insert_range_(InputIt first, InputIt last) {
+    size_type old_size = data_.size();
+    for (; first != last; ++first) {
+      data_.push_back(*first);
+    }
+    value_type* mid = data_.data() + old_size;
+    value_type* end = data_.data() + data_.size();
+    if (!std::is_sorted(mid, end, less_())) {
+      std::stable_sort(mid, end, less_());
+    }
+    if (old_size > 0 && mid != end && less_()(*mid, *(mid - 1))) {
+      std::inplace_merge(data_.data(), mid, end, less_());
+    }
+    if (!MULTI) unique_();
+  }
+
+  std::pair<iterator, bool> insert_iter(const value_type& value) {
+    return insert_value_(value);
+  }
+  std::pair<iterator, bool> insert_iter(value_type&& value) {
+    return insert_value_(std::move(value));
+  }
+  template <class V>
+  std::pair<iterator, bool> insert_value_(V&& value) {
+    iterator pos = MULTI ? upper_(key_of_(value)) : lower_(key_of_(value));
+    if (!MULTI && pos != end() && !comp_(key_of_(value), key_of_(*pos))) {
+      return std::make_pair(pos, false);
+    }
+    size_type idx = pos - begin();
+    data_.insert(iterator_vector<value_type>(pos), std::forward<V>(value));
+    return std::make_pair(begin() + idx, true);
+  }
+};
+
+// Selects flat_tree as the engine of set, map and multiset.
+struct flat_tree_engine {
+  static constexpr bool ranked = false;
+  template <class K, class M, class Node, bool MULTI, class Compare,
+            class Allocator>
+  using type = flat_tree<K, M, Node, MULTI, Compare, Allocator>;
+};
+
+}  // namespace s21
+
+#endif  // SRC_FLAT_TREE
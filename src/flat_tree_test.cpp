@@ -0,0 +1,153 @@
+#include "flat_tree.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "flat_map.h"
+#include "flat_set.h"
+#include "gtest/gtest.h"
+
+class FlatTreeTest : public ::testing::Test {};
+
+TEST(FlatTreeTest, RandomAgainstStd) {
+  s21::flat_set<int> A;
+  std::set<int> B;
+  srand(21);
+  for (int i = 0; i < 5000; i++) {
+    int v = rand() % 1000;
+    auto a = A.insert(v);
+    auto b = B.insert(v);
+    EXPECT_EQ(a.second, b.second);
+    EXPECT_EQ(*a.first, *b.first);
+  }
+  for (int i = 0; i < 2000; i++) {
+    int v = rand() % 1000;
+    auto a = A.find(v);
+    auto b = B.find(v);
+    EXPECT_EQ(a == A.end(), b == B.end());
+    if (b != B.end()) {
+      A.erase(a);
+      B.erase(b);
+    }
+  }
+  EXPECT_EQ(A.size(), B.size());
+  EXPECT_TRUE(std::equal(A.begin(), A.end(), B.begin(), B.end()));
+}
+
+TEST(FlatTreeTest, RandomAccessIterators) {
+  s21::flat_set<int> A = {50, 10, 40, 20, 30};
+  auto i = A.begin();
+  EXPECT_EQ(A.end() - A.begin(), 5);
+  EXPECT_EQ(i[3], 40);
+  EXPECT_EQ(*(i + 2), 30);
+  EXPECT_TRUE(std::binary_search(A.begin(), A.end(), 20));
+  EXPECT_EQ(*A.lower_bound(25), 30);
+  EXPECT_EQ(A.upper_bound(25), A.end());
+  EXPECT_TRUE(A.contains(10));
+  EXPECT_FALSE(A.contains(15));
+}
+
+TEST(FlatTreeTest, BulkInsert) {
+  s21::flat_set<int> A = {1, 5, 9};
+  std::vector<int> more = {8, 2, 5, 7, 2, 100, 0};
+  A.insert(more.begin(), more.end());
+  std::set<int> B = {1, 5, 9};
+  B.insert(more.begin(), more.end());
+  EXPECT_TRUE(std::equal(A.begin(), A.end(), B.begin(), B.end()));
+
+  s21::flat_multiset<int> C = {1, 5, 9};
+  C.insert(more.begin(), more.end());
+  std::multiset<int> D = {1, 5, 9};
+  D.insert(more.begin(), more.end());
+  EXPECT_TRUE(std::equal(C.begin(), C.end(), D.begin(), D.end()));
+  EXPECT_EQ(C.count(2), 2);
+  EXPECT_EQ(C.count(5), 2);
+}
+
+// Equal keys keep their insertion order, the element already stored wins.
+TEST(FlatTreeTest, BulkInsertMap) {
+  s21::flat_map<int, std::string> A = {{3, "three"}, {1, "one"}};
+  std::vector<std::pair<int, std::string>> more = {
+      {2, "two"}, {3, "drei"}, {2, "zwei"}, {0, "zero"}};
+  A.insert(more.begin(), more.end());
+  std::map<int, std::string> B = {{3, "three"}, {1, "one"}};
+  B.insert(more.begin(), more.end());
+  std::vector<std::pair<int, std::string>> expected(B.begin(), B.end());
+  EXPECT_TRUE(std::equal(A.begin(), A.end(), expected.begin(), expected.end()));
+  EXPECT_EQ(A.at(2), "two");
+  A[7] = "seven";
+  EXPECT_EQ((*A.find(7)).second, "seven");
+  A.insert_or_assign(7, "sieben");
+  EXPECT_EQ(A.at(7), "sieben");
+}
+
+TEST(FlatTreeTest, SequenceHandoff) {
+  s21::flat_set<std::string> A;
+  A.reserve(100);
+  EXPECT_GE(A.capacity(), 100);
+  for (int i = 0; i < 100; i++) {
+    A.insert(std::to_string(i));
+  }
+  const std::string* storage = &*A.begin();
+  auto seq = A.extract_sequence();
+  EXPECT_TRUE(A.empty());
+  EXPECT_EQ(seq.size(), 100);
+  EXPECT_EQ(seq.data(), storage);
+
+  s21::flat_set<std::string> B;
+  B.adopt_sequence(std::move(seq));
+  EXPECT_EQ(&*B.begin(), storage);
+  EXPECT_EQ(B.size(), 100);
+  EXPECT_TRUE(std::is_sorted(B.begin(), B.end()));
+
+  s21::vector<std::string> unsorted = {"b", "a", "c", "a"};
+  B.adopt_sequence(std::move(unsorted));
+  EXPECT_EQ(B.size(), 3);
+  EXPECT_EQ(*B.begin(), "a");
+  s21::flat_multiset<std::string> C;
+  C.adopt_sequence(s21::vector<std::string>{"b", "a", "c", "a"});
+  EXPECT_EQ(C.size(), 4);
+  EXPECT_EQ(C.count("a"), 2);
+
+  // clear() and assign() keep a reserved buffer.
+  s21::flat_set<int> D;
+  D.reserve(64);
+  std::vector<int> values = {5, 3, 9, 1};
+  D.assign(values.begin(), values.end());
+  const int* buffer = &*D.begin();
+  EXPECT_GE(D.capacity(), 64);
+  D.clear();
+  EXPECT_GE(D.capacity(), 64);
+  D.assign(values.begin(), values.end());
+  EXPECT_EQ(&*D.begin(), buffer);
+  EXPECT_EQ(*D.begin(), 1);
+}
+
+TEST(FlatTreeTest, SetAlgebra) {
+  s21::flat_set<int> A = {1, 2, 3, 4, 5}, B = {4, 5, 6, 7};
+  auto U = s21::set_union(A, B);
+  auto I = s21::set_intersection(A, B);
+  auto D = s21::set_difference(A, B);
+  EXPECT_EQ(std::vector<int>(U.begin(), U.end()),
+            std::vector<int>({1, 2, 3, 4, 5, 6, 7}));
+  EXPECT_EQ(std::vector<int>(I.begin(), I.end()), std::vector<int>({4, 5}));
+  EXPECT_EQ(std::vector<int>(D.begin(), D.end()),
+            std::vector<int>({1, 2, 3}));
+  A.merge(B);
+  EXPECT_EQ(A.size(), 7);
+  EXPECT_TRUE(B.empty());
+}
+
+TEST(FlatTreeTest, ForEachRange) {
+  s21::flat_multiset<int> A = {5, 1, 3, 3, 9, 7};
+  std::vector<int> seen;
+  A.for_each_range(3, 8, [&seen](int v) { seen.push_back(v); });
+  EXPECT_EQ(seen, std::vector<int>({3, 3, 5, 7}));
+  seen.clear();
+  A.for_each_range(8, 3, [&seen](int v) { seen.push_back(v); });
+  EXPECT_TRUE(seen.empty());
+}
@@ -0,0 +1,590 @@
+#ifndef SRC_HASH_TABLE
+#define SRC_HASH_TABLE
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "allocator.h"
+
+namespace s21 {
+
+// Control bytes of hash_table, one per slot. A full slot stores the low
+// seven bits of its element's hash (H2), so the top bit is clear; empty and
+// deleted slots have it set. The byte after the last slot is the sentinel
+// that stops iteration.
+struct hash_ctrl {
+  static constexpr int8_t empty = -128;
+  static constexpr int8_t deleted = -2;
+  static constexpr int8_t sentinel = -1;
+};
+
+// Sixteen control bytes matched at once. Every operation returns a bit mask
+// with bit i set for the matching byte i.
+class hash_group {
+ public:
+  static constexpr size_t width = 16;
+
+#ifdef __SSE2__
+  explicit hash_group(const int8_t* ctrl)
+      : ctrl_(_mm_load_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+  uint32_t match(int8_t h2) const {
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_));
+  }
+  uint32_t match_empty() const { return match(hash_ctrl::empty); }
+  // Empty or deleted.
+  uint32_t match_free() const { return _mm_movemask_epi8(ctrl_); }
+
+ private:
+  __m128i ctrl_;
+#else
+  explicit hash_group(const int8_t* ctrl) { std::memcpy(ctrl_, ctrl, width); }
+  uint32_t match(int8_t h2) const {
+    uint32_t ret = 0;
+    for (size_t i = 0; i < width; i++) {
+      ret |= static_cast<uint32_t>(ctrl_[i] == h2) << i;
+    }
+    return ret;
+  }
+  uint32_t match_empty() const { return match(hash_ctrl::empty); }
+  uint32_t match_free() const {
+    uint32_t ret = 0;
+    for (size_t i = 0; i < width; i++) {
+      ret |= static_cast<uint32_t>(ctrl_[i] < 0) << i;
+    }
+    return ret;
+  }
+
+ private:
+  int8_t ctrl_[width];
+#endif
+};
+
+template <class T>
+class iterator_hash;
+
+template <class T>
+class const_iterator_hash;
+
+// Open-addressing hash table in the style of SwissTable. Slots are split
+// into aligned groups of hash_group::width; a key's H1 (the remaining hash
+// bits) picks the first group and the probe moves on by triangular steps.
+// Each group is filtered by comparing the H2 of the key against all of its
+// control bytes at once, so a lookup usually touches one control line and
+// one slot. A probe stops at the first group that has an empty slot, which
+// also makes deletion tombstone-free whenever the slot's group still has an
+// empty slot. Inserting may rehash and invalidate iterators.
+template <class K, class Value, bool MULTI, class Hash = std::hash<K>,
+          class KeyEqual = std::equal_to<K>,
+          class Allocator = std::allocator<Value>>
+class hash_table {
+ public:
+  using key_type = K;
+  using value_type = Value;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+  using iterator = iterator_hash<value_type>;
+  using const_iterator = const_iterator_hash<value_type>;
+
+ protected:
+  static constexpr size_type width = hash_group::width;
+  struct alignas(hash_group::width) ctrl_block_ {
+    int8_t bytes[hash_group::width];
+  };
+  using traits = std::allocator_traits<Allocator>;
+  using ctrl_allocator = typename traits::template rebind_alloc<ctrl_block_>;
+  using ctrl_traits = std::allocator_traits<ctrl_allocator>;
+
+  int8_t* ctrl_;
+  value_type* slots_;
+  size_type capacity_;
+  size_type size_;
+  size_type deleted_;
+  size_type growth_left_;
+  float max_load_factor_;
+  Hash hash_;
+  KeyEqual eq_;
+  Allocator alloc_;
+
+ public:
+  // CONSTRUCTORS
+  hash_table()
+      : ctrl_(nullptr),
+        slots_(nullptr),
+        capacity_(0),
+        size_(0),
+        deleted_(0),
+        growth_left_(0),
+        max_load_factor_(0.875f) {}
+  explicit hash_table(size_type bucket_count, const Hash& hash = Hash(),
+                      const KeyEqual& eq = KeyEqual())
+      : hash_table() {
+    hash_ = hash;
+    eq_ = eq;
+    reserve(bucket_count);
+  }
+  hash_table(std::initializer_list<value_type> const& values) : hash_table() {
+    insert_range_(values.begin(), values.end());
+  }
+  template <class InputIt, class = typename std::iterator_traits<
+                               InputIt>::iterator_category>
+  hash_table(InputIt first, InputIt last) : hash_table() {
+    insert_range_(first, last);
+  }
+  hash_table(const hash_table& other) : hash_table() {
+    max_load_factor_ = other.max_load_factor_;
+    hash_ = other.hash_;
+    eq_ = other.eq_;
+    copy_from_(other);
+  }
+  hash_table(hash_table&& other) noexcept : hash_table() { swap(other); }
+  ~hash_table() { release_(); }
+
+  // OPERATORS
+  hash_table& operator=(std::initializer_list<value_type> const& values) {
+    clear();
+    insert_range_(values.begin(), values.end());
+    return *this;
+  }
+  hash_table& operator=(const hash_table& other) {
+    if (this != &other) {
+      hash_table copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+  hash_table& operator=(hash_table&& other) noexcept {
+    if (this != &other) {
+      release_();
+      swap(other);
+    }
+    return *this;
+  }
+
+  // METHODS
+  iterator begin() { return iterator(first_full_()); }
+  iterator end() { return iterator(ctrl_ + capacity_, slots_ + capacity_); }
+  const_iterator begin() const { return const_iterator(first_full_()); }
+  const_iterator end() const {
+    return const_iterator(ctrl_ + capacity_, slots_ + capacity_);
+  }
+
+  bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+  size_type max_size() const {
+    return std::numeric_limits<difference_type>::max() /
+           (sizeof(value_type) + 1);
+  }
+  // Destroys the elements but keeps the slots.
+  void clear() {
+    if (capacity_ == 0) return;
+    destroy_elements_();
+    reset_ctrl_();
+  }
+  void erase(iterator pos) { erase_slot_(pos.slot_ - slots_); }
+  size_type erase(const key_type& key) {
+    size_type ret = 0;
+    for (size_type i; (i = find_slot_(key)) != capacity_;) {
+      erase_slot_(i);
+      ret++;
+      if (!MULTI) break;
+    }
+    return ret;
+  }
+  void swap(hash_table& other) noexcept {
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(deleted_, other.deleted_);
+    std::swap(growth_left_, other.growth_left_);
+    std::swap(max_load_factor_, other.max_load_factor_);
+    std::swap(hash_, other.hash_);
+    std::swap(eq_, other.eq_);
+    swap_allocators(alloc_, other.alloc_);
+  }
+  // Moves every element of other that fits into *this.
+  void merge(hash_table& other) {
+    if (this == &other) return;
+    for (size_type i = 0; i < other.capacity_; i++) {
+      if (other.ctrl_[i] < 0) continue;
+      const key_type& key = key_of_(other.slots_[i]);
+      if (!MULTI && find_slot_(key) != capacity_) continue;
+      emplace_new_(hash_of_(key), std::move(other.slots_[i]));
+      other.erase_slot_(i);
+    }
+  }
+
+  // LOOKUP
+  iterator find(const key_type& key) { return at_slot_(find_slot_(key)); }
+  const_iterator find(const key_type& key) const {
+    size_type i = find_slot_(key);
+    return const_iterator(ctrl_ + i, slots_ + i);
+  }
+  bool contains(const key_type& key) const {
+    return find_slot_(key) != capacity_;
+  }
+  size_type count(const key_type& key) const {
+    if (!MULTI) return contains(key) ? 1 : 0;
+    size_type ret = 0;
+    probe_(key, [&ret](size_type) {
+      ret++;
+      return false;
+    });
+    return ret;
+  }
+
+  // HASH POLICY
+  // Number of slots.
+  size_type bucket_count() const { return capacity_; }
+  float load_factor() const {
+    return capacity_ == 0 ? 0.0f : static_cast<float>(size_) / capacity_;
+  }
+  float max_load_factor() const { return max_load_factor_; }
+  // Clamped to [1/8, 15/16]: a probe needs at least one empty slot to stop.
+  void max_load_factor(float ml) {
+    max_load_factor_ = std::min(std::max(ml, 0.125f), 0.9375f);
+    if (capacity_ == 0) return;
+    if (growth_limit_(capacity_) < size_ + deleted_) {
+      rehash_(capacity_for_(size_));
+    } else {
+      growth_left_ = growth_limit_(capacity_) - size_ - deleted_;
+    }
+  }
+  // Makes room for n elements without rehashing.
+  void reserve(size_type n) {
+    if (n > size_ + growth_left_) {
+      rehash_(std::max(capacity_for_(n), capacity_));
+    }
+  }
+  // At least n slots; also drops all tombstones.
+  void rehash(size_type n) {
+    size_type cap = width;
+    while (cap < n) cap *= 2;
+    rehash_(std::max(cap, capacity_for_(size_)));
+  }
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return eq_; }
+  allocator_type get_allocator() const { return alloc_; }
+
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insert_iter(value_type(std::forward<Args>(args)...));
+  }
+
+ protected:
+  // HELPER FUNCTIONS
+  static const K& key_of_(const value_type& v) {
+    if constexpr (std::is_same<value_type, K>::value) {
+      return v;
+    } else {
+      return v.first;
+    }
+  }
+  // std::hash is the identity for integers, so the bits are mixed before
+  // they are split into H1 and H2.
+  size_type hash_of_(const key_type& key) const {
+    uint64_t h = static_cast<uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_type>(h ^ (h >> 32));
+  }
+  static int8_t h2_(size_type h) { return static_cast<int8_t>(h & 0x7F); }
+  static size_type h1_(size_type h) { return h >> 7; }
+
+  iterator at_slot_(size_type i) { return iterator(ctrl_ + i, slots_ + i); }
+  iterator first_full_() const {
+    size_type i = 0;
+    while (i < capacity_ && ctrl_[i] < 0) i++;
+    return iterator(ctrl_ + i, slots_ + i);
+  }
+
+  // Calls fn(slot) for every slot whose key equals key, in probe order,
+  // until fn returns true. Returns that slot, or capacity_.
+  template <class Fn>
+  size_type probe_(const key_type& key, Fn fn) const {
+    if (size_ == 0) return capacity_;
+    size_type h = hash_of_(key);
+    size_type mask = capacity_ / width - 1;
+    size_type g = h1_(h) & mask;
+    for (size_type step = 1;; step++) {
+      hash_group group(ctrl_ + g * width);
+      for (uint32_t m = group.match(h2_(h)); m != 0; m &= m - 1) {
+        size_type i = g * width + __builtin_ctz(m);
+        if (eq_(key_of_(slots_[i]), key) && fn(i)) return i;
+      }
+      if (group.match_empty() != 0) return capacity_;
+      g = (g + step) & mask;
+    }
+  }
+  size_type find_slot_(const key_type& key) const {
+    return probe_(key, [](size_type) { return true; });
+  }
+  // First empty or deleted slot on the probe sequence of h.
+  size_type find_free_(size_type h) const {
+    size_type mask = capacity_ / width - 1;
+    size_type g = h1_(h) & mask;
+    for (size_type step = 1;; step++) {
+      uint32_t m = hash_group(ctrl_ + g * width).match_free();
+      if (m != 0) return g * width + __builtin_ctz(m);
+      g = (g + step) & mask;
+    }
+  }
+
+  std::pair<iterator, bool> insert_iter(const value_type& value) {
+    return insert_value_(value);
+  }
+  std::pair<iterator, bool> insert_iter(value_type&& value) {
+    return insert_value_(std::move(value));
+  }
+  template <class V>
+  std::pair<iterator, bool> insert_value_(V&& value) {
+    if (!MULTI) {
+      size_type i = find_slot_(key_of_(value));
+      if (i != capacity_) return std::make_pair(at_slot_(i), false);
+    }
+    size_type h = hash_of_(key_of_(value));
+    return std::make_pair(at_slot_(emplace_new_(h, std::forward<V>(value))),
+                          true);
+  }
+  template <class InputIt>
+  void insert_range_(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert_iter(*first);
+    }
+  }
+  // Constructs a new element from v on the probe sequence of h, growing
+  // the table first if needed. Growing moves every element, so a v that is
+  // one of them (a multi container inserting its own element) is copied
+  // out first.
+  template <class V>
+  size_type emplace_new_(size_type h, V&& v) {
+    size_type i = capacity_ == 0 ? 0 : find_free_(h);
+    if (capacity_ == 0 ||
+        (growth_left_ == 0 && ctrl_[i] == hash_ctrl::empty)) {
+      if (slots_ <= &v && &v < slots_ + capacity_) {
+        value_type copy(std::forward<V>(v));
+        return emplace_new_(h, std::move(copy));
+      }
+      grow_();
+      i = find_free_(h);
+    }
+    traits::construct(alloc_, slots_ + i, std::forward<V>(v));
+    if (ctrl_[i] == hash_ctrl::deleted) {
+      deleted_--;
+    } else {
+      growth_left_--;
+    }
+    ctrl_[i] = h2_(h);
+    size_++;
+    return i;
+  }
+  void erase_slot_(size_type i) {
+    traits::destroy(alloc_, slots_ + i);
+    size_--;
+    // No probe has ever gone past a group that still has an empty slot, so
+    // the slot can be emptied instead of left as a tombstone.
+    if (hash_group(ctrl_ + i / width * width).match_empty() != 0) {
+      ctrl_[i] = hash_ctrl::empty;
+      growth_left_++;
+    } else {
+      ctrl_[i] = hash_ctrl::deleted;
+      deleted_++;
+    }
+  }
+
+  size_type growth_limit_(size_type cap) const {
+    size_type ret = static_cast<size_type>(cap * max_load_factor_);
+    return std::max<size_type>(std::min(ret, cap - 1), 1);
+  }
+  size_type capacity_for_(size_type n) const {
+    size_type cap = width;
+    while (growth_limit_(cap) < n) cap *= 2;
+    return cap;
+  }
+  // Tombstones that take up a quarter of the slots are cleaned up at the
+  // same capacity, otherwise the table doubles.
+  void grow_() {
+    if (capacity_ == 0) {
+      rehash_(width);
+    } else if (deleted_ >= capacity_ / 4) {
+      rehash_(capacity_);
+    } else {
+      rehash_(capacity_ * 2);
+    }
+  }
+  void rehash_(size_type cap) {
+    ctrl_allocator ctrl_alloc(alloc_);
+    int8_t* old_ctrl = ctrl_;
+    value_type* old_slots = slots_;
+    size_type old_capacity = capacity_;
+    ctrl_ = reinterpret_cast<int8_t*>(
+        ctrl_traits::allocate(ctrl_alloc, cap / width + 1));
+    slots_ = traits::allocate(alloc_, cap);
+    capacity_ = cap;
+    reset_ctrl_();
+    for (size_type i = 0; i < old_capacity; i++) {
+      if (old_ctrl[i] < 0) continue;
+      size_type h = hash_of_(key_of_(old_slots[i]));
+      size_type j = find_free_(h);
+      traits::construct(alloc_, slots_ + j, std::move(old_slots[i]));
+      traits::destroy(alloc_, old_slots + i);
+      ctrl_[j] = h2_(h);
+      size_++;
+    }
+    growth_left_ -= size_;
+    if (old_capacity != 0) {
+      ctrl_traits::deallocate(ctrl_alloc,
+                              reinterpret_cast<ctrl_block_*>(old_ctrl),
+                              old_capacity / width + 1);
+      traits::deallocate(alloc_, old_slots, old_capacity);
+    }
+  }
+  void reset_ctrl_() {
+    std::memset(ctrl_, hash_ctrl::empty, capacity_);
+    std::memset(ctrl_ + capacity_, hash_ctrl::sentinel, width);
+    size_ = deleted_ = 0;
+    growth_left_ = growth_limit_(capacity_);
+  }
+  void destroy_elements_() {
+    if constexpr (!std::is_trivially_destructible<value_type>::value) {
+      for (size_type i = 0; i < capacity_; i++) {
+        if (ctrl_[i] >= 0) traits::destroy(alloc_, slots_ + i);
+      }
+    }
+  }
+  void release_() {
+    if (capacity_ == 0) return;
+    destroy_elements_();
+    ctrl_allocator ctrl_alloc(alloc_);
+    ctrl_traits::deallocate(ctrl_alloc, reinterpret_cast<ctrl_block_*>(ctrl_),
+                            capacity_ / width + 1);
+    traits::deallocate(alloc_, slots_, capacity_);
+    ctrl_ = nullptr;
+    slots_ = nullptr;
+    capacity_ = size_ = deleted_ = growth_left_ = 0;
+  }
+  // Same capacity and the same slot for every element, so no rehashing.
+  void copy_from_(const hash_table& other) {
+    if (other.capacity_ == 0) return;
+    rehash_(other.capacity_);
+    std::memcpy(ctrl_, other.ctrl_, capacity_ + width);
+    for (size_type i = 0; i < capacity_; i++) {
+      if (ctrl_[i] >= 0) {
+        traits::construct(alloc_, slots_ + i, other.slots_[i]);
+      }
+    }
+    size_ = other.size_;
+    deleted_ = other.deleted_;
+    growth_left_ = other.growth_left_;
+  }
+};
+
+template <class T>
+class iterator_hash {
+  template <class, class, bool, class, class, class>
+  friend class hash_table;
+  friend class const_iterator_hash<T>;
+
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = T;
+  using pointer = T*;
+  using reference = T&;
+
+  iterator_hash() : ctrl_(nullptr), slot_(nullptr) {}
+  iterator_hash(const int8_t* ctrl, T* slot) : ctrl_(ctrl), slot_(slot) {}
+  reference operator*() const { return *slot_; }
+  pointer operator->() const { return slot_; }
+  iterator_hash& operator++() {
+    do {
+      ++ctrl_;
+      ++slot_;
+    } while (*ctrl_ < hash_ctrl::sentinel);
+    return *this;
+  }
+  iterator_hash operator++(int) {
+    iterator_hash tmp = *this;
+    ++(*this);
+    return tmp;
+  }
+  operator const_iterator_hash<T>() const {
+    return const_iterator_hash<T>(ctrl_, slot_);
+  }
+  friend bool operator==(const iterator_hash& a, const iterator_hash& b) {
+    return a.slot_ == b.slot_;
+  }
+  friend bool operator!=(const iterator_hash& a, const iterator_hash& b) {
+    return a.slot_ != b.slot_;
+  }
+
+ private:
+  const int8_t* ctrl_;
+  T* slot_;
+};
+
+template <class T>
+class const_iterator_hash {
+  template <class, class, bool, class, class, class>
+  friend class hash_table;
+  friend class iterator_hash<T>;
+
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = T;
+  using pointer = const T*;
+  using reference = const T&;
+
+  const_iterator_hash() : ctrl_(nullptr), slot_(nullptr) {}
+  const_iterator_hash(const int8_t* ctrl, const T* slot)
+      : ctrl_(ctrl), slot_(slot) {}
+  reference operator*() const { return *slot_; }
+  pointer operator->() const { return slot_; }
+  const_iterator_hash& operator++() {
+    do {
+      ++ctrl_;
+      ++slot_;
+    } while (*ctrl_ < hash_ctrl::sentinel);
+    return *this;
+  }
+  const_iterator_hash operator++(int) {
+    const_iterator_hash tmp = *this;
+    ++(*this);
+    return tmp;
+  }
+  operator iterator_hash<T>() const {
+    return iterator_hash<T>(ctrl_, const_cast<T*>(slot_));
+  }
+  friend bool operator==(const const_iterator_hash& a,
+                         const const_iterator_hash& b) {
+    return a.slot_ == b.slot_;
+  }
+  friend bool operator!=(const const_iterator_hash& a,
+                         const const_iterator_hash& b) {
+    return a.slot_ != b.slot_;
+  }
+
+ private:
+  const int8_t* ctrl_;
+  const T* slot_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_HASH_TABLE
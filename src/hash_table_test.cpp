@@ -0,0 +1,140 @@
+#include "hash_table.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "unordered_map.h"
+#include "unordered_set.h"
+
+class HashTableTest : public ::testing::Test {};
+
+TEST(HashTableTest, RandomAgainstStd) {
+  s21::unordered_set<int> A;
+  std::unordered_set<int> B;
+  srand(21);
+  for (int i = 0; i < 50000; i++) {
+    int v = rand() % 5000;
+    if (rand() % 3 == 0) {
+      EXPECT_EQ(A.erase(v), B.erase(v));
+    } else {
+      EXPECT_EQ(A.insert(v).second, B.insert(v).second);
+    }
+    EXPECT_EQ(A.contains(v), B.count(v) == 1);
+  }
+  EXPECT_EQ(A.size(), B.size());
+  std::vector<int> a(A.begin(), A.end()), b(B.begin(), B.end());
+  std::sort(a.begin(), a.end());
+  std::sort(b.begin(), b.end());
+  EXPECT_EQ(a, b);
+  EXPECT_LE(A.load_factor(), A.max_load_factor());
+}
+
+// Keys inserted in one pass and erased in another never need tombstones
+// while their groups still have room.
+TEST(HashTableTest, EraseAndReuse) {
+  s21::unordered_set<int> A;
+  for (int round = 0; round < 20; round++) {
+    for (int i = 0; i < 1000; i++) {
+      A.insert(round * 1000 + i);
+    }
+    for (int i = 0; i < 1000; i++) {
+      EXPECT_EQ(A.erase(round * 1000 + i), 1);
+    }
+  }
+  EXPECT_TRUE(A.empty());
+  EXPECT_LE(A.bucket_count(), 4096);
+  EXPECT_EQ(A.begin(), A.end());
+}
+
+TEST(HashTableTest, ReserveAndLoadFactor) {
+  s21::unordered_set<int> A;
+  A.max_load_factor(0.25f);
+  A.reserve(1000);
+  size_t buckets = A.bucket_count();
+  EXPECT_GE(buckets * 0.25f, 1000);
+  for (int i = 0; i < 1000; i++) {
+    A.insert(i);
+  }
+  EXPECT_EQ(A.bucket_count(), buckets);
+  A.max_load_factor(2.0f);
+  EXPECT_LT(A.max_load_factor(), 1.0f);
+  A.rehash(0);
+  EXPECT_LT(A.bucket_count(), buckets);
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_TRUE(A.contains(i));
+  }
+}
+
+TEST(HashTableTest, Map) {
+  s21::unordered_map<std::string, std::string> A = {{"one", "1"},
+                                                    {"two", "2"}};
+  EXPECT_EQ(A.at("one"), "1");
+  EXPECT_THROW(A.at("three"), std::out_of_range);
+  A["three"] = "3";
+  EXPECT_EQ(A.size(), 3);
+  EXPECT_FALSE(A.insert("three", "drei").second);
+  A.insert_or_assign("three", "drei");
+  EXPECT_EQ(A["three"], "drei");
+  for (int i = 0; i < 1000; i++) {
+    A.insert(std::to_string(i), std::to_string(i * i));
+  }
+  auto B = A;
+  A.clear();
+  EXPECT_TRUE(A.empty());
+  EXPECT_EQ(B.size(), 1003);
+  EXPECT_EQ(B.at("30"), "900");
+  s21::unordered_map<std::string, std::string> C(std::move(B));
+  EXPECT_EQ(C.at("two"), "2");
+  EXPECT_TRUE(B.empty());
+  int visited = 0;
+  for (auto& i : C) {
+    EXPECT_EQ(C.at(i.first), i.second);
+    visited++;
+  }
+  EXPECT_EQ(visited, 1003);
+}
+
+TEST(HashTableTest, Multi) {
+  s21::unordered_multiset<int> A = {1, 2, 2, 3, 3, 3};
+  EXPECT_EQ(A.size(), 6);
+  EXPECT_EQ(A.count(3), 3);
+  EXPECT_EQ(A.erase(3), 3);
+  EXPECT_EQ(A.count(3), 0);
+  s21::unordered_multimap<int, std::string> B;
+  B.insert(1, "a");
+  B.insert(1, "b");
+  B.insert(2, "c");
+  EXPECT_EQ(B.count(1), 2);
+  std::unordered_multimap<int, std::string> C;
+  C.insert(B.begin(), B.end());
+  EXPECT_EQ(C.count(1), 2);
+}
+
+// Inserting a copy of an element the table holds must survive the table
+// growing, which moves that element, at every size.
+TEST(HashTableTest, MultiInsertsOwnElement) {
+  s21::unordered_multiset<std::string> A;
+  for (int i = 0; i < 200; i++) {
+    A.insert("element number " + std::to_string(i));
+    const std::string& own = *A.begin();
+    std::string expected = own;
+    A.insert(own);
+    EXPECT_EQ(A.count(expected), 2U);
+    EXPECT_EQ(A.count(""), 0U);
+    A.erase(A.find(expected));
+  }
+  EXPECT_EQ(A.size(), 200U);
+}
+
+TEST(HashTableTest, Merge) {
+  s21::unordered_set<int> A = {1, 2, 3}, B = {3, 4, 5};
+  A.merge(B);
+  EXPECT_EQ(A.size(), 5);
+  EXPECT_EQ(B.size(), 1);
+  EXPECT_TRUE(B.contains(3));
+}
@@ -0,0 +1,310 @@
+#ifndef SRC_INTRUSIVE_LIST
+#define SRC_INTRUSIVE_LIST
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+// Link fields embedded in an object so that intrusive containers can chain
+// it without allocating a node or copying it. A hook is in at most one
+// list at a time. It unlinks itself when destroyed, and a copied object
+// starts out unlinked.
+struct list_hook {
+  list_hook* prev;
+  list_hook* next;
+
+  list_hook() : prev(nullptr), next(nullptr) {}
+  list_hook(const list_hook&) : list_hook() {}
+  list_hook& operator=(const list_hook&) { return *this; }
+  ~list_hook() { unlink(); }
+
+  [[nodiscard]] bool is_linked() const { return next != nullptr; }
+  // Takes the object out of whatever list holds it, in O(1) and without
+  // needing that list.
+  void unlink() {
+    if (next == nullptr) return;
+    prev->next = next;
+    next->prev = prev;
+    prev = next = nullptr;
+  }
+  // Links this unlinked hook in front of pos.
+  void link_before(list_hook* pos) {
+    prev = pos->prev;
+    next = pos;
+    prev->next = this;
+    pos->prev = this;
+  }
+};
+
+// Maps a hook back to the object it is embedded in.
+template <class T, list_hook T::*Hook>
+struct hook_traits {
+  static T* owner(const list_hook* h) {
+    return reinterpret_cast<T*>(
+        reinterpret_cast<char*>(const_cast<list_hook*>(h)) - offset_());
+  }
+  static list_hook* hook(T& obj) { return &(obj.*Hook); }
+
+ private:
+  // Offset of the hook inside T. It is measured once, on static storage
+  // for a T, so no T is constructed and no access pays for the probe.
+  static std::ptrdiff_t offset_() {
+    static const std::ptrdiff_t offset = [] {
+      alignas(T) static unsigned char storage[sizeof(T)];
+      T* probe = reinterpret_cast<T*>(storage);
+      return reinterpret_cast<char*>(&(probe->*Hook)) -
+             reinterpret_cast<char*>(probe);
+    }();
+    return offset;
+  }
+};
+
+template <class T, list_hook T::*Hook, bool Const>
+class intrusive_list_iterator;
+
+// Doubly linked list threaded through the list_hook member Hook of objects
+// that live elsewhere: inserting never allocates and never copies, erasing
+// never destroys. The list is a ring closed by a hook inside the list
+// object, so any element can be unlinked in O(1) through its own hook.
+// That is also why there is no cached size: size() walks the list, while
+// empty() is O(1). Objects must outlive their membership or unlink first,
+// which their hook's destructor does for them.
+template <class T, list_hook T::*Hook>
+class intrusive_list {
+  using traits = hook_traits<T, Hook>;
+
+ public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using size_type = size_t;
+  using iterator = intrusive_list_iterator<T, Hook, false>;
+  using const_iterator = intrusive_list_iterator<T, Hook, true>;
+
+ private:
+  list_hook root_;
+
+ public:
+  // CONSTRUCTORS
+  intrusive_list() { root_.prev = root_.next = &root_; }
+  intrusive_list(const intrusive_list&) = delete;
+  intrusive_list(intrusive_list&& other) noexcept : intrusive_list() {
+    swap(other);
+  }
+  ~intrusive_list() { clear(); }
+
+  // OPERATORS
+  intrusive_list& operator=(const intrusive_list&) = delete;
+  intrusive_list& operator=(intrusive_list&& other) noexcept {
+    if (this != &other) {
+      clear();
+      swap(other);
+    }
+    return *this;
+  }
+
+  // ITERATORS
+  iterator begin() { return iterator(root_.next); }
+  iterator end() { return iterator(&root_); }
+  const_iterator begin() const { return const_iterator(root_.next); }
+  const_iterator end() const { return const_iterator(&root_); }
+  // Iterator to obj, which must be in this list.
+  iterator iterator_to(T& obj) { return iterator(traits::hook(obj)); }
+
+  // ELEMENT ACCESS
+  reference front() { return *traits::owner(root_.next); }
+  const_reference front() const { return *traits::owner(root_.next); }
+  reference back() { return *traits::owner(root_.prev); }
+  const_reference back() const { return *traits::owner(root_.prev); }
+
+  // CAPACITY
+  [[nodiscard]] bool empty() const { return root_.next == &root_; }
+  // O(n): counts the elements.
+  [[nodiscard]] size_type size() const {
+    size_type ret = 0;
+    for (const list_hook* h = root_.next; h != &root_; h = h->next) {
+      ret++;
+    }
+    return ret;
+  }
+
+  // MODIFIERS
+  // obj must not be linked into any list.
+  void push_back(T& obj) { traits::hook(obj)->link_before(&root_); }
+  void push_front(T& obj) { traits::hook(obj)->link_before(root_.next); }
+  iterator insert(const_iterator pos, T& obj) {
+    list_hook* h = traits::hook(obj);
+    h->link_before(pos.node_);
+    return iterator(h);
+  }
+  void pop_front() { root_.next->unlink(); }
+  void pop_back() { root_.prev->unlink(); }
+  // Unlinks the element at pos and returns the one after it.
+  iterator erase(const_iterator pos) {
+    list_hook* next = pos.node_->next;
+    pos.node_->unlink();
+    return iterator(next);
+  }
+  void erase(T& obj) { traits::hook(obj)->unlink(); }
+  // Unlinks every element; the objects themselves are untouched.
+  void clear() {
+    list_hook* h = root_.next;
+    while (h != &root_) {
+      list_hook* next = h->next;
+      h->prev = h->next = nullptr;
+      h = next;
+    }
+    root_.prev = root_.next = &root_;
+  }
+  // Moves all elements of other in front of pos in O(1).
+  void splice(const_iterator pos, intrusive_list& other) {
+    if (other.empty() || &other == this) return;
+    list_hook* first = other.root_.next;
+    list_hook* last = other.root_.prev;
+    other.root_.prev = other.root_.next = &other.root_;
+    first->prev = pos.node_->prev;
+    last->next = pos.node_;
+    first->prev->next = first;
+    pos.node_->prev = last;
+  }
+  void swap(intrusive_list& other) noexcept {
+    list_hook tmp;
+    move_ring_(root_, tmp);
+    move_ring_(other.root_, root_);
+    move_ring_(tmp, other.root_);
+  }
+
+ private:
+  // HELPER FUNCTIONS
+  // Hands the ring closed by from over to to, leaving from empty.
+  static void move_ring_(list_hook& from, list_hook& to) {
+    if (from.next == &from) {
+      to.prev = to.next = &to;
+    } else {
+      to.next = from.next;
+      to.prev = from.prev;
+      to.next->prev = &to;
+      to.prev->next = &to;
+    }
+    from.prev = from.next = &from;
+  }
+};
+
+template <class T, list_hook T::*Hook, bool Const>
+class intrusive_list_iterator {
+  friend class intrusive_list<T, Hook>;
+  friend class intrusive_list_iterator<T, Hook, !Const>;
+  using traits = hook_traits<T, Hook>;
+
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = T;
+  using pointer = std::conditional_t<Const, const T*, T*>;
+  using reference = std::conditional_t<Const, const T&, T&>;
+
+  intrusive_list_iterator() : node_(nullptr) {}
+  explicit intrusive_list_iterator(const list_hook* node)
+      : node_(const_cast<list_hook*>(node)) {}
+  operator intrusive_list_iterator<T, Hook, true>() const {
+    return intrusive_list_iterator<T, Hook, true>(node_);
+  }
+
+  reference operator*() const { return *traits::owner(node_); }
+  pointer operator->() const { return traits::owner(node_); }
+  intrusive_list_iterator& operator++() {
+    node_ = node_->next;
+    return *this;
+  }
+  intrusive_list_iterator operator++(int) {
+    intrusive_list_iterator tmp = *this;
+    node_ = node_->next;
+    return tmp;
+  }
+  intrusive_list_iterator& operator--() {
+    node_ = node_->prev;
+    return *this;
+  }
+  intrusive_list_iterator operator--(int) {
+    intrusive_list_iterator tmp = *this;
+    node_ = node_->prev;
+    return tmp;
+  }
+  friend bool operator==(const intrusive_list_iterator& a,
+                         const intrusive_list_iterator& b) {
+    return a.node_ == b.node_;
+  }
+  friend bool operator!=(const intrusive_list_iterator& a,
+                         const intrusive_list_iterator& b) {
+    return a.node_ != b.node_;
+  }
+
+ private:
+  list_hook* node_;
+};
+
+// LIFO of objects linked through their Hook member; see intrusive_list.
+template <class T, list_hook T::*Hook>
+class intrusive_stack {
+ public:
+  using container_type = intrusive_list<T, Hook>;
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = size_t;
+
+ protected:
+  container_type c_;
+
+ public:
+  // ELEMENT ACCESS
+  reference top() { return c_.back(); }
+  const_reference top() const { return c_.back(); }
+
+  // CAPACITY
+  [[nodiscard]] bool empty() const { return c_.empty(); }
+  [[nodiscard]] size_type size() const { return c_.size(); }
+
+  // MODIFIERS
+  void push(T& obj) { c_.push_back(obj); }
+  void pop() { c_.pop_back(); }
+  void swap(intrusive_stack& other) noexcept { c_.swap(other.c_); }
+};
+
+// FIFO of objects linked through their Hook member; see intrusive_list.
+template <class T, list_hook T::*Hook>
+class intrusive_queue {
+ public:
+  using container_type = intrusive_list<T, Hook>;
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = size_t;
+
+ protected:
+  container_type c_;
+
+ public:
+  // ELEMENT ACCESS
+  reference front() { return c_.front(); }
+  const_reference front() const { return c_.front(); }
+  reference back() { return c_.back(); }
+  const_reference back() const { return c_.back(); }
+
+  // CAPACITY
+  [[nodiscard]] bool empty() const { return c_.empty(); }
+  [[nodiscard]] size_type size() const { return c_.size(); }
+
+  // MODIFIERS
+  void push(T& obj) { c_.push_back(obj); }
+  void pop() { c_.pop_front(); }
+  void swap(intrusive_queue& other) noexcept { c_.swap(other.c_); }
+};
+
+}  // namespace s21
+
+#endif  // SRC_INTRUSIVE_LIST
@@ -0,0 +1,144 @@
+#include "intrusive_list.h"
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+struct timer {
+  int deadline;
+  std::string name;
+  s21::list_hook by_deadline;
+  s21::list_hook pending;
+
+  explicit timer(int d = 0) : deadline(d), name(std::to_string(d)) {}
+};
+
+using timer_list = s21::intrusive_list<timer, &timer::by_deadline>;
+
+std::vector<int> deadlines(const timer_list& l) {
+  std::vector<int> ret;
+  for (auto& t : l) {
+    ret.push_back(t.deadline);
+  }
+  return ret;
+}
+
+}  // namespace
+
+class IntrusiveListTest : public ::testing::Test {};
+
+TEST(IntrusiveListTest, LinksObjectsInPlace) {
+  std::vector<timer> timers;
+  for (int i = 0; i < 10; i++) {
+    timers.emplace_back(i);
+  }
+  timer_list A;
+  std::list<int> B;
+  for (auto& t : timers) {
+    if (t.deadline % 2 == 0) {
+      A.push_back(t);
+      B.push_back(t.deadline);
+    } else {
+      A.push_front(t);
+      B.push_front(t.deadline);
+    }
+  }
+  EXPECT_EQ(A.size(), 10U);
+  EXPECT_EQ(deadlines(A), std::vector<int>(B.begin(), B.end()));
+  EXPECT_EQ(&A.front(), &timers[9]);
+  EXPECT_EQ(&A.back(), &timers[8]);
+  EXPECT_EQ(A.begin()->name, "9");
+
+  timers[4].by_deadline.unlink();
+  A.erase(timers[9]);
+  B.remove(4);
+  B.remove(9);
+  EXPECT_FALSE(timers[4].by_deadline.is_linked());
+  EXPECT_EQ(deadlines(A), std::vector<int>(B.begin(), B.end()));
+
+  auto it = A.erase(A.iterator_to(timers[0]));
+  EXPECT_EQ(it->deadline, 2);
+  A.insert(it, timers[9]);
+  EXPECT_EQ((--A.iterator_to(timers[2]))->deadline, 9);
+  A.pop_front();
+  A.pop_back();
+  EXPECT_EQ(A.front().deadline, 5);
+  EXPECT_EQ(A.back().deadline, 6);
+  A.clear();
+  EXPECT_TRUE(A.empty());
+  EXPECT_FALSE(timers[5].by_deadline.is_linked());
+}
+
+TEST(IntrusiveListTest, TwoHooksAndAutoUnlink) {
+  s21::intrusive_list<timer, &timer::pending> pending;
+  timer_list by_deadline;
+  timer a(1);
+  {
+    timer b(2);
+    timer c(3);
+    by_deadline.push_back(a);
+    by_deadline.push_back(b);
+    by_deadline.push_back(c);
+    pending.push_back(c);
+    pending.push_back(b);
+    EXPECT_EQ(pending.front().deadline, 3);
+    timer copy(b);
+    EXPECT_FALSE(copy.by_deadline.is_linked());
+  }
+  EXPECT_TRUE(pending.empty());
+  EXPECT_EQ(by_deadline.size(), 1U);
+  EXPECT_EQ(&by_deadline.front(), &a);
+}
+
+TEST(IntrusiveListTest, SwapMoveAndSplice) {
+  timer t[6] = {timer(0), timer(1), timer(2), timer(3), timer(4), timer(5)};
+  timer_list A;
+  timer_list B;
+  A.push_back(t[0]);
+  A.push_back(t[1]);
+  B.push_back(t[2]);
+  A.swap(B);
+  EXPECT_EQ(deadlines(A), std::vector<int>({2}));
+  EXPECT_EQ(deadlines(B), std::vector<int>({0, 1}));
+  timer_list C(std::move(B));
+  EXPECT_TRUE(B.empty());
+  EXPECT_EQ(deadlines(C), std::vector<int>({0, 1}));
+  B.push_back(t[3]);
+  B.push_back(t[4]);
+  C.splice(++C.begin(), B);
+  EXPECT_TRUE(B.empty());
+  EXPECT_EQ(deadlines(C), std::vector<int>({0, 3, 4, 1}));
+  A = std::move(C);
+  EXPECT_EQ(deadlines(A), std::vector<int>({0, 3, 4, 1}));
+  EXPECT_FALSE(t[2].by_deadline.is_linked());
+  const timer_list& D = A;
+  EXPECT_EQ((--D.end())->deadline, 1);
+}
+
+TEST(IntrusiveListTest, StackAndQueue) {
+  timer t[3] = {timer(0), timer(1), timer(2)};
+  s21::intrusive_stack<timer, &timer::by_deadline> S;
+  s21::intrusive_queue<timer, &timer::pending> Q;
+  for (auto& i : t) {
+    S.push(i);
+    Q.push(i);
+  }
+  EXPECT_EQ(S.size(), 3U);
+  EXPECT_EQ(S.top().deadline, 2);
+  EXPECT_EQ(Q.front().deadline, 0);
+  EXPECT_EQ(Q.back().deadline, 2);
+  S.pop();
+  Q.pop();
+  EXPECT_EQ(S.top().deadline, 1);
+  EXPECT_EQ(Q.front().deadline, 1);
+  t[1].pending.unlink();
+  EXPECT_EQ(Q.front().deadline, 2);
+  s21::intrusive_queue<timer, &timer::pending> R;
+  R.swap(Q);
+  EXPECT_TRUE(Q.empty());
+  EXPECT_EQ(R.size(), 1U);
+}
@@ -2,8 +2,10 @@
 #define SEC
 
 #include <cstddef>   // For std::ptrdiff_t
+#include <functional>
 #include <iterator>  // For std::forward_iterator_tag
 #include <list>
+#include <utility>
 namespace s21 {
 
 template <class T>
@@ -15,6 +17,9 @@ struct ListNode {
     prev = nullptr;
     next = nullptr;
   }
+  template <class... Args>
+  explicit ListNode(std::in_place_t, Args&&... args)
+      : prev(nullptr), next(nullptr), data(std::forward<Args>(args)...) {}
 };
 
 template <class T>
@@ -71,34 +76,20 @@ class list {
       this->push_back(i);
     }
   }
-  list(list&& l) noexcept {
-    _back = l._back;
-    _front = l._front;
-    _size = l._size;
-    l._front = nullptr;
-    l._back = nullptr;
-    l._size = 0;
-  }
+  // The moved-from list gets a fresh sentinel and stays usable.
+  list(list&& l) : list() { this->swap(l); }
   list& operator=(const list& l) {
-    if (this == l) return *this;
-    if (_front != nullptr) {
-      this->clear();
-      delete _back;
-    }
-    _front = _back = new Node;
-    _size = 0;
-    for (auto i : l) {
-      this->push_back(i);
+    if (this != &l) {
+      list tmp(l);
+      this->swap(tmp);
     }
     return *this;
   }
   list& operator=(list&& l) noexcept {
-    _front = l._front;
-    _back = l._back;
-    _size = l._size;
-    l._front = nullptr;
-    l._back = nullptr;
-    l._size = 0;
+    if (this != &l) {
+      this->swap(l);
+      l.clear();
+    }
     return *this;
   }
   const_iterator begin() const { return const_iterator(_front); }
@@ -106,10 +97,16 @@ class list {
   iterator begin() { return iterator(_front); }
   iterator end() { return iterator(_back); }
 
+  // ELEMENT ACCESS
+  reference front() { return _front->data; }
+  const_reference front() const { return _front->data; }
+  reference back() { return _back->prev->data; }
+  const_reference back() const { return _back->prev->data; }
+
   // CAPACITY
-  bool empty() { return !(bool)_size; }
-  size_type size() { return _size; }
-  size_type max_size() { return std::numeric_limits<T>::max(); }
+  bool empty() const { return !(bool)_size; }
+  size_type size() const { return _size; }
+  size_type max_size() const { return std::numeric_limits<T>::max(); }
 
   // MODIFIERS
 
@@ -120,6 +117,7 @@ class list {
       delete i->prev;
     }
     _front = _back;
+    _size = 0;
   }
   void erase(iterator pos) {
     _size--;
@@ -134,58 +132,63 @@ class list {
     delete pos._node;
   }
   iterator insert(iterator pos, const_reference value) {
-    ++_size;
-    Node* node = new Node;
-    node->data = value;
-    node->next = pos._node;
-
-    if (pos._node == _front) {
-      _front = node;
-    } else {
-      pos->prev->next = node;
-      node->prev = pos->prev;
-    }
-    pos->prev = node;
-    return iterator(node);
+    return this->emplace_node_(pos._node, value);
+  }
+  iterator insert(iterator pos, value_type&& value) {
+    return this->emplace_node_(pos._node, std::move(value));
   }
-  void push_back(const_reference value) {
-    this->insert(iterator(_back), value);
+  void push_back(const_reference value) { this->emplace_node_(_back, value); }
+  void push_back(value_type&& value) {
+    this->emplace_node_(_back, std::move(value));
   }
   void push_front(const_reference value) {
-    this->insert(iterator(_front), value);
+    this->emplace_node_(_front, value);
+  }
+  void push_front(value_type&& value) {
+    this->emplace_node_(_front, std::move(value));
   }
+
   void pop_back() { this->erase(--iterator(_back)); }
   void pop_front() { this->erase(iterator(_front)); }
-  void swap(list& other) {
-    list tmp(other);
-    other = *this;
-    *this = tmp;
-  }
-  void merge(list& other) {
-    iterator other_iterator = other.begin();
-    for (auto i = this->begin(); i != this->end(); i++) {
-      while (other_iterator != other.end() && *other_iterator < *i) {
-        this->insert(i, *other_iterator);
-        other.erase(other_iterator);
-        other_iterator = other.begin();
-      }
-    }
-    while (other.size() != 0) {
-      this->insert(this->end(), *(other.begin()));
-      other.erase(other.begin());
+  // Both sentinels live on the heap, so swapping is three exchanges.
+  void swap(list& other) noexcept {
+    std::swap(_front, other._front);
+    std::swap(_back, other._back);
+    std::swap(_size, other._size);
+  }
+  // Merges the sorted other into this sorted list by relinking nodes, in
+  // one linear pass; equal elements of this list stay first.
+  void merge(list& other) { this->merge(other, std::less<>()); }
+  template <class Compare>
+  void merge(list& other, Compare comp) {
+    if (&other == this || other.empty()) {
+      return;
     }
+    Node* chain = this->detach_chain_();
+    this->attach_chain_(merge_chains_(chain, other.detach_chain_(), comp));
+    _size += other._size;
+    other._size = 0;
   }
 
+  // Moves all of other in front of pos, in O(1).
   void splice(iterator pos, list& other) {
-    if (pos != _front) {
-      pos->prev->next = other.begin()._node;
-      other.begin()._node->prev = pos->prev;
+    if (&other == this || other.empty()) {
+      return;
+    }
+    Node* first = other._front;
+    Node* last = other._back->prev;
+    last->next = pos._node;
+    if (pos._node == _front) {
+      _front = first;
     } else {
-      _front = other._front;
+      pos->prev->next = first;
+      first->prev = pos->prev;
     }
-    (--other.end())->next = pos._node;
-    pos->prev = (--other.end())._node;
+    pos->prev = last;
+    _size += other._size;
     other._front = other._back;
+    other._back->prev = nullptr;
+    other._size = 0;
   }
   void reverse() {
     iterator i = this->begin();
@@ -201,53 +204,132 @@ class list {
     _back->prev = _front;
     _front = tmp;
   }
-  void unique() {
-    auto i = ++(this->begin());
-    while (i != this->end()) {
-      iterator tmp(i->next);
-      if (*i == (i->prev)->data) {
-        this->erase(i);
+  // Erases every element for which pred(kept, element) holds, kept being
+  // the last element not erased before it.
+  void unique() { this->unique(std::equal_to<>()); }
+  template <class BinaryPredicate>
+  void unique(BinaryPredicate pred) {
+    if (_size < 2) {
+      return;
+    }
+    Node* kept = _front;
+    Node* i = kept->next;
+    while (i != _back) {
+      Node* next = i->next;
+      if (pred(kept->data, i->data)) {
+        kept->next = next;
+        next->prev = kept;
+        delete i;
+        _size--;
+      } else {
+        kept = i;
       }
-      i = tmp;
+      i = next;
     }
   }
-  void sort() {
-    if (_size <= 1) {
+  // Stable bottom-up merge sort that only relinks nodes: bin k holds a
+  // sorted run of 2^k nodes, and each new node carries into the bins like
+  // a binary counter. Allocates nothing and recurses nowhere.
+  void sort() { this->sort(std::less<>()); }
+  template <class Compare>
+  void sort(Compare comp) {
+    if (_size < 2) {
       return;
     }
-    list first;
-    list second;
-    int counter = 0;
-    for (auto i : *this) {
-      if (counter < _size / 2) {
-        first.push_back(i);
-      } else {
-        second.push_back(i);
+    Node* bins[64] = {};
+    Node* chain = this->detach_chain_();
+    while (chain != nullptr) {
+      Node* carry = chain;
+      chain = chain->next;
+      carry->next = nullptr;
+      int k = 0;
+      for (; bins[k] != nullptr; k++) {
+        carry = merge_chains_(bins[k], carry, comp);
+        bins[k] = nullptr;
       }
-      counter++;
+      bins[k] = carry;
     }
-    first.sort();
-    second.sort();
-    first.merge(second);
-    *this = first;
+    Node* sorted = nullptr;
+    for (Node* bin : bins) {
+      if (bin != nullptr) sorted = merge_chains_(bin, sorted, comp);
+    }
+    this->attach_chain_(sorted);
   }
 
   template <class... Args>
   iterator emplace(const_iterator pos, Args&&... args) {
-    value_type val(args...);
-    return this->insert(pos, val);
+    return this->emplace_node_(pos._node, std::forward<Args>(args)...);
   }
 
   template <class... Args>
   void emplace_back(Args&&... args) {
-    value_type val(args...);
-    this->insert(this->end(), val);
+    this->emplace_node_(_back, std::forward<Args>(args)...);
   }
 
   template <class... Args>
   void emplace_front(Args&&... args) {
-    value_type val(args...);
-    this->insert(this->begin(), val);
+    this->emplace_node_(_front, std::forward<Args>(args)...);
+  }
+
+ private:
+  // Unhooks the elements as a chain linked through next and ending in
+  // nullptr. _size is left for the caller to settle.
+  Node* detach_chain_() {
+    if (_front == _back) {
+      return nullptr;
+    }
+    _back->prev->next = nullptr;
+    Node* ret = _front;
+    _front = _back;
+    _back->prev = nullptr;
+    return ret;
+  }
+  // Makes chain the contents of the list, restoring the prev links.
+  void attach_chain_(Node* chain) {
+    if (chain == nullptr) {
+      return;
+    }
+    _front = chain;
+    chain->prev = nullptr;
+    while (chain->next != nullptr) {
+      chain->next->prev = chain;
+      chain = chain->next;
+    }
+    chain->next = _back;
+    _back->prev = chain;
+  }
+  // Merges two sorted chains, taking from a on ties.
+  template <class Compare>
+  static Node* merge_chains_(Node* a, Node* b, Compare& comp) {
+    Node* ret = nullptr;
+    Node** tail = &ret;
+    while (a != nullptr && b != nullptr) {
+      if (comp(b->data, a->data)) {
+        *tail = b;
+        b = b->next;
+      } else {
+        *tail = a;
+        a = a->next;
+      }
+      tail = &(*tail)->next;
+    }
+    *tail = a != nullptr ? a : b;
+    return ret;
+  }
+  // Builds the element inside a new node and links it in before pos.
+  template <class... Args>
+  iterator emplace_node_(Node* pos, Args&&... args) {
+    Node* node = new Node(std::in_place, std::forward<Args>(args)...);
+    ++_size;
+    node->next = pos;
+    if (pos == _front) {
+      _front = node;
+    } else {
+      pos->prev->next = node;
+      node->prev = pos->prev;
+    }
+    pos->prev = node;
+    return iterator(node);
   }
 };
 
@@ -0,0 +1,180 @@
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench.h"
+#include "intrusive_list.h"
+#include "list.h"
+#include "unrolled_list.h"
+
+namespace {
+
+using namespace s21::bench;
+
+template <class L, class T>
+std::unique_ptr<L> filled(const std::vector<T>& keys) {
+  auto ret = std::make_unique<L>();
+  for (auto& i : keys) {
+    ret->push_back(i);
+  }
+  return ret;
+}
+
+// A filled list and a position in its middle.
+template <class L>
+struct middle {
+  std::unique_ptr<L> list;
+  decltype(std::declval<L&>().begin()) pos;
+};
+
+template <class L, class T>
+void run_list(const char* impl, size_t n) {
+  const char* key = key_name<T>();
+  auto keys = shuffled_keys<T>(n);
+  measure(
+      "list", impl, "push_back", key, n, n,
+      [] { return std::make_unique<L>(); },
+      [&](std::unique_ptr<L>& l) {
+        for (auto& i : keys) {
+          l->push_back(i);
+        }
+        keep(l->size());
+      });
+  measure(
+      "list", impl, "push_front", key, n, n,
+      [] { return std::make_unique<L>(); },
+      [&](std::unique_ptr<L>& l) {
+        for (auto& i : keys) {
+          l->push_front(i);
+        }
+        keep(l->size());
+      });
+  measure(
+      "list", impl, "pop_front", key, n, n, [&] { return filled<L>(keys); },
+      [&](std::unique_ptr<L>& l) {
+        for (size_t i = 0; i < n; i++) {
+          l->pop_front();
+        }
+        keep(l->size());
+      });
+  measure(
+      "list", impl, "insert_middle", key, n, n,
+      [&] {
+        middle<L> ret{filled<L>(keys), {}};
+        ret.pos = ret.list->begin();
+        for (size_t i = 0; i < n / 2; i++) {
+          ++ret.pos;
+        }
+        return ret;
+      },
+      [&](middle<L>& m) {
+        for (auto& i : keys) {
+          m.pos = m.list->insert(m.pos, i);
+        }
+        keep(m.list->size());
+      });
+  measure(
+      "list", impl, "sort", key, n, n, [&] { return filled<L>(keys); },
+      [](std::unique_ptr<L>& l) {
+        l->sort();
+        keep(l->front());
+      });
+  auto full = filled<L>(keys);
+  measure(
+      "list", impl, "iterate", key, n, n, [&] { return full.get(); },
+      [](L* l) {
+        std::uint64_t sum = 0;
+        for (auto i = l->begin(); i != l->end(); ++i) {
+          sum += checksum(*i);
+        }
+        keep(sum);
+      });
+  measure(
+      "list", impl, "reverse", key, n, n, [&] { return full.get(); },
+      [](L* l) { l->reverse(); });
+}
+
+// The elements already live in a vector, as in an event loop that owns its
+// timers, so linking them allocates nothing.
+template <class T>
+struct hooked {
+  T key;
+  s21::list_hook hook;
+};
+
+template <class T>
+void run_intrusive(size_t n) {
+  using L = s21::intrusive_list<hooked<T>, &hooked<T>::hook>;
+  const char* key = key_name<T>();
+  auto keys = shuffled_keys<T>(n);
+  std::vector<hooked<T>> items(n);
+  for (size_t i = 0; i < n; i++) {
+    items[i].key = keys[i];
+  }
+  auto filled = [&] {
+    auto ret = std::make_unique<L>();
+    for (auto& i : items) {
+      ret->push_back(i);
+    }
+    return ret;
+  };
+  measure(
+      "list", "s21_intrusive", "push_back", key, n, n,
+      [] { return std::make_unique<L>(); },
+      [&](std::unique_ptr<L>& l) {
+        for (auto& i : items) {
+          l->push_back(i);
+        }
+        keep(l->empty());
+      });
+  measure(
+      "list", "s21_intrusive", "push_front", key, n, n,
+      [] { return std::make_unique<L>(); },
+      [&](std::unique_ptr<L>& l) {
+        for (auto& i : items) {
+          l->push_front(i);
+        }
+        keep(l->empty());
+      });
+  measure(
+      "list", "s21_intrusive", "pop_front", key, n, n, filled,
+      [&](std::unique_ptr<L>& l) {
+        for (size_t i = 0; i < n; i++) {
+          l->pop_front();
+        }
+        keep(l->empty());
+      });
+  auto full = filled();
+  measure(
+      "list", "s21_intrusive", "iterate", key, n, n,
+      [&] { return full.get(); },
+      [](L* l) {
+        std::uint64_t sum = 0;
+        for (auto i = l->begin(); i != l->end(); ++i) {
+          sum += checksum(i->key);
+        }
+        keep(sum);
+      });
+}
+
+template <class T>
+void run_key() {
+  for (size_t n : sizes()) {
+    run_list<s21::list<T>, T>("s21", n);
+    run_list<s21::unrolled_list<T>, T>("s21_unrolled", n);
+    run_intrusive<T>(n);
+    run_list<std::list<T>, T>("std", n);
+  }
+}
+
+void run() {
+  run_key<int>();
+  run_key<std::string>();
+  run_key<blob64>();
+}
+
+registrar reg("list", run);
+
+}  // namespace
@@ -2,103 +2,147 @@
 #ifndef srcmap
 #define srcmap
 
+#include <iterator>
 #include <stdexcept>
+#include <type_traits>
 
+#include "bplus_tree.h"
 #include "btree.h"
 namespace s21 {
 
-template <class K, class M>
-struct MapNode {
+// Shared nodes are read without a lock by concurrent_map's readers; see
+// has_shared_links.
+template <class K, class M, bool Ranked = false, bool Shared = false>
+struct MapNode : subtree_size<Ranked> {
   using value_type = std::pair<K, M>;
+  static constexpr bool shared_links = Shared;
 
  public:
   Color color;
   std::pair<K, M> key;
-  MapNode<K, M>* left = nullptr;
-  MapNode<K, M>* right = nullptr;
-  MapNode<K, M>* parent;
-  MapNode() {
-    key = 0;
-    parent = left = right = nullptr;
-    color = BLACK;
-  }
-  MapNode(const value_type k, MapNode<K, M>* p) {
-    color = RED;
-    parent = p;
-    key = k;
-  }
+  MapNode* left = nullptr;
+  MapNode* right = nullptr;
+  MapNode* parent;
+  MapNode() : color(BLACK), key(), parent(nullptr) {}
+  template <class... Args>
+  explicit MapNode(std::in_place_t, Args&&... args)
+      : color(RED), key(std::forward<Args>(args)...), parent(nullptr) {}
 };
 
-template <class K, class V>
-class map : public btree<K, V, MapNode<K, V>, false> {
-  using btree<K, V, MapNode<K, V>, false>::btree;
-  using Node = MapNode<K, V>;
+template <class K, class V, class Compare = std::less<K>,
+          class Allocator = slab_allocator<std::pair<K, V>>,
+          class Engine = rb_tree_engine>
+class map
+    : public Engine::template type<K, V, MapNode<K, V, Engine::ranked>, false,
+                                   Compare, Allocator> {
+  using base = typename Engine::template type<
+      K, V, MapNode<K, V, Engine::ranked>, false, Compare, Allocator>;
+  using base::base;
   using mapped_type = V;
   using value_type = typename std::pair<K, V>;
   using reference = value_type&;
   using const_reference = const value_type&;
-  using iterator = iterator_btree<K, K, MapNode<K, V>, false>;
-  using const_iterator = const_iterator_btree<K, V, MapNode<K, V>, false>;
+  using iterator = typename base::iterator;
+  using const_iterator = typename base::const_iterator;
   using size_type = size_t;
 
  public:
   V& at(const K& key) {
-    Node* found = find_(key, this->root_);
-    if (found == nullptr) {
+    auto found = this->find(key);
+    if (found == this->end()) {
       throw std::out_of_range("index out of range");
     }
-    return found->key.second;
+    return (*found).second;
   }
   const V& at(const K& key) const {
-    Node* found = find_(key, this->root_);
-    if (found == nullptr) {
+    auto found = this->find(key);
+    if (found == this->end()) {
+      throw std::out_of_range("index out of range");
+    }
+    return (*found).second;
+  }
+  template <class Key, class C = Compare, class = typename C::is_transparent>
+  V& at(const Key& key) {
+    auto found = this->find(key);
+    if (found == this->end()) {
       throw std::out_of_range("index out of range");
     }
-    return found->key.second;
+    return (*found).second;
+  }
+  template <class Key, class C = Compare, class = typename C::is_transparent>
+  const V& at(const Key& key) const {
+    auto found = this->find(key);
+    if (found == this->end()) {
+      throw std::out_of_range("index out of range");
+    }
+    return (*found).second;
   }
   V& operator[](const K& key) {
-    Node* found = find_(key, this->root_);
-    if (found == nullptr) {
-      V dummy = 0;
-      auto i = this->insert_iter(std::pair<K, V>(key, dummy));
-      return (*(i.first)).second;
+    auto found = this->find(key);
+    if (found == this->end()) {
+      return (*this->emplace(key, V()).first).second;
     }
-    return found->key.second;
+    return (*found).second;
+  }
+  V& operator[](K&& key) {
+    auto found = this->find(key);
+    if (found == this->end()) {
+      return (*this->emplace(std::move(key), V()).first).second;
+    }
+    return (*found).second;
   }
   std::pair<iterator, bool> insert(const value_type& value) {
     return this->insert_iter(value);
   }
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return this->insert_iter(std::move(value));
+  }
+
+  // Constrained so that insert("key", "value") is not taken for a range.
+  template <class InputIt,
+            class = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIt>::reference,
+                value_type>::value>>
+  void insert(InputIt first, InputIt last) {
+    this->insert_range_(first, last);
+  }
 
   std::pair<iterator, bool> insert(const K& key, const V& obj) {
-    std::pair<K, V> value(key, obj);
-    return this->insert_iter(value);
+    return this->emplace(key, obj);
   }
 
   std::pair<iterator, bool> insert_or_assign(const K& key, const V& obj) {
-    std::pair<K, V> value(key, obj);
-    std::pair<iterator, bool> a;
-    a = this->insert_iter(value);
+    std::pair<iterator, bool> a = this->emplace(key, obj);
     if (a.second == false) {
       (*a.first).second = obj;
       a.second = true;
     }
     return a;
   }
-
- private:
-  Node* find_(const K& key, Node* r) const {
-    if (r == nullptr) {
-      return nullptr;
-    }
-    if (r->key.first == key) {
-      return r;
-    }
-    if (r->key.first > key) {
-      return find_(key, r->left);
-    } else {
-      return find_(key, r->right);
-    }
-  }
 };
+
+// Non-destructive set algebra, see btree::set_union.
+template <class K, class V, class C, class A, class E>
+map<K, V, C, A, E> set_union(const map<K, V, C, A, E>& a,
+                             const map<K, V, C, A, E>& b) {
+  map<K, V, C, A, E> ret(a);
+  ret.set_union(b);
+  return ret;
+}
+template <class K, class V, class C, class A, class E>
+map<K, V, C, A, E> set_intersection(const map<K, V, C, A, E>& a,
+                                    const map<K, V, C, A, E>& b) {
+  map<K, V, C, A, E> ret(a);
+  ret.set_intersection(b);
+  return ret;
+}
+template <class K, class V, class C, class A, class E>
+map<K, V, C, A, E> set_difference(const map<K, V, C, A, E>& a,
+                                  const map<K, V, C, A, E>& b) {
+  map<K, V, C, A, E> ret(a);
+  ret.set_difference(b);
+  return ret;
+}
+
 }  // namespace s21
 #endif
\ No newline at end of file
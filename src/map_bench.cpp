@@ -0,0 +1,78 @@
+#include <map>
+#include <memory>
+#include <string>
+
+#include "bench.h"
+#include "map.h"
+
+namespace {
+
+using namespace s21::bench;
+
+template <class M, class T>
+void run_map(const char* impl, size_t n) {
+  const char* key = key_name<T>();
+  auto keys = shuffled_keys<T>(n);
+  auto filled = [&] {
+    auto m = std::make_unique<M>();
+    int v = 0;
+    for (auto& i : keys) {
+      m->insert(std::pair<T, int>(i, v++));
+    }
+    return m;
+  };
+  measure(
+      "map", impl, "insert", key, n, n, [] { return std::make_unique<M>(); },
+      [&](std::unique_ptr<M>& m) {
+        int v = 0;
+        for (auto& i : keys) {
+          m->insert(std::pair<T, int>(i, v++));
+        }
+        keep(m->size());
+      });
+  auto full = filled();
+  measure(
+      "map", impl, "find", key, n, n, [&] { return full.get(); },
+      [&](M* m) {
+        std::uint64_t sum = 0;
+        for (auto& i : keys) {
+          sum += (*m->find(i)).second;
+        }
+        keep(sum);
+      });
+  measure(
+      "map", impl, "iterate", key, n, n, [&] { return full.get(); },
+      [](M* m) {
+        std::uint64_t sum = 0;
+        for (auto i = m->begin(); i != m->end(); ++i) {
+          sum += checksum(*i);
+        }
+        keep(sum);
+      });
+  full.reset();
+  measure(
+      "map", impl, "erase", key, n, n, filled, [&](std::unique_ptr<M>& m) {
+        for (auto& i : keys) {
+          m->erase(m->find(i));
+        }
+        keep(m->size());
+      });
+}
+
+template <class T>
+void run_key() {
+  for (size_t n : sizes()) {
+    run_map<s21::map<T, int>, T>("s21", n);
+    run_map<std::map<T, int>, T>("std", n);
+  }
+}
+
+void run() {
+  run_key<int>();
+  run_key<std::string>();
+  run_key<blob64>();
+}
+
+registrar reg("map", run);
+
+}  // namespace
@@ -4,8 +4,12 @@
 #include <ctime>
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include "flat_map.h"
 #include "gtest/gtest.h"
+#include "unordered_map.h"
 // Copyright 2022 nolanhea
 
 template <class T, class K>
@@ -16,6 +20,43 @@ using original_map = std::map<T, K>;
 
 using std::pair;
 
+namespace {
+// Counts copies, so tests can check that moved-in elements are never
+// copied on their way into a container.
+struct copy_counted {
+  static int copies;
+  std::string payload;
+  explicit copy_counted(size_t n = 0) : payload(n, 'x') {}
+  copy_counted(const copy_counted& other) : payload(other.payload) {
+    copies++;
+  }
+  copy_counted(copy_counted&&) = default;
+  copy_counted& operator=(const copy_counted& other) {
+    payload = other.payload;
+    copies++;
+    return *this;
+  }
+  copy_counted& operator=(copy_counted&&) = default;
+};
+int copy_counted::copies = 0;
+
+template <class M>
+void expect_no_copies() {
+  copy_counted::copies = 0;
+  M m;
+  for (int i = 0; i < 300; i++) {
+    copy_counted c(1024);
+    m.insert(std::make_pair(4 * i, std::move(c)));
+    m.emplace(4 * i + 1, copy_counted(1024));
+    m[4 * i + 2] = copy_counted(1024);
+    m[4 * i + 3];
+  }
+  EXPECT_EQ(m.size(), 1200U);
+  EXPECT_EQ(m.at(1).payload.size(), 1024U);
+  EXPECT_EQ(copy_counted::copies, 0);
+}
+}  // namespace
+
 class S21MapTest : public ::testing::Test {};
 
 TEST(S21MapTest, DefaultConstructor) {
@@ -171,7 +212,94 @@ TEST(S21MapTest, Emplace) {
   EXPECT_EQ(A.size(), B.size());
 }
 
+TEST(S21MapTest, TransparentAt) {
+  s21::map<std::string, int, std::less<>> A;
+  A.insert("one", 1);
+  A.insert("two", 2);
+  std::string_view key = "two";
+  EXPECT_EQ(A.at(key), 2);
+  EXPECT_EQ(A.at("one"), 1);
+  EXPECT_EQ(A.count("one"), 1);
+  EXPECT_EQ((*A.find("two")).second, 2);
+  EXPECT_THROW(A.at("three"), std::out_of_range);
+  const auto &B = A;
+  EXPECT_EQ(B.at(key), 2);
+}
+
+TEST(S21MapTest, RangeConstructor) {
+  original_map<int, int> B;
+  for (int i = 0; i < 500; i++) {
+    B[i] = i * i;
+  }
+  map<int, int> A(B.begin(), B.end());
+  EXPECT_EQ(A.size(), B.size());
+  auto j = B.begin();
+  for (auto i : A) {
+    EXPECT_EQ(i.first, (*j).first);
+    EXPECT_EQ(i.second, (*j).second);
+    j++;
+  }
+  std::vector<std::pair<int, int>> unsorted = {{3, 30}, {1, 10}, {3, 31}};
+  A.assign(unsorted.begin(), unsorted.end());
+  EXPECT_EQ(A.size(), 2);
+  EXPECT_EQ(A.at(3), 30);
+}
+
+TEST(S21MapTest, SetAlgebra) {
+  map<int, int> A = {{1, 10}, {2, 20}, {3, 30}};
+  map<int, int> B = {{2, -2}, {3, -3}, {4, -4}};
+  map<int, int> U = s21::set_union(A, B);
+  EXPECT_EQ(U.size(), 4);
+  EXPECT_EQ(U.at(2), 20);
+  EXPECT_EQ(U.at(4), -4);
+  map<int, int> I = s21::set_intersection(A, B);
+  EXPECT_EQ(I.size(), 2);
+  EXPECT_EQ(I.at(3), 30);
+  A.set_difference(B);
+  EXPECT_EQ(A.size(), 1);
+  EXPECT_EQ(A.at(1), 10);
+  EXPECT_EQ(B.size(), 3);
+}
+
+TEST(S21MapTest, OrderStatistics) {
+  s21::map<std::string, int, std::less<>,
+           s21::slab_allocator<std::pair<std::string, int>>,
+           s21::ranked_rb_tree_engine>
+      A;
+  for (int i = 0; i < 100; i++) {
+    A[std::to_string(1000 + i)] = i;
+  }
+  EXPECT_EQ((*A.nth(42)).second, 42);
+  EXPECT_EQ(A.rank(std::string_view("1050")), 50);
+  EXPECT_EQ(A.count_range("1010", "1020"), 10);
+  A.erase(A.nth(0));
+  EXPECT_EQ((*A.nth(0)).second, 1);
+  EXPECT_EQ(A.index_of(A.find("1099")), 98);
+}
+
+TEST(S21MapTest, ForEach) {
+  map<int, int> A;
+  for (int i = 0; i < 100; i++) {
+    A.insert(i, i);
+  }
+  A.for_each_range(10, 20, [](std::pair<int, int>& v) { v.second = -1; });
+  int sum = 0;
+  A.for_each([&sum](const std::pair<int, int>& v) { sum += v.second; });
+  EXPECT_EQ(sum, 4950 - 145 - 10);
+  EXPECT_EQ(A.at(10), -1);
+  EXPECT_EQ(A.at(20), 20);
+}
+
 // int main(int argc, char **argv) {
 //   ::testing::InitGoogleTest(&argc, argv);
 //   return RUN_ALL_TESTS();
 // }
+
+TEST(S21MapTest, MovesWithoutCopies) {
+  expect_no_copies<map<int, copy_counted>>();
+  expect_no_copies<s21::map<int, copy_counted, std::less<int>,
+                            s21::slab_allocator<pair<int, copy_counted>>,
+                            s21::bplus_tree_engine>>();
+  expect_no_copies<s21::flat_map<int, copy_counted>>();
+  expect_no_copies<s21::unordered_map<int, copy_counted>>();
+}
@@ -0,0 +1,224 @@
+#ifndef SRC_MPMC_QUEUE
+#define SRC_MPMC_QUEUE
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+// Bounded lock-free queue for any number of producers and consumers, after
+// Dmitry Vyukov's design. Every slot carries a sequence number that says
+// whose turn it is: a producer may fill the slot for position pos when
+// seq == pos, a consumer may empty it when seq == pos + 1, and emptying it
+// sets seq to pos + capacity for the producer one lap later. Producers
+// claim positions by advancing tail_ with a CAS, consumers do the same with
+// head_; the slot's sequence number then hands the element over without
+// any further shared write.
+//
+// With MultiConsumer = false only one thread may pop, and it advances
+// head_ without a CAS (see mpsc_queue).
+template <class T, bool MultiConsumer = true,
+          class Allocator = std::allocator<T>>
+class mpmc_queue {
+  struct cell_ {
+    std::atomic<size_t> seq;
+    alignas(T) unsigned char raw[sizeof(T)];
+
+    T* value() { return std::launder(reinterpret_cast<T*>(raw)); }
+  };
+  using cell_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<cell_>;
+  using cell_traits = std::allocator_traits<cell_allocator>;
+
+ public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+
+  // CONSTRUCTORS
+  // capacity is rounded up to a power of two.
+  explicit mpmc_queue(size_type capacity = 1024,
+                      const Allocator& alloc = Allocator())
+      : head_(0), tail_(0), alloc_(alloc) {
+    capacity_ = 2;
+    while (capacity_ < capacity) capacity_ *= 2;
+    mask_ = capacity_ - 1;
+    cells_ = cell_traits::allocate(alloc_, capacity_);
+    for (size_type i = 0; i < capacity_; i++) {
+      ::new (static_cast<void*>(&cells_[i].seq)) std::atomic<size_t>(i);
+    }
+  }
+  mpmc_queue(const mpmc_queue&) = delete;
+  mpmc_queue& operator=(const mpmc_queue&) = delete;
+  ~mpmc_queue() {
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    for (size_type i = head_.load(std::memory_order_relaxed); i != tail; i++) {
+      cells_[i & mask_].value()->~T();
+    }
+    cell_traits::deallocate(alloc_, cells_, capacity_);
+  }
+
+  // PRODUCERS
+  bool try_push(const_reference value) { return try_emplace(value); }
+  bool try_push(T&& value) { return try_emplace(std::move(value)); }
+  template <class... Args>
+  bool try_emplace(Args&&... args) {
+    size_type pos = tail_.load(std::memory_order_relaxed);
+    cell_* cell;
+    for (;;) {
+      cell = &cells_[pos & mask_];
+      size_type seq = cell->seq.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+    ::new (static_cast<void*>(cell->raw)) T(std::forward<Args>(args)...);
+    cell->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+  // Claims up to n consecutive free slots with one CAS and copies elements
+  // from first into them. Returns how many were pushed.
+  template <class InputIt>
+  size_type try_push_n(InputIt first, size_type n) {
+    size_type pos = tail_.load(std::memory_order_relaxed);
+    size_type count;
+    for (;;) {
+      count = 0;
+      while (count < n && count < capacity_ &&
+             cells_[(pos + count) & mask_].seq.load(
+                 std::memory_order_acquire) == pos + count) {
+        count++;
+      }
+      if (count == 0) {
+        size_type seq = cells_[pos & mask_].seq.load(std::memory_order_acquire);
+        if (static_cast<std::ptrdiff_t>(seq - pos) < 0) return 0;
+        pos = tail_.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (tail_.compare_exchange_weak(pos, pos + count,
+                                      std::memory_order_relaxed)) {
+        break;
+      }
+    }
+    for (size_type i = 0; i < count; i++, ++first) {
+      cell_* cell = &cells_[(pos + i) & mask_];
+      ::new (static_cast<void*>(cell->raw)) T(*first);
+      cell->seq.store(pos + i + 1, std::memory_order_release);
+    }
+    return count;
+  }
+
+  // CONSUMERS
+  bool try_pop(reference out) {
+    size_type pos;
+    cell_* cell;
+    if constexpr (MultiConsumer) {
+      pos = head_.load(std::memory_order_relaxed);
+      for (;;) {
+        cell = &cells_[pos & mask_];
+        size_type seq = cell->seq.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+        if (diff == 0) {
+          if (head_.compare_exchange_weak(pos, pos + 1,
+                                          std::memory_order_relaxed)) {
+            break;
+          }
+        } else if (diff < 0) {
+          return false;
+        } else {
+          pos = head_.load(std::memory_order_relaxed);
+        }
+      }
+    } else {
+      pos = head_.load(std::memory_order_relaxed);
+      cell = &cells_[pos & mask_];
+      if (cell->seq.load(std::memory_order_acquire) != pos + 1) return false;
+      head_.store(pos + 1, std::memory_order_relaxed);
+    }
+    release_(cell, pos, out);
+    return true;
+  }
+  // Claims up to n consecutive full slots with one CAS (or none, in MPSC
+  // mode) and moves their elements to out. Returns how many were popped.
+  template <class OutputIt>
+  size_type try_pop_n(OutputIt out, size_type n) {
+    size_type pos = head_.load(std::memory_order_relaxed);
+    size_type count;
+    for (;;) {
+      count = 0;
+      while (count < n && count < capacity_ &&
+             cells_[(pos + count) & mask_].seq.load(
+                 std::memory_order_acquire) == pos + count + 1) {
+        count++;
+      }
+      if (!MultiConsumer) {
+        head_.store(pos + count, std::memory_order_relaxed);
+        break;
+      }
+      if (count == 0) {
+        size_type seq = cells_[pos & mask_].seq.load(std::memory_order_acquire);
+        if (static_cast<std::ptrdiff_t>(seq - (pos + 1)) < 0) return 0;
+        pos = head_.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (head_.compare_exchange_weak(pos, pos + count,
+                                      std::memory_order_relaxed)) {
+        break;
+      }
+    }
+    for (size_type i = 0; i < count; i++, ++out) {
+      release_(&cells_[(pos + i) & mask_], pos + i, *out);
+    }
+    return count;
+  }
+
+  // CAPACITY
+  // A snapshot; exact only while no other thread is pushing or popping.
+  size_type size() const {
+    size_type head = head_.load(std::memory_order_acquire);
+    size_type tail = tail_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+  bool empty() const { return size() == 0; }
+  size_type capacity() const { return capacity_; }
+
+ private:
+  static constexpr size_t cache_line_ = 64;
+
+  template <class Out>
+  void release_(cell_* cell, size_type pos, Out& out) {
+    out = std::move(*cell->value());
+    cell->value()->~T();
+    cell->seq.store(pos + capacity_, std::memory_order_release);
+  }
+
+  alignas(cache_line_) std::atomic<size_type> head_;
+  alignas(cache_line_) std::atomic<size_type> tail_;
+  alignas(cache_line_) cell_* cells_;
+  size_type capacity_;
+  size_type mask_;
+  cell_allocator alloc_;
+};
+
+// mpmc_queue for any number of producers and a single consumer.
+template <class T, class Allocator = std::allocator<T>>
+using mpsc_queue = mpmc_queue<T, false, Allocator>;
+
+}  // namespace s21
+
+#endif  // SRC_MPMC_QUEUE
@@ -0,0 +1,130 @@
+// Fan-out through mpmc_queue against s21::queue behind a mutex, sweeping 1
+// to 64 producers and consumers. The op column names the thread counts;
+// ns_per_op is wall time per element moved.
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "mpmc_queue.h"
+#include "queue.h"
+
+namespace {
+
+using namespace s21::bench;
+
+const size_t kCapacity = 1024;
+const size_t kBatch = 16;
+const int kMaxThreads = 64;
+
+template <class Queue>
+struct lock_free_channel {
+  Queue q{kCapacity};
+  size_t push(const int* first, size_t) { return q.try_push(*first) ? 1 : 0; }
+  size_t pop(int* out, size_t) { return q.try_pop(*out) ? 1 : 0; }
+};
+
+template <class Queue>
+struct batch_channel {
+  Queue q{kCapacity};
+  size_t push(const int* first, size_t n) {
+    return q.try_push_n(first, std::min(n, kBatch));
+  }
+  size_t pop(int* out, size_t n) {
+    return q.try_pop_n(out, std::min(n, kBatch));
+  }
+};
+
+struct locked_channel {
+  s21::queue<int> q;
+  std::mutex m;
+  size_t push(const int* first, size_t) {
+    std::lock_guard<std::mutex> lock(m);
+    q.push(*first);
+    return 1;
+  }
+  size_t pop(int* out, size_t) {
+    std::lock_guard<std::mutex> lock(m);
+    if (q.empty()) return 0;
+    *out = q.front();
+    q.pop();
+    return 1;
+  }
+};
+
+// Producer p pushes its share of keys, consumer c pops its share of n.
+template <class C>
+void run_threads(const char* impl, const std::vector<int>& keys,
+                 int producers, int consumers) {
+  size_t n = keys.size();
+  std::string op =
+      "p" + std::to_string(producers) + "_c" + std::to_string(consumers);
+  auto share = [](size_t total, int parts, int i) {
+    return total / parts + (static_cast<size_t>(i) < total % parts ? 1 : 0);
+  };
+  measure(
+      "mpmc_queue", impl, op.c_str(), "int", n, n,
+      [] { return std::make_unique<C>(); },
+      [&](std::unique_ptr<C>& c) {
+        std::atomic<std::uint64_t> sum(0);
+        std::vector<std::thread> threads;
+        size_t begin = 0;
+        for (int p = 0; p < producers; p++) {
+          size_t count = share(n, producers, p);
+          threads.emplace_back([&c, &keys, begin, count] {
+            for (size_t i = begin; i < begin + count;) {
+              size_t pushed = c->push(keys.data() + i, begin + count - i);
+              if (pushed == 0) std::this_thread::yield();
+              i += pushed;
+            }
+          });
+          begin += count;
+        }
+        for (int k = 0; k < consumers; k++) {
+          size_t count = share(n, consumers, k);
+          threads.emplace_back([&c, &sum, count] {
+            int batch[kBatch];
+            std::uint64_t local = 0;
+            for (size_t i = 0; i < count;) {
+              size_t got = c->pop(batch, std::min(kBatch, count - i));
+              if (got == 0) std::this_thread::yield();
+              for (size_t j = 0; j < got; j++) {
+                local += batch[j];
+              }
+              i += got;
+            }
+            sum += local;
+          });
+        }
+        for (auto& i : threads) {
+          i.join();
+        }
+        keep(sum.load());
+      });
+}
+
+void run() {
+  for (size_t n : sizes()) {
+    auto keys = shuffled_keys<int>(n);
+    for (int t = 1; t <= kMaxThreads; t *= 2) {
+      run_threads<lock_free_channel<s21::mpmc_queue<int>>>("s21", keys, t, t);
+      run_threads<batch_channel<s21::mpmc_queue<int>>>("s21_batch", keys, t,
+                                                       t);
+      run_threads<locked_channel>("queue+mutex", keys, t, t);
+    }
+    for (int t = 2; t <= kMaxThreads; t *= 2) {
+      run_threads<lock_free_channel<s21::mpsc_queue<int>>>("s21_mpsc", keys,
+                                                           t, 1);
+      run_threads<lock_free_channel<s21::mpmc_queue<int>>>("s21", keys, t, 1);
+      run_threads<locked_channel>("queue+mutex", keys, t, 1);
+    }
+  }
+}
+
+registrar reg("mpmc_queue", run);
+
+}  // namespace
@@ -0,0 +1,119 @@
+#include "mpmc_queue.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+class MpmcQueueTest : public ::testing::Test {};
+
+TEST(MpmcQueueTest, SingleThread) {
+  s21::mpmc_queue<std::string> A(3);
+  EXPECT_EQ(A.capacity(), 4);
+  std::string out;
+  EXPECT_FALSE(A.try_pop(out));
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < 4; i++) {
+      EXPECT_TRUE(A.try_push(std::to_string(i)));
+    }
+    EXPECT_FALSE(A.try_push("full"));
+    EXPECT_EQ(A.size(), 4);
+    for (int i = 0; i < 4; i++) {
+      EXPECT_TRUE(A.try_pop(out));
+      EXPECT_EQ(out, std::to_string(i));
+    }
+    EXPECT_TRUE(A.empty());
+  }
+  EXPECT_TRUE(A.try_emplace(2, 'y'));
+  // Left in the queue for the destructor.
+  A.try_push("left over, long enough to live on the heap");
+  EXPECT_TRUE(A.try_pop(out));
+  EXPECT_EQ(out, "yy");
+}
+
+TEST(MpmcQueueTest, Batch) {
+  s21::mpmc_queue<int> A(8);
+  s21::mpsc_queue<int> B(8);
+  std::vector<int> in = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}, out(10);
+  EXPECT_EQ(A.try_push_n(in.begin(), 10), 8);
+  EXPECT_EQ(A.try_pop_n(out.begin(), 3), 3);
+  EXPECT_EQ(A.try_push_n(in.begin() + 8, 2), 2);
+  EXPECT_EQ(A.try_pop_n(out.begin() + 3, 20), 7);
+  EXPECT_EQ(A.try_pop_n(out.begin(), 1), 0);
+  EXPECT_EQ(out, in);
+  EXPECT_EQ(B.try_push_n(in.begin(), 5), 5);
+  EXPECT_EQ(B.try_pop_n(out.begin(), 10), 5);
+  EXPECT_EQ(B.try_pop_n(out.begin(), 10), 0);
+}
+
+// Every producer pushes its own range; every value must come out exactly
+// once, and values of one producer in order.
+template <class Queue>
+void stress(int producers, int consumers) {
+  Queue q(64);
+  const int per_producer = 20000;
+  std::vector<std::atomic<int>> seen(producers * per_producer);
+  std::atomic<int> popped(0), disorder(0);
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; p++) {
+    threads.emplace_back([&, p] {
+      int base = p * per_producer;
+      for (int i = 0; i < per_producer;) {
+        if (i % 2 == 0) {
+          if (q.try_push(base + i)) {
+            i++;
+            continue;
+          }
+        } else {
+          int batch[3] = {base + i, base + i + 1, base + i + 2};
+          int n = std::min(3, per_producer - i);
+          int pushed = static_cast<int>(q.try_push_n(batch, n));
+          i += pushed;
+          if (pushed > 0) continue;
+        }
+        std::this_thread::yield();
+      }
+    });
+  }
+  const int total = producers * per_producer;
+  for (int c = 0; c < consumers; c++) {
+    threads.emplace_back([&] {
+      std::vector<int> last(producers, -1);
+      int batch[4];
+      while (popped.load() < total) {
+        size_t got = q.try_pop_n(batch, 4);
+        if (got == 0) {
+          std::this_thread::yield();
+          continue;
+        }
+        for (size_t j = 0; j < got; j++) {
+          int v = batch[j];
+          seen[v]++;
+          if (v <= last[v / per_producer]) disorder++;
+          last[v / per_producer] = v;
+        }
+        popped += static_cast<int>(got);
+      }
+    });
+  }
+  for (auto& i : threads) {
+    i.join();
+  }
+  int wrong = 0;
+  for (auto& i : seen) {
+    wrong += i.load() != 1;
+  }
+  EXPECT_EQ(wrong, 0);
+  EXPECT_EQ(disorder.load(), 0);
+  EXPECT_TRUE(q.empty());
+}
+
+TEST(MpmcQueueTest, ManyProducersManyConsumers) {
+  stress<s21::mpmc_queue<int>>(4, 4);
+}
+
+TEST(MpmcQueueTest, ManyProducersOneConsumer) {
+  stress<s21::mpsc_queue<int>>(4, 1);
+}
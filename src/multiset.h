@@ -6,18 +6,53 @@
 
 namespace s21 {
 
-template <class K>
-class multiset : public btree<K, K, s21::TreeNode<K>, true> {
-  using iterator = iterator_btree<K, K, TreeNode<K>, true>;
+template <class K, class Compare = std::less<K>,
+          class Allocator = slab_allocator<K>, class Engine = rb_tree_engine>
+class multiset
+    : public Engine::template type<K, K, s21::TreeNode<K, Engine::ranked>,
+                                   true, Compare, Allocator> {
+  using base = typename Engine::template type<
+      K, K, s21::TreeNode<K, Engine::ranked>, true, Compare, Allocator>;
+  using iterator = typename base::iterator;
 
-  using btree<K, K, TreeNode<K>, true>::btree;
+  using base::base;
   using value_type = K;
 
  public:
   iterator insert(const value_type &key) {
     return (this->insert_iter(key)).first;
   }
+  iterator insert(value_type &&key) {
+    return this->insert_iter(std::move(key)).first;
+  }
+  template <class InputIt>
+  void insert(InputIt first, InputIt last) {
+    this->insert_range_(first, last);
+  }
 };
 
+// Non-destructive set algebra, see btree::set_union.
+template <class K, class C, class A, class E>
+multiset<K, C, A, E> set_union(const multiset<K, C, A, E>& a,
+                               const multiset<K, C, A, E>& b) {
+  multiset<K, C, A, E> ret(a);
+  ret.set_union(b);
+  return ret;
+}
+template <class K, class C, class A, class E>
+multiset<K, C, A, E> set_intersection(const multiset<K, C, A, E>& a,
+                                      const multiset<K, C, A, E>& b) {
+  multiset<K, C, A, E> ret(a);
+  ret.set_intersection(b);
+  return ret;
+}
+template <class K, class C, class A, class E>
+multiset<K, C, A, E> set_difference(const multiset<K, C, A, E>& a,
+                                    const multiset<K, C, A, E>& b) {
+  multiset<K, C, A, E> ret(a);
+  ret.set_difference(b);
+  return ret;
+}
+
 }  // namespace s21
 #endif
\ No newline at end of file
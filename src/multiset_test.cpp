@@ -1,8 +1,10 @@
 #include "multiset.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <ctime>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 // Copyright 2022 nolanhea
@@ -246,6 +248,72 @@ TEST(MultisetTest, bounds) {
   EXPECT_EQ(*j, 3);
   EXPECT_EQ(*(++j), 4);
 }
+TEST(MultisetTest, RangeConstructor) {
+  std::vector<int> values = {1, 1, 2, 3, 3, 3, 7};
+  multiset<int> A(values.begin(), values.end());
+  EXPECT_EQ(A.size(), values.size());
+  EXPECT_EQ(A.count(3), 3);
+  std::vector<int> unsorted = {7, 3, 1, 3, 2, 1, 3};
+  A.assign(unsorted.begin(), unsorted.end());
+  auto j = values.begin();
+  for (auto i : A) {
+    EXPECT_EQ(i, *j);
+    j++;
+  }
+}
+
+TEST(MultisetTest, SetAlgebra) {
+  std::vector<int> a, b;
+  srand(7);
+  for (int i = 0; i < 30000; i++) {
+    a.push_back(rand() % 3000);
+    b.push_back(rand() % 3000);
+  }
+  multiset<int> A(a.begin(), a.end());
+  multiset<int> B(b.begin(), b.end());
+  std::sort(a.begin(), a.end());
+  std::sort(b.begin(), b.end());
+  std::vector<int> expected;
+  std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                 std::back_inserter(expected));
+  multiset<int> U = s21::set_union(A, B);
+  EXPECT_EQ(U.size(), expected.size());
+  EXPECT_TRUE(std::equal(U.begin(), U.end(), expected.begin()));
+  expected.clear();
+  std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                        std::back_inserter(expected));
+  multiset<int> I = s21::set_intersection(A, B);
+  EXPECT_EQ(I.size(), expected.size());
+  EXPECT_TRUE(std::equal(I.begin(), I.end(), expected.begin()));
+  expected.clear();
+  std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                      std::back_inserter(expected));
+  A.set_difference(std::move(B));
+  EXPECT_EQ(A.size(), expected.size());
+  EXPECT_TRUE(std::equal(A.begin(), A.end(), expected.begin()));
+}
+
+TEST(MultisetTest, OrderStatistics) {
+  s21::multiset<int, std::less<int>, s21::slab_allocator<int>,
+                s21::ranked_rb_tree_engine>
+      A = {1, 2, 2, 2, 3, 5, 5, 8};
+  EXPECT_EQ(A.rank(2), 1);
+  EXPECT_EQ(A.rank(3), 4);
+  EXPECT_EQ(A.count_range(2, 6), 6);
+  EXPECT_EQ(*A.nth(6), 5);
+  A.erase(A.find(2));
+  EXPECT_EQ(A.rank(3), 3);
+  EXPECT_EQ(*A.nth(3), 3);
+  EXPECT_EQ(A.distance(A.begin(), A.find(8)), 6);
+}
+
+TEST(MultisetTest, ForEachRange) {
+  multiset<int> A = {1, 2, 2, 2, 3, 5, 5, 8};
+  std::vector<int> visited;
+  A.for_each_range(2, 5, [&visited](int v) { visited.push_back(v); });
+  std::vector<int> expected = {2, 2, 2, 3};
+  EXPECT_EQ(visited, expected);
+}
 //
 // int main(int argc, char **argv) {
 //  ::testing::InitGoogleTest(&argc, argv);
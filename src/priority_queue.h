@@ -0,0 +1,363 @@
+#ifndef SRC_PRIORITY_QUEUE
+#define SRC_PRIORITY_QUEUE
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "vector.h"
+
+namespace s21 {
+
+// Implicit d-ary heap kept in a random access sequence with operator[],
+// push_back(), emplace_back() and pop_back(): s21::vector (the default),
+// s21::small_vector or s21::deque. As with std::priority_queue, top() is
+// the element that compares greatest under Compare, so std::greater gives a
+// min-heap.
+//
+// Each node has Arity children. A wider heap is shallower, so pushes climb
+// fewer levels, while a pop compares Arity children per level. While the
+// heap fits in cache a binary heap pops fastest; beyond that the cache
+// misses per level dominate, and the default of four, whose children share
+// a cache line, pops about a fifth faster.
+template <class T, class Container = vector<T>, class Compare = std::less<T>,
+          size_t Arity = 4>
+class priority_queue {
+  static_assert(Arity >= 2, "a heap node needs at least two children");
+
+ public:
+  using container_type = Container;
+  using value_compare = Compare;
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = size_t;
+
+ protected:
+  Container c_;
+  Compare comp_;
+
+ public:
+  // CONSTRUCTORS
+  priority_queue() : c_(), comp_() {}
+  explicit priority_queue(const Compare& comp) : c_(), comp_(comp) {}
+  // Takes over c and heapifies it in O(n).
+  priority_queue(const Compare& comp, const Container& c)
+      : c_(c), comp_(comp) {
+    make_heap_();
+  }
+  priority_queue(const Compare& comp, Container&& c)
+      : c_(std::move(c)), comp_(comp) {
+    make_heap_();
+  }
+  template <class InputIt>
+  priority_queue(InputIt first, InputIt last, const Compare& comp = Compare())
+      : c_(), comp_(comp) {
+    for (; first != last; ++first) {
+      c_.push_back(*first);
+    }
+    make_heap_();
+  }
+  priority_queue(std::initializer_list<value_type> const& items)
+      : priority_queue(items.begin(), items.end()) {}
+
+  // ELEMENT ACCESS
+  const_reference top() const { return c_[0]; }
+
+  // CAPACITY
+  [[nodiscard]] bool empty() const { return c_.empty(); }
+  [[nodiscard]] size_type size() const { return c_.size(); }
+
+  // MODIFIERS
+  void push(const_reference value) { emplace(value); }
+  void push(value_type&& value) { emplace(std::move(value)); }
+  template <class... Args>
+  void emplace(Args&&... args) {
+    c_.emplace_back(std::forward<Args>(args)...);
+    sift_up_(c_.size() - 1);
+  }
+  // Pushes every element of range. A batch at least as large as the heap is
+  // cheaper to heapify from scratch in O(n) than to sift up one element at a
+  // time.
+  template <class Range>
+  void push_range(const Range& range) {
+    size_type old = c_.size();
+    for (const auto& i : range) {
+      c_.push_back(i);
+    }
+    if (c_.size() - old >= old) {
+      make_heap_();
+    } else {
+      for (size_type i = old; i < c_.size(); i++) {
+        sift_up_(i);
+      }
+    }
+  }
+  void pop() {
+    if (c_.empty()) return;
+    if (c_.size() > 1) {
+      T last = std::move(c_[c_.size() - 1]);
+      c_.pop_back();
+      size_type i = hole_to_leaf_(0);
+      c_[i] = std::move(last);
+      sift_up_(i);
+    } else {
+      c_.pop_back();
+    }
+  }
+  // Moves the top element into out and pops it, so the caller gets it
+  // without the copy that top() followed by pop() would make.
+  void pop_into(reference out) {
+    out = std::move(c_[0]);
+    pop();
+  }
+  void swap(priority_queue& other) noexcept(
+      noexcept(std::declval<Container&>().swap(std::declval<Container&>())) &&
+      std::is_nothrow_swappable<Compare>::value) {
+    c_.swap(other.c_);
+    std::swap(comp_, other.comp_);
+  }
+
+ private:
+  // HELPER FUNCTIONS
+  static size_type parent_(size_type i) { return (i - 1) / Arity; }
+  static size_type first_child_(size_type i) { return i * Arity + 1; }
+
+  // Both sifts carry the moving element in a local and shift the others
+  // into the hole it leaves, one move per level instead of a swap.
+  void sift_up_(size_type i) {
+    if (i == 0 || !comp_(c_[parent_(i)], c_[i])) return;
+    T value = std::move(c_[i]);
+    do {
+      size_type p = parent_(i);
+      c_[i] = std::move(c_[p]);
+      i = p;
+    } while (i > 0 && comp_(c_[parent_(i)], value));
+    c_[i] = std::move(value);
+  }
+  // Places value at the hole i, moving the greatest child up while it
+  // compares greater than value.
+  void sift_down_(size_type i, T&& value) {
+    size_type n = c_.size();
+    for (;;) {
+      size_type first = first_child_(i);
+      if (first >= n) break;
+      size_type last = first + Arity < n ? first + Arity : n;
+      size_type best = first;
+      for (size_type k = first + 1; k < last; k++) {
+        if (comp_(c_[best], c_[k])) best = k;
+      }
+      if (!comp_(value, c_[best])) break;
+      c_[i] = std::move(c_[best]);
+      i = best;
+    }
+    c_[i] = std::move(value);
+  }
+  // Moves the greatest child into the hole at i, level by level, until the
+  // hole reaches a leaf, and returns where it ended up. The element that
+  // refills the hole came from the bottom and usually belongs near it, so
+  // sifting it up from there takes fewer comparisons than sift_down_, and
+  // none of the branches depends on it.
+  size_type hole_to_leaf_(size_type i) {
+    size_type n = c_.size();
+    // Nodes with all Arity children, so the inner loop has a fixed count.
+    size_type first = first_child_(i);
+    while (first + Arity <= n) {
+      size_type best = first;
+      for (size_type k = 1; k < Arity; k++) {
+        if (comp_(c_[best], c_[first + k])) best = first + k;
+      }
+      c_[i] = std::move(c_[best]);
+      i = best;
+      first = first_child_(i);
+    }
+    if (first < n) {
+      size_type best = first;
+      for (size_type k = first + 1; k < n; k++) {
+        if (comp_(c_[best], c_[k])) best = k;
+      }
+      c_[i] = std::move(c_[best]);
+      i = best;
+    }
+    return i;
+  }
+  // Floyd's bottom-up construction: O(n) comparisons in total.
+  void make_heap_() {
+    size_type n = c_.size();
+    if (n < 2) return;
+    for (size_type i = parent_(n - 1) + 1; i-- > 0;) {
+      T value = std::move(c_[i]);
+      sift_down_(i, std::move(value));
+    }
+  }
+};
+
+// d-ary heap whose elements are addressed by the handle push() returns, so
+// a queued element can be re-prioritised or removed in O(log n) instead of
+// being pushed again as a duplicate: the decrease_key step of Dijkstra's
+// algorithm, or rescheduling a timer. The heap orders handles; the values
+// stay put in a slot per handle. Popping or erasing an element destroys its
+// value right away and frees the handle for reuse.
+template <class T, class Compare = std::less<T>, size_t Arity = 4>
+class indexed_priority_queue {
+  static_assert(Arity >= 2, "a heap node needs at least two children");
+
+ public:
+  using value_compare = Compare;
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = size_t;
+  using handle = size_t;
+
+ private:
+  static constexpr size_type npos_ = std::numeric_limits<size_type>::max();
+
+  vector<handle> heap_;
+  // Empty for free handles.
+  vector<std::optional<T>> values_;
+  // Heap position of every handle, npos_ for free ones.
+  vector<size_type> pos_;
+  vector<handle> free_;
+  Compare comp_;
+
+ public:
+  // CONSTRUCTORS
+  indexed_priority_queue() : comp_() {}
+  explicit indexed_priority_queue(const Compare& comp) : comp_(comp) {}
+
+  // ELEMENT ACCESS
+  const_reference top() const { return *values_[heap_[0]]; }
+  handle top_handle() const { return heap_[0]; }
+  const_reference value(handle h) const { return *values_[h]; }
+  // Whether h names an element that is still queued.
+  bool contains(handle h) const { return h < pos_.size() && pos_[h] != npos_; }
+
+  // CAPACITY
+  [[nodiscard]] bool empty() const { return heap_.empty(); }
+  [[nodiscard]] size_type size() const { return heap_.size(); }
+
+  // MODIFIERS
+  handle push(const_reference value) { return emplace(value); }
+  handle push(value_type&& value) { return emplace(std::move(value)); }
+  template <class... Args>
+  handle emplace(Args&&... args) {
+    handle h;
+    if (free_.empty()) {
+      h = values_.size();
+      values_.emplace_back(std::in_place, std::forward<Args>(args)...);
+      pos_.push_back(npos_);
+    } else {
+      h = free_.back();
+      free_.pop_back();
+      values_[h].emplace(std::forward<Args>(args)...);
+    }
+    heap_.push_back(h);
+    pos_[h] = heap_.size() - 1;
+    sift_up_(heap_.size() - 1);
+    return h;
+  }
+  void pop() {
+    if (!heap_.empty()) erase(heap_[0]);
+  }
+  void pop_into(reference out) {
+    out = std::move(*values_[heap_[0]]);
+    pop();
+  }
+  // Gives the queued h a value that compares no less than its current one
+  // under Compare, so it can only move towards the top. With std::greater,
+  // as in Dijkstra's algorithm, that is a smaller key.
+  void decrease_key(handle h, const_reference value) {
+    *values_[h] = value;
+    sift_up_(pos_[h]);
+  }
+  // Gives the queued h any new value and restores the heap in either
+  // direction.
+  void update(handle h, const_reference value) {
+    *values_[h] = value;
+    size_type i = pos_[h];
+    if (i > 0 && less_(heap_[parent_(i)], h)) {
+      sift_up_(i);
+    } else {
+      sift_down_(i);
+    }
+  }
+  // Removes the queued h, destroys its value and frees its handle for reuse.
+  void erase(handle h) {
+    size_type i = pos_[h];
+    handle last = heap_[heap_.size() - 1];
+    heap_.pop_back();
+    pos_[h] = npos_;
+    values_[h].reset();
+    free_.push_back(h);
+    if (last == h) return;
+    heap_[i] = last;
+    pos_[last] = i;
+    if (i > 0 && less_(heap_[parent_(i)], last)) {
+      sift_up_(i);
+    } else {
+      sift_down_(i);
+    }
+  }
+  void clear() {
+    heap_.clear();
+    values_.clear();
+    pos_.clear();
+    free_.clear();
+  }
+  void swap(indexed_priority_queue& other) noexcept(
+      std::is_nothrow_swappable<Compare>::value) {
+    heap_.swap(other.heap_);
+    values_.swap(other.values_);
+    pos_.swap(other.pos_);
+    free_.swap(other.free_);
+    std::swap(comp_, other.comp_);
+  }
+
+ private:
+  // HELPER FUNCTIONS
+  static size_type parent_(size_type i) { return (i - 1) / Arity; }
+  static size_type first_child_(size_type i) { return i * Arity + 1; }
+
+  bool less_(handle a, handle b) const {
+    return comp_(*values_[a], *values_[b]);
+  }
+  void place_(size_type i, handle h) {
+    heap_[i] = h;
+    pos_[h] = i;
+  }
+  void sift_up_(size_type i) {
+    handle h = heap_[i];
+    while (i > 0 && less_(heap_[parent_(i)], h)) {
+      size_type p = parent_(i);
+      place_(i, heap_[p]);
+      i = p;
+    }
+    place_(i, h);
+  }
+  void sift_down_(size_type i) {
+    handle h = heap_[i];
+    size_type n = heap_.size();
+    for (;;) {
+      size_type first = first_child_(i);
+      if (first >= n) break;
+      size_type last = first + Arity < n ? first + Arity : n;
+      size_type best = first;
+      for (size_type k = first + 1; k < last; k++) {
+        if (less_(heap_[best], heap_[k])) best = k;
+      }
+      if (!less_(h, heap_[best])) break;
+      place_(i, heap_[best]);
+      i = best;
+    }
+    place_(i, h);
+  }
+};
+
+}  // namespace s21
+
+#endif  // SRC_PRIORITY_QUEUE
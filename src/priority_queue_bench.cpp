@@ -0,0 +1,110 @@
+// priority_queue at arity 2, 4 and 8 against std::priority_queue and the
+// s21::multiset that schedulers used for ordering before. push_pop replaces
+// the top of a full queue n times, as a timer wheel does.
+#include <memory>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "multiset.h"
+#include "priority_queue.h"
+
+namespace {
+
+using namespace s21::bench;
+
+template <class T>
+struct multiset_queue {
+  s21::multiset<T> s;
+  void push(const T& value) { s.insert(value); }
+  const T& top() const { return *s.begin(); }
+  void pop() { s.erase(s.begin()); }
+  size_t size() const { return s.size(); }
+};
+
+template <class Q, class T>
+std::unique_ptr<Q> filled(const std::vector<T>& keys) {
+  auto ret = std::make_unique<Q>();
+  for (auto& i : keys) {
+    ret->push(i);
+  }
+  return ret;
+}
+
+template <class Q, class T>
+void run_queue(const char* impl, size_t n) {
+  const char* key = key_name<T>();
+  auto keys = shuffled_keys<T>(n);
+  measure(
+      "priority_queue", impl, "push", key, n, n,
+      [] { return std::make_unique<Q>(); },
+      [&](std::unique_ptr<Q>& q) {
+        for (auto& i : keys) {
+          q->push(i);
+        }
+        keep(q->size());
+      });
+  measure(
+      "priority_queue", impl, "pop", key, n, n,
+      [&] { return filled<Q>(keys); },
+      [&](std::unique_ptr<Q>& q) {
+        std::uint64_t sum = 0;
+        for (size_t i = 0; i < n; i++) {
+          sum += checksum(q->top());
+          q->pop();
+        }
+        keep(sum);
+      });
+  measure(
+      "priority_queue", impl, "push_pop", key, n, n,
+      [&] { return filled<Q>(keys); },
+      [&](std::unique_ptr<Q>& q) {
+        std::uint64_t sum = 0;
+        for (auto& i : keys) {
+          sum += checksum(q->top());
+          q->pop();
+          q->push(i);
+        }
+        keep(sum);
+      });
+}
+
+template <class Q, class T>
+void run_heapify(const char* impl, size_t n) {
+  auto keys = shuffled_keys<T>(n);
+  measure(
+      "priority_queue", impl, "heapify", key_name<T>(), n, n,
+      [] { return 0; },
+      [&](int) {
+        Q q(keys.begin(), keys.end());
+        keep(q.size());
+      });
+}
+
+template <class T, size_t Arity>
+using heap = s21::priority_queue<T, s21::vector<T>, std::less<T>, Arity>;
+
+template <class T>
+void run_key() {
+  for (size_t n : sizes()) {
+    run_queue<heap<T, 2>, T>("s21_2ary", n);
+    run_queue<heap<T, 4>, T>("s21_4ary", n);
+    run_queue<heap<T, 8>, T>("s21_8ary", n);
+    run_queue<std::priority_queue<T>, T>("std", n);
+    run_queue<multiset_queue<T>, T>("s21_multiset", n);
+    run_heapify<heap<T, 2>, T>("s21_2ary", n);
+    run_heapify<heap<T, 4>, T>("s21_4ary", n);
+    run_heapify<heap<T, 8>, T>("s21_8ary", n);
+    run_heapify<std::priority_queue<T>, T>("std", n);
+  }
+}
+
+void run() {
+  run_key<int>();
+  run_key<std::string>();
+}
+
+registrar reg("priority_queue", run);
+
+}  // namespace
@@ -0,0 +1,214 @@
+#include "priority_queue.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+template <size_t Arity>
+void check_against_std() {
+  s21::priority_queue<std::string, s21::vector<std::string>,
+                      std::less<std::string>, Arity>
+      A;
+  std::priority_queue<std::string> B;
+  srand(Arity);
+  for (int step = 0; step < 5000; step++) {
+    if (rand() % 3 != 0 || B.empty()) {
+      std::string s = std::to_string(rand() % 1000);
+      A.push(s);
+      B.push(s);
+    } else {
+      std::string out;
+      A.pop_into(out);
+      EXPECT_EQ(out, B.top());
+      B.pop();
+    }
+    ASSERT_EQ(A.size(), B.size());
+    if (!B.empty()) {
+      ASSERT_EQ(A.top(), B.top());
+    }
+  }
+}
+
+}  // namespace
+
+class PriorityQueueTest : public ::testing::Test {};
+
+TEST(PriorityQueueTest, MatchesStdAtEveryArity) {
+  check_against_std<2>();
+  check_against_std<3>();
+  check_against_std<4>();
+  check_against_std<8>();
+}
+
+TEST(PriorityQueueTest, HeapifyAndPushRange) {
+  std::vector<int> v;
+  for (int i = 0; i < 1000; i++) {
+    v.push_back((i * 7919) % 1000);
+  }
+  s21::priority_queue<int, s21::vector<int>, std::greater<int>> A(
+      v.begin(), v.end(), std::greater<int>());
+  EXPECT_EQ(A.size(), 1000U);
+  for (int i = 0; i < 500; i++) {
+    EXPECT_EQ(A.top(), i);
+    A.pop();
+  }
+  // Small batch: sifted up one by one. Large batch: heapified again.
+  A.push_range(std::vector<int>(v.begin(), v.begin() + 10));
+  A.push_range(v);
+  std::vector<int> expected(v.begin(), v.begin() + 10);
+  expected.insert(expected.end(), v.begin(), v.end());
+  for (int i = 500; i < 1000; i++) {
+    expected.push_back(i);
+  }
+  std::sort(expected.begin(), expected.end());
+  for (int i : expected) {
+    EXPECT_EQ(A.top(), i);
+    A.pop();
+  }
+  EXPECT_TRUE(A.empty());
+  A.pop();
+  EXPECT_TRUE(A.empty());
+
+  using octal_heap =
+      s21::priority_queue<int, s21::vector<int>, std::less<int>, 8>;
+  s21::vector<int> c{3, 1, 4, 1, 5, 9, 2, 6};
+  octal_heap B(std::less<int>(), std::move(c));
+  EXPECT_EQ(B.top(), 9);
+  octal_heap C{2, 7, 1};
+  EXPECT_EQ(C.top(), 7);
+  B.swap(C);
+  EXPECT_EQ(B.size(), 3U);
+  EXPECT_EQ(C.top(), 9);
+}
+
+TEST(PriorityQueueTest, PopIntoMovesOut) {
+  auto by_value = [](const std::unique_ptr<int>& a,
+                     const std::unique_ptr<int>& b) { return *a < *b; };
+  s21::priority_queue<std::unique_ptr<int>, s21::vector<std::unique_ptr<int>>,
+                      decltype(by_value), 2>
+      A(by_value);
+  for (int i : {5, 3, 8, 1}) {
+    A.push(std::make_unique<int>(i));
+  }
+  A.emplace(new int(6));
+  std::unique_ptr<int> out;
+  for (int i : {8, 6, 5, 3, 1}) {
+    A.pop_into(out);
+    EXPECT_EQ(*out, i);
+  }
+  EXPECT_TRUE(A.empty());
+}
+
+TEST(PriorityQueueTest, IndexedUpdateAndErase) {
+  s21::indexed_priority_queue<int> A;
+  std::vector<size_t> h;
+  for (int i = 0; i < 100; i++) {
+    h.push_back(A.push(i));
+  }
+  EXPECT_EQ(A.top(), 99);
+  A.decrease_key(h[10], 200);
+  EXPECT_EQ(A.top_handle(), h[10]);
+  A.update(h[10], -1);
+  A.update(h[20], 150);
+  EXPECT_EQ(A.top(), 150);
+  A.erase(h[20]);
+  EXPECT_FALSE(A.contains(h[20]));
+  EXPECT_EQ(A.top(), 99);
+  A.erase(h[99]);
+  A.erase(h[0]);
+  EXPECT_EQ(A.size(), 97U);
+  // Freed handles are handed out again.
+  size_t reused = A.push(1000);
+  EXPECT_TRUE(reused == h[0] || reused == h[20] || reused == h[99]);
+  EXPECT_EQ(A.value(reused), 1000);
+  int out;
+  A.pop_into(out);
+  EXPECT_EQ(out, 1000);
+  std::vector<int> rest;
+  while (!A.empty()) {
+    rest.push_back(A.top());
+    A.pop();
+  }
+  std::vector<int> expected;
+  for (int i = 98; i >= 1; i--) {
+    if (i != 10 && i != 20) expected.push_back(i);
+  }
+  expected.push_back(-1);
+  EXPECT_EQ(rest, expected);
+}
+
+TEST(PriorityQueueTest, IndexedReleasesPoppedValues) {
+  using timer = std::pair<int, std::shared_ptr<int>>;
+  s21::indexed_priority_queue<timer, std::greater<timer>> A;
+  auto callback = std::make_shared<int>(0);
+  size_t first = A.push({1, callback});
+  size_t second = A.push({2, callback});
+  A.push({3, callback});
+  EXPECT_EQ(callback.use_count(), 4);
+  A.pop();
+  EXPECT_FALSE(A.contains(first));
+  EXPECT_EQ(callback.use_count(), 3);
+  A.erase(second);
+  EXPECT_EQ(callback.use_count(), 2);
+  timer out;
+  A.pop_into(out);
+  EXPECT_EQ(out.first, 3);
+  EXPECT_EQ(callback.use_count(), 2);
+  EXPECT_TRUE(A.empty());
+  s21::indexed_priority_queue<timer, std::greater<timer>> B;
+  EXPECT_TRUE(noexcept(A.swap(B)));
+}
+
+// Dijkstra with decrease_key against Bellman-Ford on a random graph.
+TEST(PriorityQueueTest, IndexedDijkstra) {
+  const int n = 300;
+  const long inf = 1L << 40;
+  std::vector<std::vector<std::pair<int, long>>> adj(n);
+  srand(5);
+  for (int e = 0; e < 3000; e++) {
+    adj[rand() % n].push_back({rand() % n, rand() % 100 + 1});
+  }
+  std::vector<long> bf(n, inf);
+  bf[0] = 0;
+  for (int round = 0; round < n; round++) {
+    for (int u = 0; u < n; u++) {
+      for (auto& [v, w] : adj[u]) {
+        if (bf[u] + w < bf[v]) bf[v] = bf[u] + w;
+      }
+    }
+  }
+  using entry = std::pair<long, int>;
+  s21::indexed_priority_queue<entry, std::greater<entry>> q;
+  std::vector<long> dist(n, inf);
+  std::vector<size_t> handle(n);
+  std::vector<bool> queued(n, false);
+  dist[0] = 0;
+  handle[0] = q.push({0, 0});
+  queued[0] = true;
+  while (!q.empty()) {
+    entry top;
+    q.pop_into(top);
+    int u = top.second;
+    queued[u] = false;
+    for (auto& [v, w] : adj[u]) {
+      if (dist[u] + w >= dist[v]) continue;
+      dist[v] = dist[u] + w;
+      if (queued[v]) {
+        q.decrease_key(handle[v], {dist[v], v});
+      } else {
+        handle[v] = q.push({dist[v], v});
+        queued[v] = true;
+      }
+    }
+  }
+  EXPECT_EQ(dist, bf);
+}
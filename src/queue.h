@@ -1,139 +1,101 @@
+#ifndef SRC_QUEUE
+#define SRC_QUEUE
+
 #include <cstddef>
-#include <iostream>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
 #include <utility>
 
+#include "deque.h"
+
 namespace s21 {
-template <class T>
-struct QueueNode {
-  QueueNode<T>* next;
-  QueueNode<T>* prev;
-  T key;
-  QueueNode() : next(nullptr), prev(nullptr), T(0) {}
-  QueueNode(T i, QueueNode<T>* p, QueueNode<T>* n) : next(n), prev(p), key(i) {}
-};
-template <class T>
+
+// FIFO adaptor over any sequence with front(), back(), push_back(),
+// emplace_back() and pop_front(): s21::deque (the default), s21::list or
+// s21::ring_buffer. reserve(), shrink_to_fit() and capacity() forward to
+// the container and are only available when it has them.
+template <class T, class Container = deque<T>>
 class queue {
+ public:
+  using container_type = Container;
   using value_type = T;
   using reference = T&;
   using const_reference = const T&;
   using size_type = size_t;
-  using Node = QueueNode<T>;
 
- private:
-  Node* front_;
-  Node* back_;
-  size_t size_;
+ protected:
+  Container c_;
 
  public:
   // CONSTRUCTORS
-  queue() : front_(nullptr), back_(nullptr), size_(0) {}
-
-  queue(std::initializer_list<value_type> const& items)
-      : front_(nullptr), back_(nullptr), size_(0) {
-    for (auto i : items) {
-      this->push(i);
-    }
-  }
-  queue(const queue& q) {
-    front_ = back_ = nullptr;
-    size_ = 0;
-    Node* n = q.front_;
-    while (n != nullptr) {
-      this->push(n->key);
-      n = n->next;
-    }
-  }
-
-  queue(queue&& q) noexcept {
-    front_ = q.front_;
-    back_ = q.back_;
-    size_ = q.size_;
-    q.front_ = q.back_ = nullptr;
-    q.size_ = 0;
-  }
-
-  ~queue() {
-    while (front_ != nullptr) {
-      this->pop();
-    }
-  }
-  queue& operator=(queue&& q) noexcept {
-    if (front_ != nullptr) {
-      while (front_ != nullptr) {
-        this->pop();
-      }
-    }
-    front_ = q.front_;
-    back_ = q.back_;
-    size_ = q.size_;
-    q.front_ = q.back_ = nullptr;
-    q.size_ = 0;
-    return *this;
-  }
-  queue& operator=(const queue& q) {
-    if (this == q) return *this;
-    if (front_ != nullptr) {
-      while (front_ != nullptr) {
-        this->pop();
-      }
-    }
-    front_ = back_ = nullptr;
-    Node* n = q.front_;
-    while (n != nullptr) {
-      this->push(n->key);
-      n = n->next;
-    }
-    return *this;
+  queue() : c_() {}
+  explicit queue(const Container& c) : c_(c) {}
+  explicit queue(Container&& c) : c_(std::move(c)) {}
+  queue(std::initializer_list<value_type> const& items) : c_() {
+    push_range(items);
   }
 
   // ELEMENT ACCESS
-  const_reference front() { return front_->key; }
-  const_reference back() { return back_->key; }
+  reference front() { return c_.front(); }
+  const_reference front() const { return c_.front(); }
+  reference back() { return c_.back(); }
+  const_reference back() const { return c_.back(); }
 
   // CAPACITY
-  [[nodiscard]] bool empty() const {
-    if (size_ == 0) {
-      return true;
-    }
-    return false;
-  }
-  [[nodiscard]] size_type size() const { return size_; }
+  [[nodiscard]] bool empty() const { return c_.empty(); }
+  [[nodiscard]] size_type size() const { return c_.size(); }
+  size_type capacity() const { return c_.capacity(); }
+  void reserve(size_type n) { c_.reserve(n); }
+  void shrink_to_fit() { c_.shrink_to_fit(); }
 
   // MODIFIERS
-  void push(const_reference value) {
-    size_++;
-    Node* n = new Node(value, back_, nullptr);
-    if (back_ != nullptr) {
-      back_->next = n;
-    } else {
-      front_ = n;
+  void push(const_reference value) { c_.push_back(value); }
+  void push(value_type&& value) { c_.push_back(std::move(value)); }
+
+  // Pushes every element of range in order. Forward ranges reserve room
+  // first when the container can.
+  template <class Range>
+  void push_range(const Range& range) {
+    using std::begin;
+    using std::end;
+    auto first = begin(range);
+    auto last = end(range);
+    using category =
+        typename std::iterator_traits<decltype(first)>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag,
+                                  category>::value) {
+      reserve_(c_, c_.size() + std::distance(first, last), 0);
+    }
+    for (; first != last; ++first) {
+      c_.push_back(*first);
     }
-    back_ = n;
   }
 
   void pop() {
-    if (front_ != nullptr) {
-      size_--;
-      Node* temp = front_;
-      front_ = front_->next;
-      delete temp;
-      if (front_ == nullptr) {
-        back_ = nullptr;
-      }
-    }
+    if (!c_.empty()) c_.pop_front();
   }
 
-  void swap(queue& other) {
-    queue temp = other;
-    other = *this;
-    *this = temp;
-  }
+  void swap(queue& other) noexcept { c_.swap(other.c_); }
 
+  template <class... Args>
+  void emplace(Args&&... args) {
+    c_.emplace_back(std::forward<Args>(args)...);
+  }
   template <class... Args>
   void emplace_back(Args&&... args) {
-    value_type val(args...);
-    this->push(val);
+    c_.emplace_back(std::forward<Args>(args)...);
   }
+
+ private:
+  template <class C>
+  static auto reserve_(C& c, size_type n, int) -> decltype(c.reserve(n)) {
+    c.reserve(n);
+  }
+  template <class C>
+  static void reserve_(C&, size_type, long) {}
 };
 
-}  // namespace s21
\ No newline at end of file
+}  // namespace s21
+
+#endif  // SRC_QUEUE
@@ -0,0 +1,74 @@
+#include <memory>
+#include <queue>
+#include <string>
+
+#include "bench.h"
+#include "queue.h"
+#include "ring_buffer.h"
+
+namespace {
+
+using namespace s21::bench;
+
+template <class S, class T>
+void run_queue(const char* impl, size_t n) {
+  const char* key = key_name<T>();
+  auto keys = shuffled_keys<T>(n);
+  measure(
+      "queue", impl, "push", key, n, n, [] { return std::make_unique<S>(); },
+      [&](std::unique_ptr<S>& s) {
+        for (auto& i : keys) {
+          s->push(i);
+        }
+        keep(s->size());
+      });
+  measure(
+      "queue", impl, "pop", key, n, n,
+      [&] {
+        auto s = std::make_unique<S>();
+        for (auto& i : keys) {
+          s->push(i);
+        }
+        return s;
+      },
+      [&](std::unique_ptr<S>& s) {
+        std::uint64_t sum = 0;
+        for (size_t i = 0; i < n; i++) {
+          sum += checksum(s->front());
+          s->pop();
+        }
+        keep(sum);
+      });
+  // Depth stays at one: a push immediately followed by a pop.
+  measure(
+      "queue", impl, "push_pop", key, n, n,
+      [] { return std::make_unique<S>(); },
+      [&](std::unique_ptr<S>& s) {
+        std::uint64_t sum = 0;
+        for (auto& i : keys) {
+          s->push(i);
+          sum += checksum(s->front());
+          s->pop();
+        }
+        keep(sum);
+      });
+}
+
+template <class T>
+void run_key() {
+  for (size_t n : sizes()) {
+    run_queue<s21::queue<T>, T>("s21", n);
+    run_queue<s21::queue<T, s21::ring_buffer<T>>, T>("s21_ring", n);
+    run_queue<std::queue<T>, T>("std", n);
+  }
+}
+
+void run() {
+  run_key<int>();
+  run_key<std::string>();
+  run_key<blob64>();
+}
+
+registrar reg("queue", run);
+
+}  // namespace
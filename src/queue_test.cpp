@@ -4,9 +4,12 @@
 #include <ctime>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
+#include "list.h"
 #include "queue"
+#include "ring_buffer.h"
 // Copyright 2022 nolanhea
 
 template <class T>
@@ -71,3 +74,82 @@ TEST(S21QueueTest, Emplace) {
     B.pop();
   }
 }
+
+TEST(S21QueueTest, WrapAroundAndGrow) {
+  queue<std::string> A;
+  original_queue<std::string> B;
+  for (int i = 0; i < 1000; i++) {
+    A.push(std::to_string(i));
+    B.push(std::to_string(i));
+    if (i % 3 == 0) {
+      A.pop();
+      B.pop();
+    }
+  }
+  queue<std::string> A_copy;
+  A_copy = A;
+  ASSERT_EQ(A.size(), B.size());
+  while (!B.empty()) {
+    EXPECT_EQ(A.front(), B.front());
+    EXPECT_EQ(A_copy.front(), B.front());
+    EXPECT_EQ(A.back(), B.back());
+    A.pop();
+    A_copy.pop();
+    B.pop();
+  }
+  EXPECT_TRUE(A_copy.empty());
+}
+
+TEST(S21QueueTest, ReserveAndShrink) {
+  s21::queue<int, s21::ring_buffer<int>> A;
+  A.reserve(100);
+  EXPECT_GE(A.capacity(), 100U);
+  std::vector<int> v{1, 2, 3, 4, 5};
+  A.push_range(v);
+  A.push_range(std::vector<int>{6, 7});
+  EXPECT_EQ(A.size(), 7U);
+  A.pop();
+  A.shrink_to_fit();
+  EXPECT_EQ(A.capacity(), 6U);
+  for (int i = 2; i <= 7; i++) {
+    EXPECT_EQ(A.front(), i);
+    A.pop();
+  }
+  A.shrink_to_fit();
+  EXPECT_EQ(A.capacity(), 0U);
+  s21::queue<int, s21::ring_buffer<int>> C{1, 2};
+  A.swap(C);
+  EXPECT_EQ(A.back(), 2);
+  EXPECT_TRUE(C.empty());
+}
+
+TEST(S21QueueTest, PushOwnFrontIntoFullBuffer) {
+  s21::ring_buffer<std::string> A;
+  for (int i = 0; i < 8; i++) {
+    A.push_back(std::string(40, char('a' + i)));
+  }
+  ASSERT_EQ(A.size(), A.capacity());
+  A.push_back(A.front());
+  EXPECT_EQ(A.back(), std::string(40, 'a'));
+  A.emplace_back(A[3]);
+  EXPECT_EQ(A.back(), std::string(40, 'd'));
+  EXPECT_EQ(A.front(), std::string(40, 'a'));
+  EXPECT_EQ(A.size(), 10U);
+}
+
+TEST(S21QueueTest, OtherContainers) {
+  s21::queue<std::string, s21::list<std::string>> A{"a", "b"};
+  s21::queue<std::string, s21::ring_buffer<std::string>> B{"a", "b"};
+  for (int i = 0; i < 100; i++) {
+    A.push(std::to_string(i));
+    B.emplace_back(std::to_string(i));
+    A.pop();
+    B.pop();
+    EXPECT_EQ(A.front(), B.front());
+    EXPECT_EQ(A.back(), B.back());
+  }
+  EXPECT_EQ(A.size(), 2U);
+  EXPECT_EQ(B.size(), 2U);
+  A.front() = "x";
+  EXPECT_EQ(A.front(), "x");
+}
@@ -0,0 +1,122 @@
+#ifndef SRC_RAW_STORAGE
+#define SRC_RAW_STORAGE
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+// Whether a T can be moved to another address by copying its bytes and
+// forgetting the original. Defaults to trivially copyable types; specialize
+// it for types such as unique_ptr that are safe to relocate bitwise too.
+template <class T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+// Element handling shared by s21::vector and s21::small_vector, which keep
+// their elements at the start of a buffer of raw memory: the first size
+// slots hold constructed elements, the rest are uninitialized.
+namespace raw_storage {
+
+template <class T>
+T* allocate(size_t n) {
+  return n != 0 ? std::allocator<T>().allocate(n) : nullptr;
+}
+template <class T>
+void deallocate(T* p, size_t n) {
+  if (p != nullptr) std::allocator<T>().deallocate(p, n);
+}
+template <class T>
+void destroy(T* first, T* last) {
+  if constexpr (!std::is_trivially_destructible<T>::value) {
+    for (; first != last; ++first) {
+      first->~T();
+    }
+  }
+}
+// Copy-constructs n elements from src into raw memory at dest.
+template <class T, class It>
+void copy_construct(It src, size_t n, T* dest) {
+  if constexpr (std::is_trivially_copyable<T>::value &&
+                std::is_pointer<It>::value) {
+    if (n != 0) std::memcpy(dest, src, n * sizeof(T));
+  } else {
+    std::uninitialized_copy_n(src, n, dest);
+  }
+}
+// Moves [first, last) into raw memory at dest and ends the lifetime of the
+// originals: one memcpy for trivially relocatable types, a move and a
+// destructor call per element otherwise.
+template <class T>
+void relocate(T* first, T* last, T* dest) {
+  if constexpr (is_trivially_relocatable<T>::value) {
+    if (first != last) {
+      std::memcpy(static_cast<void*>(dest), static_cast<void*>(first),
+                  (last - first) * sizeof(T));
+    }
+  } else {
+    for (; first != last; ++first, ++dest) {
+      ::new (static_cast<void*>(dest)) T(std::move_if_noexcept(*first));
+      first->~T();
+    }
+  }
+}
+// Destroys the elements from n on, or constructs them with init up to n.
+// size follows every element constructed, so it stays right if init throws.
+// The buffer must have room for n elements.
+template <class T, class Init>
+void resize_with(T* first, size_t& size, size_t n, Init init) {
+  if (n < size) {
+    destroy(first + n, first + size);
+    size = n;
+  }
+  for (; size < n; size++) {
+    init(first + size);
+  }
+}
+// Returns a new buffer of cap slots with an element built from args at
+// index p and the size elements of first relocated around it. The element
+// is built before anything moves, so args may refer into first; if that
+// throws, the new buffer is freed and first is left as it was.
+template <class T, class... Args>
+T* grow_emplace(T* first, size_t size, size_t p, size_t cap,
+                Args&&... args) {
+  T* buffer = allocate<T>(cap);
+  try {
+    ::new (static_cast<void*>(buffer + p)) T(std::forward<Args>(args)...);
+  } catch (...) {
+    deallocate(buffer, cap);
+    throw;
+  }
+  relocate(first, first + p, buffer);
+  relocate(first + p, first + size, buffer + p + 1);
+  return buffer;
+}
+// Builds an element from args at index p of a buffer with room for one
+// more, shifting the ones behind it up by one. args may refer into first.
+template <class T, class... Args>
+void emplace(T* first, size_t size, size_t p, Args&&... args) {
+  if (p == size) {
+    ::new (static_cast<void*>(first + p)) T(std::forward<Args>(args)...);
+    return;
+  }
+  T value(std::forward<Args>(args)...);
+  if constexpr (is_trivially_relocatable<T>::value) {
+    std::memmove(static_cast<void*>(first + p + 1),
+                 static_cast<void*>(first + p), (size - p) * sizeof(T));
+    ::new (static_cast<void*>(first + p)) T(std::move(value));
+  } else {
+    ::new (static_cast<void*>(first + size)) T(std::move(first[size - 1]));
+    std::move_backward(first + p, first + size - 1, first + size);
+    first[p] = std::move(value);
+  }
+}
+
+}  // namespace raw_storage
+}  // namespace s21
+
+#endif  // SRC_RAW_STORAGE
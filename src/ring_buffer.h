@@ -0,0 +1,179 @@
+#ifndef SRC_RING_BUFFER
+#define SRC_RING_BUFFER
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+
+#include "allocator.h"
+
+namespace s21 {
+
+// FIFO storage in one growable circular buffer: head_ indexes the front
+// element and the size_ elements after it, wrapping at capacity_, are live.
+// Pushing into a full buffer doubles it and relocates the elements to the
+// start of the new one, so each push is amortised O(1) and no element costs
+// an allocation of its own. Meant as the container of s21::queue when
+// draining speed matters more than stable element addresses.
+template <class T, class Allocator = std::allocator<T>>
+class ring_buffer {
+  using traits = std::allocator_traits<Allocator>;
+
+ public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+
+ private:
+  T* buffer_;
+  size_type head_;
+  size_type size_;
+  size_type capacity_;
+  Allocator alloc_;
+
+ public:
+  // CONSTRUCTORS
+  ring_buffer() : buffer_(nullptr), head_(0), size_(0), capacity_(0) {}
+  ring_buffer(std::initializer_list<value_type> const& items)
+      : ring_buffer() {
+    reserve(items.size());
+    for (auto& i : items) {
+      push_back(i);
+    }
+  }
+  ring_buffer(const ring_buffer& other) : ring_buffer() {
+    reserve(other.size_);
+    for (size_type i = 0; i < other.size_; i++) {
+      push_back(other[i]);
+    }
+  }
+  ring_buffer(ring_buffer&& other) noexcept
+      : buffer_(other.buffer_),
+        head_(other.head_),
+        size_(other.size_),
+        capacity_(other.capacity_),
+        alloc_(std::move(other.alloc_)) {
+    other.buffer_ = nullptr;
+    other.head_ = other.size_ = other.capacity_ = 0;
+  }
+  ~ring_buffer() { release_(); }
+
+  // OPERATORS
+  ring_buffer& operator=(const ring_buffer& other) {
+    if (this != &other) {
+      ring_buffer copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+  ring_buffer& operator=(ring_buffer&& other) noexcept {
+    if (this != &other) {
+      release_();
+      swap(other);
+    }
+    return *this;
+  }
+
+  // ELEMENT ACCESS
+  reference operator[](size_type pos) { return at_(pos); }
+  const_reference operator[](size_type pos) const { return at_(pos); }
+  reference front() { return buffer_[head_]; }
+  const_reference front() const { return buffer_[head_]; }
+  reference back() { return at_(size_ - 1); }
+  const_reference back() const { return at_(size_ - 1); }
+
+  // CAPACITY
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+  [[nodiscard]] size_type size() const { return size_; }
+  size_type capacity() const { return capacity_; }
+  // Makes room for n elements, so pushing up to n does not reallocate.
+  void reserve(size_type n) {
+    if (n > capacity_) reallocate_(n);
+  }
+  // Drops the unused part of the buffer; an empty buffer is freed entirely.
+  void shrink_to_fit() {
+    if (size_ < capacity_) reallocate_(size_);
+  }
+
+  // MODIFIERS
+  void clear() {
+    while (size_ != 0) {
+      pop_front();
+    }
+  }
+  void push_back(const_reference value) { emplace_back(value); }
+  void push_back(value_type&& value) { emplace_back(std::move(value)); }
+  template <class... Args>
+  reference emplace_back(Args&&... args) {
+    if (size_ == capacity_) {
+      return grow_and_emplace_back_(std::forward<Args>(args)...);
+    }
+    T* slot = buffer_ + wrap_(head_ + size_);
+    traits::construct(alloc_, slot, std::forward<Args>(args)...);
+    size_++;
+    return *slot;
+  }
+  void pop_front() {
+    traits::destroy(alloc_, buffer_ + head_);
+    if (++head_ == capacity_) head_ = 0;
+    size_--;
+  }
+  void swap(ring_buffer& other) noexcept {
+    std::swap(buffer_, other.buffer_);
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+    swap_allocators(alloc_, other.alloc_);
+  }
+
+ private:
+  // HELPER FUNCTIONS
+  size_type wrap_(size_type i) const {
+    return i < capacity_ ? i : i - capacity_;
+  }
+  T& at_(size_type i) const { return buffer_[wrap_(head_ + i)]; }
+  void reallocate_(size_type cap) {
+    relocate_to_(cap != 0 ? traits::allocate(alloc_, cap) : nullptr, cap);
+  }
+  // Builds the new element in a doubled buffer before the others move
+  // there, so args may refer to an element of the full buffer.
+  template <class... Args>
+  reference grow_and_emplace_back_(Args&&... args) {
+    size_type cap = capacity_ < 8 ? 8 : capacity_ * 2;
+    T* buffer = traits::allocate(alloc_, cap);
+    try {
+      traits::construct(alloc_, buffer + size_, std::forward<Args>(args)...);
+    } catch (...) {
+      traits::deallocate(alloc_, buffer, cap);
+      throw;
+    }
+    relocate_to_(buffer, cap);
+    return buffer_[size_++];
+  }
+  // Moves the elements, in order, to the start of buffer, which has cap
+  // slots, and frees the old one.
+  void relocate_to_(T* buffer, size_type cap) {
+    for (size_type i = 0; i < size_; i++) {
+      T& value = at_(i);
+      traits::construct(alloc_, buffer + i, std::move_if_noexcept(value));
+      traits::destroy(alloc_, &value);
+    }
+    if (buffer_ != nullptr) traits::deallocate(alloc_, buffer_, capacity_);
+    buffer_ = buffer;
+    head_ = 0;
+    capacity_ = cap;
+  }
+  void release_() {
+    clear();
+    if (buffer_ != nullptr) traits::deallocate(alloc_, buffer_, capacity_);
+    buffer_ = nullptr;
+    head_ = capacity_ = 0;
+  }
+};
+
+}  // namespace s21
+
+#endif  // SRC_RING_BUFFER
@@ -3,12 +3,27 @@
 
 #include "array.h"
 #include "btree.h"
+#include "concurrent_map.h"
+#include "deque.h"
+#include "flat_map.h"
+#include "flat_set.h"
+#include "intrusive_list.h"
 #include "list.h"
 #include "map.h"
+#include "mpmc_queue.h"
 #include "multiset.h"
+#include "priority_queue.h"
 #include "queue.h"
+#include "ring_buffer.h"
 #include "set.h"
+#include "simd.h"
+#include "small_vector.h"
+#include "spsc_queue.h"
 #include "stack.h"
+#include "unordered_map.h"
+#include "unordered_set.h"
+#include "unrolled_list.h"
 #include "vector.h"
+#include "work_stealing_deque.h"
 
 #endif  // CPP2_S21_CONTAINERS_0_SRC_S21_CONTAINERS_H_
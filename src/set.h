@@ -1,42 +1,42 @@
 
 #ifndef srcset
 #define srcset
+#include "bplus_tree.h"
 #include "btree.h"
 namespace s21 {
 
-template <class K>
-struct TreeNode {
+template <class K, bool Ranked = false>
+struct TreeNode : subtree_size<Ranked> {
   using value_type = K;
 
  public:
   Color color;
   K key;
-  TreeNode<K>* left = nullptr;
-  TreeNode<K>* right = nullptr;
-  TreeNode<K>* parent;
-  TreeNode() {
-    key = 0;
-    parent = left = right = nullptr;
-    color = BLACK;
-  }
-  TreeNode(K k, TreeNode<K>* p) {
-    color = RED;
-    key = k;
-    parent = p;
-  }
+  TreeNode* left = nullptr;
+  TreeNode* right = nullptr;
+  TreeNode* parent;
+  TreeNode() : color(BLACK), key(), parent(nullptr) {}
+  template <class... Args>
+  explicit TreeNode(std::in_place_t, Args&&... args)
+      : color(RED), key(std::forward<Args>(args)...), parent(nullptr) {}
 };
 
-template <class K>
-class set : public btree<K, K, TreeNode<K>, false> {
+// Engine picks the tree implementation: rb_tree_engine (default),
+// ranked_rb_tree_engine or bplus_tree_engine.
+template <class K, class Compare = std::less<K>,
+          class Allocator = slab_allocator<K>, class Engine = rb_tree_engine>
+class set : public Engine::template type<K, K, TreeNode<K, Engine::ranked>,
+                                         false, Compare, Allocator> {
+  using base = typename Engine::template type<
+      K, K, TreeNode<K, Engine::ranked>, false, Compare, Allocator>;
   using key_type = K;
-  using value_type = typename TreeNode<K>::value_type;
+  using value_type = K;
   using reference = K&;
   using const_reference = const K&;
-  using iterator = iterator_btree<K, K, TreeNode<K>, false>;
-  using const_iterator = const_iterator_btree<K, K, TreeNode<K>, false>;
+  using iterator = typename base::iterator;
+  using const_iterator = typename base::const_iterator;
   using size_type = size_t;
-  using Node = TreeNode<K>;
-  using btree<K, K, TreeNode<K>, false>::btree;
+  using base::base;
 
  public:
   std::pair<iterator, bool> insert(const value_type& k) {
@@ -44,16 +44,48 @@ class set : public btree<K, K, TreeNode<K>, false> {
     a = this->insert_iter(k);
     return a;
   }
+  std::pair<iterator, bool> insert(value_type&& k) {
+    return this->insert_iter(std::move(k));
+  }
+  template <class InputIt>
+  void insert(InputIt first, InputIt last) {
+    this->insert_range_(first, last);
+  }
 
-  bool contains(const key_type& k) {
-    Node* f = btree<K, K, TreeNode<K>, false>::find_(k, this->root_);
-    if (f == nullptr) {
+  bool contains(const key_type& k) const {
+    if (this->find(k) == this->end()) {
       return false;
     } else {
       return true;
     }
   }
+  template <class Key, class C = Compare, class = typename C::is_transparent>
+  bool contains(const Key& k) const {
+    return this->find(k) != this->end();
+  }
 };
 
+// Non-destructive set algebra, see btree::set_union.
+template <class K, class C, class A, class E>
+set<K, C, A, E> set_union(const set<K, C, A, E>& a, const set<K, C, A, E>& b) {
+  set<K, C, A, E> ret(a);
+  ret.set_union(b);
+  return ret;
+}
+template <class K, class C, class A, class E>
+set<K, C, A, E> set_intersection(const set<K, C, A, E>& a,
+                                 const set<K, C, A, E>& b) {
+  set<K, C, A, E> ret(a);
+  ret.set_intersection(b);
+  return ret;
+}
+template <class K, class C, class A, class E>
+set<K, C, A, E> set_difference(const set<K, C, A, E>& a,
+                               const set<K, C, A, E>& b) {
+  set<K, C, A, E> ret(a);
+  ret.set_difference(b);
+  return ret;
+}
+
 }  // namespace s21
 #endif
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include <memory>
+#include <set>
+#include <string>
+
+#include "bench.h"
+#include "set.h"
+
+namespace {
+
+using namespace s21::bench;
+
+template <class S, class T>
+void run_set(const char* impl, size_t n) {
+  const char* key = key_name<T>();
+  auto keys = shuffled_keys<T>(n);
+  measure(
+      "set", impl, "insert", key, n, n, [] { return std::make_unique<S>(); },
+      [&](std::unique_ptr<S>& s) {
+        for (auto& i : keys) {
+          s->insert(i);
+        }
+        keep(s->size());
+      });
+  auto full = std::make_unique<S>();
+  for (auto& i : keys) {
+    full->insert(i);
+  }
+  measure(
+      "set", impl, "find", key, n, n, [&] { return full.get(); },
+      [&](S* s) {
+        std::uint64_t sum = 0;
+        for (auto& i : keys) {
+          sum += checksum(*s->find(i));
+        }
+        keep(sum);
+      });
+  measure(
+      "set", impl, "iterate", key, n, n, [&] { return full.get(); },
+      [](S* s) {
+        std::uint64_t sum = 0;
+        for (auto i = s->begin(); i != s->end(); ++i) {
+          sum += checksum(*i);
+        }
+        keep(sum);
+      });
+  full.reset();
+  measure(
+      "set", impl, "erase", key, n, n,
+      [&] {
+        auto s = std::make_unique<S>();
+        for (auto& i : keys) {
+          s->insert(i);
+        }
+        return s;
+      },
+      [&](std::unique_ptr<S>& s) {
+        for (auto& i : keys) {
+          s->erase(s->find(i));
+        }
+        keep(s->size());
+      });
+}
+
+template <class T>
+void run_key() {
+  for (size_t n : sizes()) {
+    run_set<s21::set<T>, T>("s21", n);
+    run_set<std::set<T>, T>("std", n);
+  }
+}
+
+void run() {
+  run_key<int>();
+  run_key<std::string>();
+  run_key<blob64>();
+}
+
+registrar reg("set", run);
+
+}  // namespace
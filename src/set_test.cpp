@@ -1,9 +1,12 @@
 #include "set.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <ctime>
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "gtest/gtest.h"
 // Copyright 2022 nolanhea
@@ -313,6 +316,258 @@ TEST(SetTest, Emplace) {
   }
 }
 
+TEST(SetTest, CustomCompare) {
+  s21::set<int, std::greater<int>> A = {3, 1, 4, 1, 5, 9, 2, 6};
+  std::set<int, std::greater<int>> B = {3, 1, 4, 1, 5, 9, 2, 6};
+  EXPECT_EQ(A.size(), B.size());
+  auto j = B.begin();
+  for (auto i : A) {
+    EXPECT_EQ(i, *j);
+    j++;
+  }
+  EXPECT_TRUE(A.contains(9));
+  EXPECT_FALSE(A.contains(7));
+  EXPECT_EQ(*A.lower_bound(7), 6);
+}
+
+TEST(SetTest, TransparentLookup) {
+  s21::set<std::string, std::less<>> A = {"alpha", "beta", "gamma"};
+  std::string_view key = "beta";
+  EXPECT_TRUE(A.contains(key));
+  EXPECT_TRUE(A.contains("gamma"));
+  EXPECT_FALSE(A.contains("delta"));
+  EXPECT_EQ(*A.find(key), "beta");
+  EXPECT_EQ(A.count("alpha"), 1);
+  EXPECT_EQ(A.count("omega"), 0);
+  EXPECT_EQ(*A.lower_bound("b"), "beta");
+}
+
+template <class T>
+class checked_set : public s21::set<T> {
+ public:
+  using s21::set<T>::set;
+  bool is_red_black() { return this->isRedBlack(this->root_) != -1; }
+  int depth() { return this->cdepth(); }
+};
+
+TEST(SetTest, RangeConstructorSorted) {
+  std::vector<int> sorted;
+  for (int i = 0; i < 1000; i++) {
+    sorted.push_back(i * 3);
+  }
+  checked_set<int> A(sorted.begin(), sorted.end());
+  EXPECT_EQ(A.size(), 1000);
+  EXPECT_TRUE(A.is_red_black());
+  EXPECT_EQ(A.depth(), 10);
+  auto j = sorted.begin();
+  for (auto i : A) {
+    EXPECT_EQ(i, *j);
+    j++;
+  }
+  A.insert(1);
+  A.erase(A.find(3));
+  EXPECT_TRUE(A.is_red_black());
+  EXPECT_EQ(*(++A.begin()), 1);
+}
+
+TEST(SetTest, RangeConstructorUnsorted) {
+  std::vector<int> values = {5, 1, 4, 1, 5, 9, 2, 6, 5, 3};
+  std::set<int> B(values.begin(), values.end());
+  checked_set<int> A(values.begin(), values.end());
+  EXPECT_TRUE(A.is_red_black());
+  EXPECT_EQ(A.size(), B.size());
+  auto j = B.begin();
+  for (auto i : A) {
+    EXPECT_EQ(i, *j);
+    j++;
+  }
+}
+
+TEST(SetTest, Assign) {
+  for (int n = 0; n < 70; n++) {
+    std::vector<int> values;
+    for (int i = 0; i < n; i++) {
+      values.push_back(i);
+    }
+    checked_set<int> A = {100, 200};
+    A.assign(values.begin(), values.end());
+    EXPECT_EQ(A.size(), static_cast<size_t>(n));
+    EXPECT_TRUE(A.is_red_black());
+    int e = 0;
+    for (auto i : A) {
+      EXPECT_EQ(i, e);
+      e++;
+    }
+  }
+}
+
+TEST(SetTest, SetAlgebra) {
+  set<int> A = {1, 2, 3, 5, 8};
+  set<int> B = {2, 3, 4, 8, 9};
+  std::vector<int> expected = {1, 2, 3, 4, 5, 8, 9};
+  set<int> U = s21::set_union(A, B);
+  EXPECT_TRUE(std::equal(U.begin(), U.end(), expected.begin()));
+  EXPECT_EQ(U.size(), expected.size());
+  set<int> I = s21::set_intersection(A, B);
+  expected = {2, 3, 8};
+  EXPECT_TRUE(std::equal(I.begin(), I.end(), expected.begin()));
+  EXPECT_EQ(I.size(), expected.size());
+  set<int> D = s21::set_difference(A, B);
+  expected = {1, 5};
+  EXPECT_TRUE(std::equal(D.begin(), D.end(), expected.begin()));
+  EXPECT_EQ(D.size(), expected.size());
+  EXPECT_EQ(A.size(), 5);
+  EXPECT_EQ(B.size(), 5);
+  A.set_difference(std::move(B));
+  EXPECT_TRUE(B.empty());
+  EXPECT_EQ(A.size(), 2);
+}
+
+TEST(SetTest, ParallelSetAlgebra) {
+  checked_set<int> A, B;
+  std::set<int> C, D;
+  srand(5);
+  for (int i = 0; i < 50000; i++) {
+    int a = rand() % 100000, b = rand() % 100000;
+    A.insert(a);
+    B.insert(b);
+    C.insert(a);
+    D.insert(b);
+  }
+  std::vector<int> expected;
+  checked_set<int> U(A);
+  U.set_union(B);
+  std::set_union(C.begin(), C.end(), D.begin(), D.end(),
+                 std::back_inserter(expected));
+  EXPECT_TRUE(U.is_red_black());
+  EXPECT_EQ(U.size(), expected.size());
+  EXPECT_TRUE(std::equal(U.begin(), U.end(), expected.begin()));
+  expected.clear();
+  checked_set<int> I(A);
+  I.set_intersection(B);
+  std::set_intersection(C.begin(), C.end(), D.begin(), D.end(),
+                        std::back_inserter(expected));
+  EXPECT_TRUE(I.is_red_black());
+  EXPECT_EQ(I.size(), expected.size());
+  EXPECT_TRUE(std::equal(I.begin(), I.end(), expected.begin()));
+  expected.clear();
+  A.set_difference(std::move(B));
+  std::set_difference(C.begin(), C.end(), D.begin(), D.end(),
+                      std::back_inserter(expected));
+  EXPECT_TRUE(A.is_red_black());
+  EXPECT_EQ(A.size(), expected.size());
+  EXPECT_TRUE(std::equal(A.begin(), A.end(), expected.begin()));
+  EXPECT_TRUE(B.empty());
+}
+
+template <class T>
+using ranked_set = s21::set<T, std::less<T>, s21::slab_allocator<T>,
+                            s21::ranked_rb_tree_engine>;
+
+TEST(SetTest, OrderStatistics) {
+  ranked_set<int> A;
+  std::set<int> B;
+  srand(11);
+  for (int i = 0; i < 20000; i++) {
+    int v = rand() % 10000;
+    A.insert(v);
+    B.insert(v);
+    if (i % 3 == 0) {
+      v = rand() % 10000;
+      auto found = A.find(v);
+      if (found != A.end()) {
+        A.erase(found);
+        B.erase(v);
+      }
+    }
+  }
+  ASSERT_EQ(A.size(), B.size());
+  std::vector<int> sorted(B.begin(), B.end());
+  for (size_t k = 0; k < sorted.size(); k += 7) {
+    EXPECT_EQ(*A.nth(k), sorted[k]);
+    EXPECT_EQ(A.index_of(A.nth(k)), k);
+    EXPECT_EQ(A.rank(sorted[k]), k);
+  }
+  EXPECT_TRUE(A.nth(sorted.size()) == A.end());
+  EXPECT_EQ(A.index_of(A.end()), A.size());
+  EXPECT_EQ(A.rank(-1), 0);
+  EXPECT_EQ(A.rank(10000), A.size());
+  size_t below = std::lower_bound(sorted.begin(), sorted.end(), 2500) -
+                 sorted.begin();
+  size_t above = std::lower_bound(sorted.begin(), sorted.end(), 7500) -
+                 sorted.begin();
+  EXPECT_EQ(A.count_range(2500, 7500), above - below);
+  EXPECT_EQ(A.count_range(7500, 2500), 0);
+  auto i = A.begin();
+  A.advance(i, 100);
+  EXPECT_EQ(*i, sorted[100]);
+  A.advance(i, -50);
+  EXPECT_EQ(*i, sorted[50]);
+  EXPECT_EQ(A.distance(A.begin(), A.end()),
+            static_cast<std::ptrdiff_t>(A.size()));
+  EXPECT_EQ(A.distance(i, A.begin()), -50);
+}
+
+TEST(SetTest, OrderStatisticsAfterBulkOperations) {
+  std::vector<int> even, odd;
+  for (int i = 0; i < 3000; i++) {
+    (i % 2 ? odd : even).push_back(i);
+  }
+  ranked_set<int> A(even.begin(), even.end());
+  ranked_set<int> B(odd.begin(), odd.end());
+  EXPECT_EQ(*A.nth(10), 20);
+  A.set_union(std::move(B));
+  for (int k = 0; k < 3000; k += 13) {
+    EXPECT_EQ(*A.nth(k), k);
+    EXPECT_EQ(A.rank(k), static_cast<size_t>(k));
+  }
+  ranked_set<int> C(A);
+  C.set_difference(ranked_set<int>(even.begin(), even.end()));
+  EXPECT_EQ(C.size(), odd.size());
+  EXPECT_EQ(*C.nth(5), 11);
+  EXPECT_EQ(C.count_range(0, 100), 50);
+}
+
+TEST(SetTest, ForEach) {
+  set<int> A;
+  std::set<int> B;
+  srand(3);
+  for (int i = 0; i < 5000; i++) {
+    int v = rand() % 20000;
+    A.insert(v);
+    B.insert(v);
+  }
+  std::vector<int> visited;
+  A.for_each([&visited](int v) { visited.push_back(v); });
+  EXPECT_EQ(visited.size(), B.size());
+  EXPECT_TRUE(std::equal(visited.begin(), visited.end(), B.begin()));
+  visited.clear();
+  const set<int>& C = A;
+  C.for_each_range(5000, 15000, [&visited](int v) { visited.push_back(v); });
+  std::vector<int> expected(B.lower_bound(5000), B.lower_bound(15000));
+  EXPECT_EQ(visited, expected);
+  visited.clear();
+  A.for_each_range(15000, 5000, [&visited](int v) { visited.push_back(v); });
+  A.for_each_range(30000, 40000, [&visited](int v) { visited.push_back(v); });
+  EXPECT_TRUE(visited.empty());
+}
+
+TEST(SetTest, SwapAndMoveAssign) {
+  set<int> A = {1, 2, 3};
+  set<int> B = {7, 8};
+  const int* first = &*A.begin();
+  A.swap(B);
+  EXPECT_EQ(&*B.begin(), first);
+  EXPECT_EQ(A.size(), 2U);
+  A = std::move(B);
+  EXPECT_EQ(&*A.begin(), first);
+  EXPECT_EQ(A.size(), 3U);
+  EXPECT_TRUE(B.empty());
+  B.insert(5);
+  EXPECT_TRUE(B.contains(5));
+  EXPECT_TRUE(A.contains(3));
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
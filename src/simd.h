@@ -0,0 +1,484 @@
+#ifndef SRC_SIMD
+#define SRC_SIMD
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+
+#include "array.h"
+#include "small_vector.h"
+#include "vector.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define S21_SIMD_X86 1
+#endif
+
+// Search and reduction kernels over contiguous arithmetic elements. Each
+// kernel is compiled for AVX2 and for SSE4.2 with GCC vector extensions, and
+// the widest one the CPU supports is picked at run time from CPUID. Other
+// CPUs, compilers and element types use the std:: algorithms. Results match
+// the std:: algorithms, except that floating-point accumulate adds the
+// elements in a different order.
+namespace s21 {
+namespace simd {
+
+// Instruction sets the kernels are built for, in increasing width.
+enum class isa { scalar, sse42, avx2 };
+
+// Widest instruction set this CPU supports.
+inline isa detected() {
+#ifdef S21_SIMD_X86
+  static const isa level = [] {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return isa::avx2;
+    if (__builtin_cpu_supports("sse4.2")) return isa::sse42;
+    return isa::scalar;
+  }();
+  return level;
+#else
+  return isa::scalar;
+#endif
+}
+
+namespace detail {
+
+inline isa& active_() {
+  static isa level = detected();
+  return level;
+}
+
+}  // namespace detail
+
+// Instruction set the kernels currently run with.
+inline isa active() { return detail::active_(); }
+// Caps the kernels at level, e.g. to compare them against each other. A
+// level above detected() is ignored.
+inline void use(isa level) {
+  detail::active_() = std::min(level, detected());
+}
+
+namespace detail {
+
+// Element types the vector kernels handle: every arithmetic type but bool
+// and long double.
+template <class T>
+constexpr bool vectorizable =
+    std::is_arithmetic<T>::value && !std::is_same<T, bool>::value &&
+    sizeof(T) <= 8;
+
+#ifdef S21_SIMD_X86
+#define S21_SIMD_INLINE __attribute__((always_inline)) inline
+
+// Bytes-wide vector of T; Bytes / sizeof(T) lanes.
+template <class T, size_t Bytes>
+struct vec_of {
+  typedef T type __attribute__((vector_size(Bytes)));
+};
+
+// Whether any lane of the comparison result m is set.
+template <class M>
+S21_SIMD_INLINE bool any_(const M& m) {
+  std::uint64_t words[sizeof(M) / 8];
+  std::memcpy(words, &m, sizeof(M));
+  std::uint64_t ret = 0;
+  for (auto w : words) {
+    ret |= w;
+  }
+  return ret != 0;
+}
+
+// The kernels below are always inlined into the per-instruction-set
+// wrappers further down, which is where they get their AVX2 or SSE4.2 code.
+template <class T, size_t B>
+S21_SIMD_INLINE size_t find_k(const T* p, size_t n, T value) {
+  using V = typename vec_of<T, B>::type;
+  constexpr size_t W = B / sizeof(T);
+  V needle = V{} + value;
+  size_t i = 0;
+  for (; i + W <= n; i += W) {
+    V v;
+    std::memcpy(&v, p + i, B);
+    if (any_(v == needle)) break;
+  }
+  for (; i < n; i++) {
+    if (p[i] == value) return i;
+  }
+  return n;
+}
+
+// Matching lanes are -1, so subtracting the masks counts them per lane. The
+// lane counters are flushed before they can overflow.
+template <class T, size_t B>
+S21_SIMD_INLINE size_t count_k(const T* p, size_t n, T value) {
+  using V = typename vec_of<T, B>::type;
+  using M = decltype(V{} == V{});
+  using lane = std::remove_reference_t<decltype(M{}[0])>;
+  constexpr size_t W = B / sizeof(T);
+  constexpr size_t kBlock = std::min<std::uint64_t>(
+      std::numeric_limits<lane>::max(), std::uint64_t(1) << 24);
+  V needle = V{} + value;
+  size_t ret = 0;
+  size_t i = 0;
+  while (i + W <= n) {
+    size_t end = i + std::min(kBlock, (n - i) / W) * W;
+    M acc = {};
+    for (; i < end; i += W) {
+      V v;
+      std::memcpy(&v, p + i, B);
+      acc -= (v == needle);
+    }
+    for (size_t j = 0; j < W; j++) {
+      ret += static_cast<size_t>(acc[j]);
+    }
+  }
+  for (; i < n; i++) {
+    ret += p[i] == value;
+  }
+  return ret;
+}
+
+// Index of the first smallest (or, with Max, largest) element, n when p is
+// empty. A NaN anywhere hands the range back to std::min_element and
+// std::max_element, which treat it specially.
+template <class T, size_t B, bool Max>
+S21_SIMD_INLINE size_t extreme_k(const T* p, size_t n) {
+  using V = typename vec_of<T, B>::type;
+  constexpr size_t W = B / sizeof(T);
+  if (n < W) {
+    return (Max ? std::max_element(p, p + n) : std::min_element(p, p + n)) -
+           p;
+  }
+  V best;
+  std::memcpy(&best, p, B);
+  [[maybe_unused]] auto nan = best != best;
+  size_t i = W;
+  for (; i + W <= n; i += W) {
+    V v;
+    std::memcpy(&v, p + i, B);
+    best = Max ? (v > best ? v : best) : (v < best ? v : best);
+    if constexpr (std::is_floating_point<T>::value) nan |= v != v;
+  }
+  if constexpr (std::is_floating_point<T>::value) {
+    bool tail_nan = false;
+    for (size_t j = i; j < n; j++) {
+      tail_nan |= p[j] != p[j];
+    }
+    if (tail_nan || any_(nan)) {
+      return (Max ? std::max_element(p, p + n)
+                  : std::min_element(p, p + n)) -
+             p;
+    }
+  }
+  T ret = best[0];
+  for (size_t j = 1; j < W; j++) {
+    ret = Max ? std::max<T>(ret, best[j]) : std::min<T>(ret, best[j]);
+  }
+  for (; i < n; i++) {
+    ret = Max ? std::max<T>(ret, p[i]) : std::min<T>(ret, p[i]);
+  }
+  return find_k<T, B>(p, n, ret);
+}
+
+// Integers are summed in unsigned lanes, which wrap instead of overflowing.
+template <class T, size_t B>
+S21_SIMD_INLINE T accumulate_k(const T* p, size_t n, T init) {
+  using U = typename std::conditional_t<std::is_integral<T>::value,
+                                        std::make_unsigned<T>,
+                                        std::common_type<T>>::type;
+  using V = typename vec_of<U, B>::type;
+  constexpr size_t W = B / sizeof(T);
+  V acc = {};
+  size_t i = 0;
+  for (; i + W <= n; i += W) {
+    V v;
+    std::memcpy(&v, p + i, B);
+    acc += v;
+  }
+  U ret = static_cast<U>(init);
+  for (size_t j = 0; j < W; j++) {
+    ret = ret + acc[j];
+  }
+  for (; i < n; i++) {
+    ret = ret + static_cast<U>(p[i]);
+  }
+  return static_cast<T>(ret);
+}
+
+template <class T, size_t B>
+S21_SIMD_INLINE bool equal_k(const T* a, const T* b, size_t n) {
+  using V = typename vec_of<T, B>::type;
+  constexpr size_t W = B / sizeof(T);
+  size_t i = 0;
+  for (; i + W <= n; i += W) {
+    V va, vb;
+    std::memcpy(&va, a + i, B);
+    std::memcpy(&vb, b + i, B);
+    if (any_(va != vb)) return false;
+  }
+  for (; i < n; i++) {
+    if (!(a[i] == b[i])) return false;
+  }
+  return true;
+}
+
+#undef S21_SIMD_INLINE
+
+// One wrapper per kernel and instruction set.
+template <class T>
+__attribute__((target("avx2"))) size_t find_avx2(const T* p, size_t n,
+                                                 T value) {
+  return find_k<T, 32>(p, n, value);
+}
+template <class T>
+__attribute__((target("sse4.2"))) size_t find_sse42(const T* p, size_t n,
+                                                    T value) {
+  return find_k<T, 16>(p, n, value);
+}
+template <class T>
+__attribute__((target("avx2"))) size_t count_avx2(const T* p, size_t n,
+                                                  T value) {
+  return count_k<T, 32>(p, n, value);
+}
+template <class T>
+__attribute__((target("sse4.2"))) size_t count_sse42(const T* p, size_t n,
+                                                     T value) {
+  return count_k<T, 16>(p, n, value);
+}
+template <class T, bool Max>
+__attribute__((target("avx2"))) size_t extreme_avx2(const T* p, size_t n) {
+  return extreme_k<T, 32, Max>(p, n);
+}
+template <class T, bool Max>
+__attribute__((target("sse4.2"))) size_t extreme_sse42(const T* p,
+                                                       size_t n) {
+  return extreme_k<T, 16, Max>(p, n);
+}
+template <class T>
+__attribute__((target("avx2"))) T accumulate_avx2(const T* p, size_t n,
+                                                  T init) {
+  return accumulate_k<T, 32>(p, n, init);
+}
+template <class T>
+__attribute__((target("sse4.2"))) T accumulate_sse42(const T* p, size_t n,
+                                                     T init) {
+  return accumulate_k<T, 16>(p, n, init);
+}
+template <class T>
+__attribute__((target("avx2"))) bool equal_avx2(const T* a, const T* b,
+                                                size_t n) {
+  return equal_k<T, 32>(a, b, n);
+}
+template <class T>
+__attribute__((target("sse4.2"))) bool equal_sse42(const T* a, const T* b,
+                                                   size_t n) {
+  return equal_k<T, 16>(a, b, n);
+}
+#endif  // S21_SIMD_X86
+
+// Iterator into c at p, for the container overloads.
+template <class T>
+iterator_vector<T> iter_(vector<T>&, const T* p) {
+  return iterator_vector<T>(const_cast<T*>(p));
+}
+template <class T>
+const_iterator_vector<T> iter_(const vector<T>&, const T* p) {
+  return const_iterator_vector<T>(const_cast<T*>(p));
+}
+template <class T, size_t N>
+T* iter_(array<T, N>&, const T* p) {
+  return const_cast<T*>(p);
+}
+template <class T, size_t N>
+const T* iter_(const array<T, N>&, const T* p) {
+  return p;
+}
+template <class T, size_t N>
+T* iter_(small_vector<T, N>&, const T* p) {
+  return const_cast<T*>(p);
+}
+template <class T, size_t N>
+const T* iter_(const small_vector<T, N>&, const T* p) {
+  return p;
+}
+
+template <class C>
+using element_t = std::remove_cv_t<
+    std::remove_pointer_t<decltype(std::declval<const C&>().data())>>;
+
+}  // namespace detail
+
+// ALGORITHMS OVER POINTER RANGES
+template <class T>
+const T* find(const T* first, const T* last, const T& value) {
+  if constexpr (detail::vectorizable<T>) {
+#ifdef S21_SIMD_X86
+    size_t n = last - first;
+    switch (active()) {
+      case isa::avx2:
+        return first + detail::find_avx2<T>(first, n, value);
+      case isa::sse42:
+        return first + detail::find_sse42<T>(first, n, value);
+      default:
+        break;
+    }
+#endif
+  }
+  return std::find(first, last, value);
+}
+
+template <class T>
+bool contains(const T* first, const T* last, const T& value) {
+  return simd::find(first, last, value) != last;
+}
+
+template <class T>
+size_t count(const T* first, const T* last, const T& value) {
+  if constexpr (detail::vectorizable<T>) {
+#ifdef S21_SIMD_X86
+    size_t n = last - first;
+    switch (active()) {
+      case isa::avx2:
+        return detail::count_avx2<T>(first, n, value);
+      case isa::sse42:
+        return detail::count_sse42<T>(first, n, value);
+      default:
+        break;
+    }
+#endif
+  }
+  return std::count(first, last, value);
+}
+
+template <class T>
+const T* min_element(const T* first, const T* last) {
+  if constexpr (detail::vectorizable<T>) {
+#ifdef S21_SIMD_X86
+    size_t n = last - first;
+    switch (active()) {
+      case isa::avx2:
+        return first + detail::extreme_avx2<T, false>(first, n);
+      case isa::sse42:
+        return first + detail::extreme_sse42<T, false>(first, n);
+      default:
+        break;
+    }
+#endif
+  }
+  return std::min_element(first, last);
+}
+
+template <class T>
+const T* max_element(const T* first, const T* last) {
+  if constexpr (detail::vectorizable<T>) {
+#ifdef S21_SIMD_X86
+    size_t n = last - first;
+    switch (active()) {
+      case isa::avx2:
+        return first + detail::extreme_avx2<T, true>(first, n);
+      case isa::sse42:
+        return first + detail::extreme_sse42<T, true>(first, n);
+      default:
+        break;
+    }
+#endif
+  }
+  return std::max_element(first, last);
+}
+
+template <class T>
+T accumulate(const T* first, const T* last, T init) {
+  if constexpr (detail::vectorizable<T>) {
+#ifdef S21_SIMD_X86
+    size_t n = last - first;
+    switch (active()) {
+      case isa::avx2:
+        return detail::accumulate_avx2<T>(first, n, init);
+      case isa::sse42:
+        return detail::accumulate_sse42<T>(first, n, init);
+      default:
+        break;
+    }
+#endif
+  }
+  return std::accumulate(first, last, init);
+}
+
+// Only floating-point ranges need a kernel: integers compare bytewise,
+// which std::equal already does with memcmp.
+template <class T>
+bool equal(const T* first1, const T* last1, const T* first2) {
+  if constexpr (std::is_floating_point<T>::value &&
+                detail::vectorizable<T>) {
+#ifdef S21_SIMD_X86
+    size_t n = last1 - first1;
+    switch (active()) {
+      case isa::avx2:
+        return detail::equal_avx2<T>(first1, first2, n);
+      case isa::sse42:
+        return detail::equal_sse42<T>(first1, first2, n);
+      default:
+        break;
+    }
+#endif
+  }
+  return std::equal(first1, last1, first2);
+}
+
+// ALGORITHMS OVER s21::vector, s21::array AND s21::small_vector
+template <class C, class T = detail::element_t<C>>
+auto find(C& c, const T& value) -> decltype(detail::iter_(c, c.data())) {
+  const T* first = c.data();
+  return detail::iter_(c, simd::find(first, first + c.size(), value));
+}
+
+template <class C, class T = detail::element_t<C>>
+auto contains(const C& c, const T& value)
+    -> decltype(detail::iter_(c, c.data()), true) {
+  const T* first = c.data();
+  return simd::contains(first, first + c.size(), value);
+}
+
+template <class C, class T = detail::element_t<C>>
+auto count(const C& c, const T& value)
+    -> decltype(detail::iter_(c, c.data()), size_t()) {
+  const T* first = c.data();
+  return simd::count(first, first + c.size(), value);
+}
+
+template <class C, class T = detail::element_t<C>>
+auto min_element(C& c) -> decltype(detail::iter_(c, c.data())) {
+  const T* first = c.data();
+  return detail::iter_(c, simd::min_element(first, first + c.size()));
+}
+
+template <class C, class T = detail::element_t<C>>
+auto max_element(C& c) -> decltype(detail::iter_(c, c.data())) {
+  const T* first = c.data();
+  return detail::iter_(c, simd::max_element(first, first + c.size()));
+}
+
+template <class C, class T = detail::element_t<C>>
+auto accumulate(const C& c, T init)
+    -> decltype(detail::iter_(c, c.data()), T()) {
+  const T* first = c.data();
+  return simd::accumulate(first, first + c.size(), init);
+}
+
+// Whether a and b hold the same elements; false when the sizes differ.
+template <class C, class T = detail::element_t<C>>
+auto equal(const C& a, const C& b)
+    -> decltype(detail::iter_(a, a.data()), true) {
+  if (a.size() != b.size()) return false;
+  const T* first = a.data();
+  return simd::equal(first, first + a.size(), b.data());
+}
+
+}  // namespace simd
+}  // namespace s21
+
+#endif  // SRC_SIMD
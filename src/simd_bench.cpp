@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <numeric>
+
+#include "bench.h"
+#include "simd.h"
+#include "vector.h"
+
+namespace {
+
+using namespace s21::bench;
+
+// The std rows run the std:: algorithms over the same s21::vector, so the
+// difference is the kernels alone. find looks for a missing key and scans
+// everything.
+template <class T>
+void run_simd(const char* impl, bool simd, size_t n) {
+  const char* key = key_name<T>();
+  auto keys = shuffled_keys<T>(n);
+  s21::vector<T> v;
+  v.reserve(n);
+  for (auto& i : keys) {
+    v.push_back(i);
+  }
+  s21::vector<T> w(v);
+  const T* first = v.data();
+  const T* last = first + n;
+  auto setup = [&] { return &v; };
+  const T missing = make_key<T>(n);
+  measure("simd", impl, "find", key, n, n, setup, [&](s21::vector<T>*) {
+    keep(simd ? s21::simd::find(first, last, missing) - first
+              : std::find(first, last, missing) - first);
+  });
+  measure("simd", impl, "count", key, n, n, setup, [&](s21::vector<T>*) {
+    keep(simd ? s21::simd::count(first, last, keys[0])
+              : std::count(first, last, keys[0]));
+  });
+  measure("simd", impl, "min_element", key, n, n, setup,
+          [&](s21::vector<T>*) {
+            keep(simd ? s21::simd::min_element(first, last) - first
+                      : std::min_element(first, last) - first);
+          });
+  measure("simd", impl, "accumulate", key, n, n, setup,
+          [&](s21::vector<T>*) {
+            keep(checksum(simd ? s21::simd::accumulate(first, last, T())
+                               : std::accumulate(first, last, T())));
+          });
+  measure("simd", impl, "equal", key, n, n, setup, [&](s21::vector<T>*) {
+    keep(simd ? s21::simd::equal(first, last, w.data())
+              : std::equal(first, last, w.data()));
+  });
+}
+
+template <class T>
+void run_key() {
+  for (size_t n : sizes()) {
+    run_simd<T>("s21", true, n);
+    run_simd<T>("std", false, n);
+  }
+}
+
+void run() {
+  run_key<int>();
+  run_key<float>();
+}
+
+registrar reg("simd", run);
+
+}  // namespace
@@ -0,0 +1,126 @@
+#include "simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+const s21::simd::isa kLevels[] = {s21::simd::isa::scalar,
+                                  s21::simd::isa::sse42,
+                                  s21::simd::isa::avx2};
+
+// Checks every kernel against the std:: algorithms at each instruction set,
+// for sizes around the vector widths so the scalar tails are covered too.
+template <class T>
+void check_against_std() {
+  std::mt19937 gen(7);
+  for (auto level : kLevels) {
+    s21::simd::use(level);
+    for (size_t n : {0, 1, 3, 7, 15, 16, 17, 31, 33, 64, 1000, 4099}) {
+      std::vector<T> v(n);
+      for (auto& i : v) {
+        i = static_cast<T>(gen() % 100);
+      }
+      const T* first = v.data();
+      const T* last = first + n;
+      for (T value : {T(0), T(42), T(99), T(100)}) {
+        EXPECT_EQ(s21::simd::find(first, last, value),
+                  std::find(first, last, value));
+        EXPECT_EQ(s21::simd::count(first, last, value),
+                  static_cast<size_t>(std::count(first, last, value)));
+      }
+      EXPECT_EQ(s21::simd::min_element(first, last),
+                std::min_element(first, last));
+      EXPECT_EQ(s21::simd::max_element(first, last),
+                std::max_element(first, last));
+      std::vector<T> w(v);
+      EXPECT_TRUE(s21::simd::equal(first, last, w.data()));
+      if (n != 0) {
+        w[n / 2] = T(101);
+        EXPECT_FALSE(s21::simd::equal(first, last, w.data()));
+      }
+      if (std::is_integral<T>::value) {
+        EXPECT_EQ(s21::simd::accumulate(first, last, T(1)),
+                  std::accumulate(first, last, T(1)));
+      }
+    }
+  }
+  s21::simd::use(s21::simd::detected());
+}
+
+}  // namespace
+
+class SimdTest : public ::testing::Test {};
+
+TEST(SimdTest, MatchesStd) {
+  check_against_std<int>();
+  check_against_std<unsigned>();
+  check_against_std<std::int8_t>();
+  check_against_std<std::uint16_t>();
+  check_against_std<std::int64_t>();
+  check_against_std<float>();
+  check_against_std<double>();
+}
+
+TEST(SimdTest, CountDoesNotOverflowNarrowLanes) {
+  std::vector<std::int8_t> v(100000, 5);
+  for (auto level : kLevels) {
+    s21::simd::use(level);
+    EXPECT_EQ(s21::simd::count(v.data(), v.data() + v.size(), int8_t(5)),
+              v.size());
+  }
+  s21::simd::use(s21::simd::detected());
+}
+
+TEST(SimdTest, FloatingPoint) {
+  std::vector<float> v(1000);
+  std::iota(v.begin(), v.end(), 1.0f);
+  const float* first = v.data();
+  const float* last = first + v.size();
+  EXPECT_FLOAT_EQ(s21::simd::accumulate(first, last, 0.0f), 500500.0f);
+  v[500] = std::numeric_limits<float>::quiet_NaN();
+  v[700] = -5;
+  EXPECT_EQ(s21::simd::min_element(first, last),
+            std::min_element(first, last));
+  EXPECT_EQ(s21::simd::max_element(first, last),
+            std::max_element(first, last));
+  EXPECT_EQ(s21::simd::find(first, last, v[500]), last);
+  std::vector<float> w(v);
+  EXPECT_FALSE(s21::simd::equal(first, last, w.data()));
+  v[500] = 0.0f;
+  w[500] = -0.0f;
+  EXPECT_TRUE(s21::simd::equal(first, last, w.data()));
+}
+
+TEST(SimdTest, Containers) {
+  s21::vector<int> A{4, 8, 15, 16, 23, 42, 4, 8, 15};
+  auto it = s21::simd::find(A, 42);
+  EXPECT_EQ(*it, 42);
+  EXPECT_TRUE(s21::simd::find(A, 7) == A.end());
+  EXPECT_TRUE(s21::simd::contains(A, 23));
+  EXPECT_EQ(s21::simd::count(A, 8), 2U);
+  EXPECT_EQ(*s21::simd::min_element(A), 4);
+  EXPECT_EQ(*s21::simd::max_element(A), 42);
+  EXPECT_EQ(s21::simd::accumulate(A, 0), 135);
+  const s21::vector<int>& B = A;
+  EXPECT_EQ(*s21::simd::find(B, 16), 16);
+  EXPECT_TRUE(s21::simd::equal(A, B));
+
+  s21::array<float, 5> C{1.5f, -2.0f, 3.0f, 0.5f, -2.0f};
+  EXPECT_EQ(s21::simd::min_element(C), C.begin() + 1);
+  EXPECT_EQ(s21::simd::find(C, 0.5f), C.begin() + 3);
+  EXPECT_FLOAT_EQ(s21::simd::accumulate(C, 0.0f), 1.0f);
+  s21::array<float, 5> D(C);
+  EXPECT_TRUE(s21::simd::equal(C, D));
+
+  s21::small_vector<short, 8> E{3, 1, 2};
+  EXPECT_EQ(s21::simd::max_element(E), E.begin());
+  EXPECT_FALSE(s21::simd::contains(E, short(7)));
+}
@@ -0,0 +1,269 @@
+#ifndef S21_SMALL_VECTOR
+#define S21_SMALL_VECTOR
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "raw_storage.h"
+
+namespace s21 {
+
+// s21::vector with room for N elements inside the object itself: nothing is
+// allocated until the N+1st element arrives, and the elements go back
+// inline when shrink_to_fit finds they fit. Moving steals a heap buffer but
+// has to relocate inline elements one by one, so iterators into an inline
+// small_vector do not survive a move or swap.
+template <class T, size_t N>
+class small_vector {
+  static_assert(N > 0, "small_vector needs room for at least one element");
+
+ public:
+  using value_type = T;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = size_t;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+ private:
+  // front_ points either at inline_ or at a heap buffer of capacity_ slots;
+  // only [front_, front_ + size_) holds constructed elements.
+  value_type* front_;
+  size_t size_;
+  size_t capacity_;
+  alignas(T) unsigned char inline_[N * sizeof(T)];
+
+ public:
+  // CONSTRUCTORS, ASSIGNMENT OPERATORS
+  small_vector() : front_(inline_ptr_()), size_(0), capacity_(N) {}
+
+  explicit small_vector(size_type n) : small_vector() { resize(n); }
+
+  small_vector(std::initializer_list<value_type> const& items)
+      : small_vector() {
+    reserve(items.size());
+    raw_storage::copy_construct(items.begin(), items.size(), front_);
+    size_ = items.size();
+  }
+
+  small_vector(const small_vector& other) : small_vector() {
+    reserve(other.size_);
+    raw_storage::copy_construct(other.front_, other.size_, front_);
+    size_ = other.size_;
+  }
+
+  small_vector(small_vector&& other) noexcept(
+      std::is_nothrow_move_constructible<T>::value)
+      : small_vector() {
+    take_(other);
+  }
+
+  ~small_vector() { release_(); }
+
+  small_vector& operator=(small_vector&& other) noexcept(
+      std::is_nothrow_move_constructible<T>::value) {
+    if (this == &other) return *this;
+    release_();
+    front_ = inline_ptr_();
+    capacity_ = N;
+    take_(other);
+    return *this;
+  }
+  // Reuses the current storage when it is large enough.
+  small_vector& operator=(const small_vector& other) {
+    if (this == &other) return *this;
+    clear();
+    reserve(other.size_);
+    raw_storage::copy_construct(other.front_, other.size_, front_);
+    size_ = other.size_;
+    return *this;
+  }
+
+  // METHODS FOR ACCESS OF ELEMENTS
+  reference at(size_type pos) {
+    if (pos >= size_) {
+      throw std::out_of_range("index out of range");
+    }
+    return front_[pos];
+  }
+  const_reference at(size_type pos) const {
+    if (pos >= size_) {
+      throw std::out_of_range("index out of range");
+    }
+    return front_[pos];
+  }
+  reference operator[](size_type pos) { return front_[pos]; }
+  const_reference operator[](size_type pos) const { return front_[pos]; }
+  reference front() { return *front_; }
+  const_reference front() const { return *front_; }
+  reference back() { return front_[size_ - 1]; }
+  const_reference back() const { return front_[size_ - 1]; }
+  T* data() { return front_; }
+  const T* data() const { return front_; }
+
+  // ITERATORS
+  iterator begin() { return front_; }
+  iterator end() { return front_ + size_; }
+  const_iterator begin() const { return front_; }
+  const_iterator end() const { return front_ + size_; }
+
+  // CAPACITY
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+  [[nodiscard]] size_type size() const { return size_; }
+  [[nodiscard]] size_type max_size() const {
+    return std::numeric_limits<std::ptrdiff_t>::max() / sizeof(T);
+  }
+  [[nodiscard]] size_type capacity() const { return capacity_; }
+  // Whether the elements live in the object rather than on the heap.
+  [[nodiscard]] bool is_inline() const { return front_ == inline_ptr_(); }
+  void reserve(size_type size) {
+    if (size > capacity_) reallocate_(size);
+  }
+  // Moves the elements back inline when they fit, otherwise trims the heap
+  // buffer to size().
+  void shrink_to_fit() {
+    if (!is_inline() && capacity_ > size_) reallocate_(size_);
+  }
+  // Value-initializes new elements, so arithmetic types become zero.
+  void resize(size_type n) {
+    resize_with_(n, [](T* p) { ::new (static_cast<void*>(p)) T(); });
+  }
+  void resize(size_type n, const_reference value) {
+    if (n > capacity_ && front_ <= &value && &value < front_ + size_) {
+      T copy(value);
+      resize(n, copy);
+      return;
+    }
+    resize_with_(n, [&value](T* p) { ::new (static_cast<void*>(p)) T(value); });
+  }
+
+  // MODIFIERS
+  void push_back(const_reference value) { emplace_back(value); }
+  void push_back(value_type&& value) { emplace_back(std::move(value)); }
+  void pop_back() {
+    if (size_ > 0) {
+      size_--;
+      front_[size_].~T();
+    }
+  }
+  iterator insert(const_iterator pos, const_reference value) {
+    return emplace_at_(pos - front_, value);
+  }
+  iterator insert(const_iterator pos, value_type&& value) {
+    return emplace_at_(pos - front_, std::move(value));
+  }
+  void erase(const_iterator pos) {
+    if (size_ == 0) {
+      return;
+    }
+    T* p = front_ + (pos - front_);
+    std::move(p + 1, front_ + size_, p);
+    pop_back();
+  }
+  // Destroys the elements and keeps the storage.
+  void clear() {
+    destroy_(front_, front_ + size_);
+    size_ = 0;
+  }
+  // Exchanges heap buffers in O(1); inline elements are relocated.
+  void swap(small_vector& other) noexcept(
+      std::is_nothrow_move_constructible<T>::value) {
+    if (this == &other) return;
+    if (!is_inline() && !other.is_inline()) {
+      std::swap(front_, other.front_);
+      std::swap(size_, other.size_);
+      std::swap(capacity_, other.capacity_);
+      return;
+    }
+    small_vector tmp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(tmp);
+  }
+
+  template <class... Args>
+  iterator emplace(const_iterator pos, Args&&... args) {
+    return emplace_at_(pos - front_, std::forward<Args>(args)...);
+  }
+
+  template <class... Args>
+  iterator emplace_back(Args&&... args) {
+    // Kept apart from emplace_at_ so the common case inlines.
+    if (size_ != capacity_) {
+      ::new (static_cast<void*>(front_ + size_)) T(std::forward<Args>(args)...);
+      return front_ + size_++;
+    }
+    return emplace_at_(size_, std::forward<Args>(args)...);
+  }
+
+ private:
+  // HELPER FUNCTIONS
+  T* inline_ptr_() { return reinterpret_cast<T*>(inline_); }
+  const T* inline_ptr_() const { return reinterpret_cast<const T*>(inline_); }
+  static void destroy_(T* first, T* last) {
+    raw_storage::destroy(first, last);
+  }
+  void release_() {
+    destroy_(front_, front_ + size_);
+    if (!is_inline()) raw_storage::deallocate(front_, capacity_);
+  }
+  // Takes the elements of other, which is left empty and inline. *this must
+  // be empty and inline.
+  void take_(small_vector& other) {
+    if (other.is_inline()) {
+      raw_storage::relocate(other.front_, other.front_ + other.size_, front_);
+    } else {
+      front_ = other.front_;
+      capacity_ = other.capacity_;
+      other.front_ = other.inline_ptr_();
+      other.capacity_ = N;
+    }
+    size_ = other.size_;
+    other.size_ = 0;
+  }
+  // Moves the elements to storage for cap of them: back inline when cap
+  // fits there, to a new heap buffer otherwise.
+  void reallocate_(size_type cap) {
+    T* buffer = cap <= N ? inline_ptr_() : raw_storage::allocate<T>(cap);
+    if (buffer == front_) return;
+    raw_storage::relocate(front_, front_ + size_, buffer);
+    if (!is_inline()) raw_storage::deallocate(front_, capacity_);
+    front_ = buffer;
+    capacity_ = std::max(cap, N);
+  }
+  template <class Init>
+  void resize_with_(size_type n, Init init) {
+    if (n > capacity_) reallocate_(std::max(n, 2 * capacity_));
+    raw_storage::resize_with(front_, size_, n, init);
+  }
+  // Constructs an element from args at index p, shifting the ones behind it
+  // up by one. args may refer into the small_vector.
+  template <class... Args>
+  T* emplace_at_(size_type p, Args&&... args) {
+    if (size_ == capacity_) {
+      size_type cap = 2 * capacity_;
+      T* buffer = raw_storage::grow_emplace(front_, size_, p, cap,
+                                            std::forward<Args>(args)...);
+      if (!is_inline()) raw_storage::deallocate(front_, capacity_);
+      front_ = buffer;
+      capacity_ = cap;
+    } else {
+      raw_storage::emplace(front_, size_, p, std::forward<Args>(args)...);
+    }
+    size_++;
+    return front_ + p;
+  }
+};
+
+}  // namespace s21
+
+#endif  // S21_SMALL_VECTOR
@@ -0,0 +1,162 @@
+#include "small_vector.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+// Throws from its constructor while armed.
+struct may_throw {
+  static bool armed;
+  int value;
+  explicit may_throw(int v = 0) : value(v) {
+    if (armed) throw std::runtime_error("may_throw");
+  }
+};
+bool may_throw::armed = false;
+}  // namespace
+
+// small_vector allocates its heap buffers through std::allocator, so this
+// specialization lets the tests count those still allocated.
+template <>
+struct std::allocator<may_throw> {
+  using value_type = may_throw;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using propagate_on_container_move_assignment = std::true_type;
+  using is_always_equal = std::true_type;
+  static inline int live = 0;
+
+  allocator() = default;
+  template <class U>
+  allocator(const allocator<U>&) {}
+  may_throw* allocate(size_t n) {
+    live++;
+    return static_cast<may_throw*>(::operator new(n * sizeof(may_throw)));
+  }
+  void deallocate(may_throw* p, size_t) {
+    live--;
+    ::operator delete(p);
+  }
+};
+
+class SmallVectorTest : public ::testing::Test {};
+
+TEST(SmallVectorTest, StaysInlineUpToN) {
+  s21::small_vector<int, 8> A;
+  EXPECT_TRUE(A.is_inline());
+  EXPECT_EQ(A.capacity(), 8U);
+  for (int i = 0; i < 8; i++) {
+    A.push_back(i);
+  }
+  EXPECT_TRUE(A.is_inline());
+  A.push_back(8);
+  EXPECT_FALSE(A.is_inline());
+  EXPECT_EQ(A.capacity(), 16U);
+  for (int i = 0; i < 9; i++) {
+    EXPECT_EQ(A[i], i);
+  }
+  A.pop_back();
+  A.pop_back();
+  A.shrink_to_fit();
+  EXPECT_TRUE(A.is_inline());
+  EXPECT_EQ(A.back(), 6);
+  EXPECT_THROW(A.at(7), std::out_of_range);
+}
+
+TEST(SmallVectorTest, MatchesStdVector) {
+  s21::small_vector<std::string, 4> A;
+  std::vector<std::string> B;
+  for (int i = 0; i < 200; i++) {
+    std::string s(20, 'a' + i % 26);
+    if (i % 3 == 0) {
+      A.insert(A.begin(), s);
+      B.insert(B.begin(), s);
+    } else {
+      A.emplace_back(s);
+      B.emplace_back(s);
+    }
+    if (i % 5 == 0) {
+      A.erase(A.begin() + 1);
+      B.erase(B.begin() + 1);
+    }
+  }
+  ASSERT_EQ(A.size(), B.size());
+  EXPECT_TRUE(std::equal(A.begin(), A.end(), B.begin()));
+  A.resize(3);
+  A.resize(5, "z");
+  EXPECT_EQ(A[0], B[0]);
+  EXPECT_EQ(A[4], "z");
+}
+
+TEST(SmallVectorTest, MoveStealsHeapAndRelocatesInline) {
+  s21::small_vector<std::unique_ptr<int>, 2> A;
+  A.push_back(std::make_unique<int>(1));
+  s21::small_vector<std::unique_ptr<int>, 2> B(std::move(A));
+  EXPECT_TRUE(A.empty());
+  EXPECT_TRUE(B.is_inline());
+  EXPECT_EQ(*B[0], 1);
+  for (int i = 2; i < 10; i++) {
+    B.push_back(std::make_unique<int>(i));
+  }
+  const std::unique_ptr<int>* data = B.data();
+  s21::small_vector<std::unique_ptr<int>, 2> C;
+  C = std::move(B);
+  EXPECT_EQ(C.data(), data);
+  EXPECT_TRUE(B.is_inline());
+  EXPECT_TRUE(B.empty());
+  B.push_back(std::make_unique<int>(42));
+  C.swap(B);
+  EXPECT_EQ(*C[0], 42);
+  EXPECT_EQ(B.size(), 9U);
+  EXPECT_EQ(B.data(), data);
+}
+
+TEST(SmallVectorTest, CopyAndAssign) {
+  s21::small_vector<std::string, 3> A{"a", "b", "c", "d"};
+  s21::small_vector<std::string, 3> B(A);
+  EXPECT_EQ(B.size(), 4U);
+  EXPECT_EQ(B[3], "d");
+  s21::small_vector<std::string, 3> C{"x"};
+  C = A;
+  EXPECT_EQ(C.front(), "a");
+  A.clear();
+  EXPECT_TRUE(A.empty());
+  A = C;
+  EXPECT_EQ(A.size(), 4U);
+  s21::small_vector<int, 4> D(3);
+  EXPECT_EQ(D[2], 0);
+  EXPECT_TRUE(D.is_inline());
+}
+
+TEST(SmallVectorTest, ThrowingEmplaceLeavesVectorUnchanged) {
+  {
+    s21::small_vector<may_throw, 2> A;
+    A.emplace_back(0);
+    A.emplace_back(1);
+    may_throw::armed = true;
+    EXPECT_THROW(A.emplace_back(2), std::runtime_error);
+    EXPECT_THROW(A.emplace(A.begin(), 2), std::runtime_error);
+    may_throw::armed = false;
+    EXPECT_TRUE(A.is_inline());
+    EXPECT_EQ(A.size(), 2U);
+    EXPECT_EQ(A[1].value, 1);
+    EXPECT_EQ(std::allocator<may_throw>::live, 0);
+    for (int i = 2; i < 4; i++) {
+      A.emplace_back(i);
+    }
+    may_throw::armed = true;
+    EXPECT_THROW(A.emplace(A.begin() + 1, 4), std::runtime_error);
+    may_throw::armed = false;
+    EXPECT_EQ(A.size(), 4U);
+    EXPECT_EQ(A[3].value, 3);
+    EXPECT_EQ(std::allocator<may_throw>::live, 1);
+  }
+  EXPECT_EQ(std::allocator<may_throw>::live, 0);
+}
@@ -0,0 +1,140 @@
+#ifndef SRC_SPSC_QUEUE
+#define SRC_SPSC_QUEUE
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace s21 {
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. Elements live in a power-of-two ring; head_ and tail_ only ever
+// grow and are reduced modulo the capacity when a slot is addressed. Each
+// side owns one index, which it publishes with a release store, and keeps a
+// private copy of the other side's index that it refreshes (with an acquire
+// load) only when the ring looks full or empty, so most operations touch no
+// shared cache line besides the slot itself.
+template <class T, class Allocator = std::allocator<T>>
+class spsc_queue {
+  using traits = std::allocator_traits<Allocator>;
+
+ public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+
+  // CONSTRUCTORS
+  // capacity is rounded up to a power of two.
+  explicit spsc_queue(size_type capacity = 1024,
+                      const Allocator& alloc = Allocator())
+      : head_(0), cached_tail_(0), tail_(0), cached_head_(0), alloc_(alloc) {
+    capacity_ = 2;
+    while (capacity_ < capacity) capacity_ *= 2;
+    mask_ = capacity_ - 1;
+    slots_ = traits::allocate(alloc_, capacity_);
+  }
+  spsc_queue(const spsc_queue&) = delete;
+  spsc_queue& operator=(const spsc_queue&) = delete;
+  ~spsc_queue() {
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    for (size_type i = head_.load(std::memory_order_relaxed); i != tail; i++) {
+      traits::destroy(alloc_, slots_ + (i & mask_));
+    }
+    traits::deallocate(alloc_, slots_, capacity_);
+  }
+
+  // PRODUCER
+  bool try_push(const_reference value) { return try_emplace(value); }
+  bool try_push(T&& value) { return try_emplace(std::move(value)); }
+  template <class... Args>
+  bool try_emplace(Args&&... args) {
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    if (tail - cached_head_ == capacity_) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      if (tail - cached_head_ == capacity_) return false;
+    }
+    traits::construct(alloc_, slots_ + (tail & mask_),
+                      std::forward<Args>(args)...);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+  // Copies up to n elements from first and publishes them with a single
+  // store. Returns how many were pushed.
+  template <class InputIt>
+  size_type push_n(InputIt first, size_type n) {
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    if (capacity_ - (tail - cached_head_) < n) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+    }
+    size_type count = std::min(n, capacity_ - (tail - cached_head_));
+    for (size_type i = 0; i < count; i++, ++first) {
+      traits::construct(alloc_, slots_ + ((tail + i) & mask_), *first);
+    }
+    if (count > 0) tail_.store(tail + count, std::memory_order_release);
+    return count;
+  }
+
+  // CONSUMER
+  bool try_pop(reference out) {
+    size_type head = head_.load(std::memory_order_relaxed);
+    if (head == cached_tail_) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (head == cached_tail_) return false;
+    }
+    T* slot = slots_ + (head & mask_);
+    out = std::move(*slot);
+    traits::destroy(alloc_, slot);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+  // Moves up to n elements to out and releases their slots with a single
+  // store. Returns how many were popped.
+  template <class OutputIt>
+  size_type pop_n(OutputIt out, size_type n) {
+    size_type head = head_.load(std::memory_order_relaxed);
+    if (cached_tail_ - head < n) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+    }
+    size_type count = std::min(n, cached_tail_ - head);
+    for (size_type i = 0; i < count; i++, ++out) {
+      T* slot = slots_ + ((head + i) & mask_);
+      *out = std::move(*slot);
+      traits::destroy(alloc_, slot);
+    }
+    if (count > 0) head_.store(head + count, std::memory_order_release);
+    return count;
+  }
+
+  // CAPACITY
+  // Exact only when called by the producer or the consumer while the other
+  // side is idle.
+  size_type size() const {
+    size_type head = head_.load(std::memory_order_acquire);
+    return tail_.load(std::memory_order_acquire) - head;
+  }
+  bool empty() const { return size() == 0; }
+  size_type capacity() const { return capacity_; }
+
+ private:
+  static constexpr size_t cache_line_ = 64;
+
+  // Written by the consumer.
+  alignas(cache_line_) std::atomic<size_type> head_;
+  size_type cached_tail_;
+  // Written by the producer.
+  alignas(cache_line_) std::atomic<size_type> tail_;
+  size_type cached_head_;
+  // Read-only after construction.
+  alignas(cache_line_) T* slots_;
+  size_type capacity_;
+  size_type mask_;
+  Allocator alloc_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_SPSC_QUEUE
@@ -0,0 +1,148 @@
+// Two-thread hand-off through spsc_queue and through s21::queue behind a
+// mutex. throughput streams n elements from a producer thread to the
+// consumer, round_trip bounces one element back and forth through a pair of
+// queues and reports the time per round trip.
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "queue.h"
+#include "spsc_queue.h"
+
+namespace {
+
+using namespace s21::bench;
+
+const size_t kCapacity = 1024;
+const size_t kBatch = 64;
+const size_t kMaxRoundTrips = 100000;
+
+template <class T>
+struct spsc_channel {
+  s21::spsc_queue<T> q{kCapacity};
+  bool try_push(const T& v) { return q.try_push(v); }
+  bool try_pop(T& v) { return q.try_pop(v); }
+};
+
+template <class T>
+struct locked_channel {
+  s21::queue<T> q;
+  std::mutex m;
+  bool try_push(const T& v) {
+    std::lock_guard<std::mutex> lock(m);
+    q.push(v);
+    return true;
+  }
+  bool try_pop(T& v) {
+    std::lock_guard<std::mutex> lock(m);
+    if (q.empty()) return false;
+    v = q.front();
+    q.pop();
+    return true;
+  }
+};
+
+template <class C, class T>
+void push_all(C& c, const std::vector<T>& keys) {
+  for (auto& i : keys) {
+    while (!c.try_push(i)) std::this_thread::yield();
+  }
+}
+
+template <class C, class T>
+std::uint64_t pop_all(C& c, size_t n) {
+  std::uint64_t sum = 0;
+  T v{};
+  for (size_t i = 0; i < n; i++) {
+    while (!c.try_pop(v)) std::this_thread::yield();
+    sum += checksum(v);
+  }
+  return sum;
+}
+
+template <class C, class T>
+void run_channel(const char* impl, const std::vector<T>& keys) {
+  size_t n = keys.size();
+  measure(
+      "spsc_queue", impl, "throughput", key_name<T>(), n, n,
+      [] { return std::make_unique<C>(); },
+      [&](std::unique_ptr<C>& c) {
+        std::thread producer([&] { push_all(*c, keys); });
+        keep(pop_all<C, T>(*c, n));
+        producer.join();
+      });
+  size_t rounds = std::min(n, kMaxRoundTrips);
+  measure(
+      "spsc_queue", impl, "round_trip", key_name<T>(), n, rounds,
+      [] { return std::make_unique<std::pair<C, C>>(); },
+      [&](std::unique_ptr<std::pair<C, C>>& c) {
+        std::thread echo([&] {
+          T v{};
+          for (size_t i = 0; i < rounds; i++) {
+            while (!c->first.try_pop(v)) std::this_thread::yield();
+            while (!c->second.try_push(v)) std::this_thread::yield();
+          }
+        });
+        T v{};
+        for (size_t i = 0; i < rounds; i++) {
+          while (!c->first.try_push(keys[i])) std::this_thread::yield();
+          while (!c->second.try_pop(v)) std::this_thread::yield();
+        }
+        echo.join();
+        keep(v);
+      });
+}
+
+// push_n and pop_n in batches of kBatch, one release store per batch.
+template <class T>
+void run_bulk(const std::vector<T>& keys) {
+  size_t n = keys.size();
+  measure(
+      "spsc_queue", "s21", "throughput_bulk", key_name<T>(), n, n,
+      [] { return std::make_unique<s21::spsc_queue<T>>(kCapacity); },
+      [&](std::unique_ptr<s21::spsc_queue<T>>& q) {
+        std::thread producer([&] {
+          for (size_t i = 0; i < n;) {
+            size_t pushed = q->push_n(keys.begin() + i,
+                                      std::min(kBatch, n - i));
+            if (pushed == 0) std::this_thread::yield();
+            i += pushed;
+          }
+        });
+        std::vector<T> batch(kBatch);
+        std::uint64_t sum = 0;
+        for (size_t i = 0; i < n;) {
+          size_t popped = q->pop_n(batch.begin(), kBatch);
+          if (popped == 0) std::this_thread::yield();
+          for (size_t j = 0; j < popped; j++) {
+            sum += checksum(batch[j]);
+          }
+          i += popped;
+        }
+        producer.join();
+        keep(sum);
+      });
+}
+
+template <class T>
+void run_key() {
+  for (size_t n : sizes()) {
+    auto keys = shuffled_keys<T>(n);
+    run_channel<spsc_channel<T>, T>("s21", keys);
+    run_bulk(keys);
+    run_channel<locked_channel<T>, T>("queue+mutex", keys);
+  }
+}
+
+void run() {
+  run_key<int>();
+  run_key<std::string>();
+}
+
+registrar reg("spsc_queue", run);
+
+}  // namespace
@@ -0,0 +1,81 @@
+#include "spsc_queue.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+class SpscQueueTest : public ::testing::Test {};
+
+TEST(SpscQueueTest, SingleThread) {
+  s21::spsc_queue<std::string> A(5);
+  EXPECT_EQ(A.capacity(), 8);
+  EXPECT_TRUE(A.empty());
+  std::string out;
+  EXPECT_FALSE(A.try_pop(out));
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < 8; i++) {
+      EXPECT_TRUE(A.try_push(std::to_string(i)));
+    }
+    EXPECT_FALSE(A.try_push("full"));
+    EXPECT_EQ(A.size(), 8);
+    for (int i = 0; i < 8; i++) {
+      EXPECT_TRUE(A.try_pop(out));
+      EXPECT_EQ(out, std::to_string(i));
+    }
+  }
+  EXPECT_TRUE(A.try_emplace(3, 'x'));
+  EXPECT_TRUE(A.try_pop(out));
+  EXPECT_EQ(out, "xxx");
+  // Left in the queue for the destructor.
+  A.try_push("left over, long enough to live on the heap");
+}
+
+TEST(SpscQueueTest, Bulk) {
+  s21::spsc_queue<int> A(16);
+  std::vector<int> in(40), out(40);
+  for (int i = 0; i < 40; i++) in[i] = i;
+  EXPECT_EQ(A.push_n(in.begin(), 10), 10);
+  EXPECT_EQ(A.push_n(in.begin() + 10, 30), 6);
+  EXPECT_EQ(A.pop_n(out.begin(), 4), 4);
+  EXPECT_EQ(A.push_n(in.begin() + 16, 24), 4);
+  EXPECT_EQ(A.pop_n(out.begin() + 4, 100), 16);
+  EXPECT_EQ(A.pop_n(out.begin(), 1), 0);
+  for (int i = 0; i < 20; i++) {
+    EXPECT_EQ(out[i], i);
+  }
+}
+
+TEST(SpscQueueTest, TwoThreads) {
+  s21::spsc_queue<long> A(64);
+  const long n = 200000;
+  std::thread producer([&] {
+    std::vector<long> batch(7);
+    for (long i = 0; i < n;) {
+      if (i % 3 == 0) {
+        if (A.try_push(i)) i++;
+      } else {
+        long count = std::min<long>(7, n - i);
+        for (long j = 0; j < count; j++) batch[j] = i + j;
+        i += A.push_n(batch.begin(), count);
+      }
+      std::this_thread::yield();
+    }
+  });
+  long expected = 0;
+  bool ordered = true;
+  std::vector<long> batch(5);
+  while (expected < n) {
+    size_t got = A.pop_n(batch.begin(), 5);
+    for (size_t j = 0; j < got; j++) {
+      ordered = ordered && batch[j] == expected++;
+    }
+    long one;
+    if (A.try_pop(one)) ordered = ordered && one == expected++;
+    if (got == 0) std::this_thread::yield();
+  }
+  producer.join();
+  EXPECT_TRUE(ordered);
+  EXPECT_TRUE(A.empty());
+}
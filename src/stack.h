@@ -1,135 +1,64 @@
+#ifndef SRC_STACK
+#define SRC_STACK
 
 #include <cstddef>
-#include <iostream>
+#include <initializer_list>
 #include <utility>
 
+#include "deque.h"
+
 namespace s21 {
-template <class T>
-struct StackNode {
-  StackNode<T>* next;
-  StackNode<T>* prev;
-  T key;
-  StackNode() {
-    next = nullptr;
-    prev = nullptr;
-  }
-  StackNode(T i, StackNode<T>* p, StackNode<T>* n) {
-    key = i;
-    next = n;
-    prev = p;
-  }
-};
-template <class T>
+
+// LIFO adaptor over any sequence with back(), push_back(), emplace_back()
+// and pop_back(): s21::deque (the default), s21::vector or s21::list.
+template <class T, class Container = deque<T>>
 class stack {
+ public:
+  using container_type = Container;
   using value_type = T;
   using reference = T&;
   using const_reference = const T&;
   using size_type = size_t;
-  using Node = StackNode<T>;
 
- private:
-  Node* front_;
-  Node* back_;
-  size_t size_;
+ protected:
+  Container c_;
 
  public:
   // CONSTRUCTORS
-  stack() : front_(nullptr), back_(nullptr), size_(0) {}
-
-  stack(std::initializer_list<value_type> const& items)
-      : front_(nullptr), back_(nullptr), size_(0) {
-    for (auto i : items) {
-      this->push(i);
-    }
-  }
-
-  stack(const stack& q) : front_(nullptr), back_(nullptr), size_(0) {
-    Node* n = q.front_;
-    while (n != nullptr) {
-      this->push(n->key);
-      n = n->next;
-    }
-  }
-
-  stack(stack&& q) noexcept : front_(q.front_), back_(q.back_), size_(q.size_) {
-    q.front_ = q.back_ = nullptr;
-    q.size_ = 0;
-  }
-
-  ~stack() {
-    while (front_ != nullptr) {
-      this->pop();
+  stack() : c_() {}
+  explicit stack(const Container& c) : c_(c) {}
+  explicit stack(Container&& c) : c_(std::move(c)) {}
+  stack(std::initializer_list<value_type> const& items) : c_() {
+    for (auto& i : items) {
+      c_.push_back(i);
     }
   }
 
-  stack& operator=(stack&& q) noexcept {
-    if (front_ != nullptr) {
-      this->~stack();
-    }
-    front_ = q.front_;
-    back_ = q.back_;
-    size_ = q.size_;
-    q.front_ = q.back_ = nullptr;
-    q.size_ = 0;
-    return *this;
-  }
-  stack& operator=(const stack& q) {
-    if (this->front_ == q.front_) return *this;
-    if (front_ != nullptr) {
-      this->~stack();
-    }
-    Node* n = q.front_;
-    while (n != nullptr) {
-      this->push(n->key);
-      n = n->next;
-    }
-    return *this;
-  }
-
   // ELEMENT ACCESS
-  const_reference top() const { return back_->key; }
+  reference top() { return c_.back(); }
+  const_reference top() const { return c_.back(); }
 
   // CAPACITY
-  [[nodiscard]] bool empty() const {
-    if (size_ == 0) {
-      return true;
-    }
-    return false;
-  }
-  [[nodiscard]] size_type size() const { return size_; }
+  [[nodiscard]] bool empty() const { return c_.empty(); }
+  [[nodiscard]] size_type size() const { return c_.size(); }
 
-  // ELEMENT ACCESS
-  void push(const_reference value) {
-    size_++;
-    Node* n = new Node(value, back_, nullptr);
-    if (back_ != nullptr) {
-      back_->next = n;
-    } else {
-      front_ = n;
-    }
-    back_ = n;
-  }
+  // MODIFIERS
+  void push(const_reference value) { c_.push_back(value); }
+  void push(value_type&& value) { c_.push_back(std::move(value)); }
   void pop() {
-    if (front_ != nullptr) {
-      size_--;
-      Node* temp = back_;
-      back_ = back_->prev;
-      delete temp;
-      if (back_ == nullptr) {
-        front_ = nullptr;
-      }
-    }
+    if (!c_.empty()) c_.pop_back();
   }
-  void swap(stack& other) {
-    stack temp = other;
-    other = *this;
-    *this = temp;
+  void swap(stack& other) noexcept { c_.swap(other.c_); }
+  template <class... Args>
+  void emplace(Args&&... args) {
+    c_.emplace_back(std::forward<Args>(args)...);
   }
   template <class... Args>
   void emplace_front(Args&&... args) {
-    value_type val(args...);
-    this->push(val);
+    c_.emplace_back(std::forward<Args>(args)...);
   }
 };
 
 }  // namespace s21
+
+#endif  // SRC_STACK
@@ -0,0 +1,72 @@
+#include <memory>
+#include <stack>
+#include <string>
+
+#include "bench.h"
+#include "stack.h"
+
+namespace {
+
+using namespace s21::bench;
+
+template <class S, class T>
+void run_stack(const char* impl, size_t n) {
+  const char* key = key_name<T>();
+  auto keys = shuffled_keys<T>(n);
+  measure(
+      "stack", impl, "push", key, n, n, [] { return std::make_unique<S>(); },
+      [&](std::unique_ptr<S>& s) {
+        for (auto& i : keys) {
+          s->push(i);
+        }
+        keep(s->size());
+      });
+  measure(
+      "stack", impl, "pop", key, n, n,
+      [&] {
+        auto s = std::make_unique<S>();
+        for (auto& i : keys) {
+          s->push(i);
+        }
+        return s;
+      },
+      [&](std::unique_ptr<S>& s) {
+        std::uint64_t sum = 0;
+        for (size_t i = 0; i < n; i++) {
+          sum += checksum(s->top());
+          s->pop();
+        }
+        keep(sum);
+      });
+  // Depth stays at one: a push immediately followed by a pop.
+  measure(
+      "stack", impl, "push_pop", key, n, n,
+      [] { return std::make_unique<S>(); },
+      [&](std::unique_ptr<S>& s) {
+        std::uint64_t sum = 0;
+        for (auto& i : keys) {
+          s->push(i);
+          sum += checksum(s->top());
+          s->pop();
+        }
+        keep(sum);
+      });
+}
+
+template <class T>
+void run_key() {
+  for (size_t n : sizes()) {
+    run_stack<s21::stack<T>, T>("s21", n);
+    run_stack<std::stack<T>, T>("std", n);
+  }
+}
+
+void run() {
+  run_key<int>();
+  run_key<std::string>();
+  run_key<blob64>();
+}
+
+registrar reg("stack", run);
+
+}  // namespace
@@ -1,7 +1,11 @@
 #include "stack.h"
 
+#include <string>
+
 #include "gtest/gtest.h"
+#include "list.h"
 #include "stack"
+#include "vector.h"
 // Copyright 2022 nolanhea
 
 template <class T>
@@ -131,3 +135,22 @@ TEST(S21StackTest, Emplace) {
     B.pop();
   }
 }
+
+TEST(S21StackTest, OtherContainers) {
+  s21::stack<std::string, s21::vector<std::string>> A{"a", "b"};
+  s21::stack<std::string, s21::list<std::string>> B{"a", "b"};
+  for (int i = 0; i < 100; i++) {
+    A.push(std::to_string(i));
+    B.emplace_front(std::to_string(i));
+    EXPECT_EQ(A.top(), B.top());
+  }
+  A.top() = "x";
+  EXPECT_EQ(A.top(), "x");
+  for (int i = 0; i < 101; i++) {
+    A.pop();
+    B.pop();
+  }
+  EXPECT_EQ(A.top(), "a");
+  EXPECT_EQ(B.top(), "a");
+  EXPECT_EQ(A.size(), B.size());
+}
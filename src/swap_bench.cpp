@@ -0,0 +1,88 @@
+#include <deque>
+#include <list>
+#include <map>
+#include <queue>
+#include <set>
+#include <stack>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench.h"
+#include "deque.h"
+#include "list.h"
+#include "map.h"
+#include "queue.h"
+#include "set.h"
+#include "stack.h"
+#include "vector.h"
+
+namespace {
+
+using namespace s21::bench;
+
+constexpr size_t kOps = 1000;
+
+// Both containers are filled once and shared by every repetition: swapping
+// and a three-way move rotation leave them holding n elements each, so the
+// reported time per operation must stay flat as n grows.
+template <class S, class T, class Fill>
+void run_swap(const char* container, const char* impl, size_t n, Fill fill) {
+  const char* key = key_name<T>();
+  auto keys = shuffled_keys<T>(n);
+  std::pair<S, S> state;
+  for (auto& i : keys) {
+    fill(state.first, i);
+    fill(state.second, i);
+  }
+  auto setup = [&] { return &state; };
+  measure(container, impl, "swap", key, n, kOps, setup,
+          [](std::pair<S, S>* s) {
+            for (size_t i = 0; i < kOps; i++) {
+              s->first.swap(s->second);
+            }
+            keep(s->first.size());
+          });
+  measure(container, impl, "move_assign", key, n, kOps / 3 * 3, setup,
+          [](std::pair<S, S>* s) {
+            for (size_t i = 0; i < kOps / 3; i++) {
+              S tmp(std::move(s->first));
+              s->first = std::move(s->second);
+              s->second = std::move(tmp);
+            }
+            keep(s->first.size());
+          });
+}
+
+template <class T>
+void run_key() {
+  auto push_back = [](auto& c, const T& k) { c.push_back(k); };
+  auto push = [](auto& c, const T& k) { c.push(k); };
+  auto insert = [](auto& c, const T& k) { c.insert(k); };
+  auto emplace = [](auto& c, const T& k) { c.emplace(k, k); };
+  for (size_t n : sizes()) {
+    run_swap<s21::list<T>, T>("list", "s21", n, push_back);
+    run_swap<std::list<T>, T>("list", "std", n, push_back);
+    run_swap<s21::deque<T>, T>("deque", "s21", n, push_back);
+    run_swap<std::deque<T>, T>("deque", "std", n, push_back);
+    run_swap<s21::vector<T>, T>("vector", "s21", n, push_back);
+    run_swap<std::vector<T>, T>("vector", "std", n, push_back);
+    run_swap<s21::stack<T>, T>("stack", "s21", n, push);
+    run_swap<std::stack<T>, T>("stack", "std", n, push);
+    run_swap<s21::queue<T>, T>("queue", "s21", n, push);
+    run_swap<std::queue<T>, T>("queue", "std", n, push);
+    run_swap<s21::set<T>, T>("set", "s21", n, insert);
+    run_swap<std::set<T>, T>("set", "std", n, insert);
+    run_swap<s21::map<T, T>, T>("map", "s21", n, emplace);
+    run_swap<std::map<T, T>, T>("map", "std", n, emplace);
+  }
+}
+
+void run() {
+  run_key<int>();
+  run_key<std::string>();
+}
+
+registrar reg("swap", run);
+
+}  // namespace
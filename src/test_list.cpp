@@ -1,8 +1,35 @@
 // Copyright 2022 nolanhea
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
 #include <list>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "list.h"
+namespace {
+// Counts copies, so tests can check that moved-in elements are never
+// copied on their way into a container.
+struct copy_counted {
+  static int copies;
+  std::string payload;
+  explicit copy_counted(size_t n = 0) : payload(n, 'x') {}
+  copy_counted(const copy_counted& other) : payload(other.payload) {
+    copies++;
+  }
+  copy_counted(copy_counted&&) = default;
+  copy_counted& operator=(const copy_counted& other) {
+    payload = other.payload;
+    copies++;
+    return *this;
+  }
+  copy_counted& operator=(copy_counted&&) = default;
+};
+int copy_counted::copies = 0;
+}  // namespace
+
 // The fixture for testing class Foo.
 class ListTest : public ::testing::Test {};
 // Tests that the Foo::Bar() method does Abc.
@@ -153,3 +180,117 @@ TEST_F(ListTest, Emplace) {
 //  auto max2 = other.max_size();
 //  EXPECT_EQ(max, max2);
 //}
+
+TEST_F(ListTest, moves_without_copies) {
+  copy_counted::copies = 0;
+  s21::list<copy_counted> my;
+  for (int i = 0; i < 100; i++) {
+    copy_counted c(1024);
+    my.push_back(std::move(c));
+    my.push_front(copy_counted(1024));
+    my.emplace_back(1024);
+    my.emplace_front(1024);
+    my.emplace(my.begin(), 1024);
+    my.insert(my.end(), copy_counted(1024));
+  }
+  EXPECT_EQ(my.size(), 600U);
+  EXPECT_EQ(my.back().payload.size(), 1024U);
+  EXPECT_EQ(copy_counted::copies, 0);
+}
+
+TEST_F(ListTest, SwapAndMove) {
+  s21::list<int> a{1, 2, 3};
+  s21::list<int> b{4, 5};
+  int* first = &a.front();
+  a.swap(b);
+  EXPECT_EQ(b.size(), 3U);
+  EXPECT_EQ(&b.front(), first);
+  EXPECT_EQ(a.back(), 5);
+  s21::list<int> c(std::move(b));
+  EXPECT_EQ(&c.front(), first);
+  EXPECT_TRUE(b.empty());
+  b.push_back(7);
+  EXPECT_EQ(b.front(), 7);
+  a = std::move(c);
+  EXPECT_EQ(&a.front(), first);
+  EXPECT_EQ(a.size(), 3U);
+  EXPECT_TRUE(c.empty());
+  c.push_front(8);
+  EXPECT_EQ(c.back(), 8);
+  b = a;
+  EXPECT_EQ(b.size(), 3U);
+  EXPECT_NE(&b.front(), first);
+}
+
+TEST_F(ListTest, SortIsStableAndRelinksNodes) {
+  s21::list<std::pair<int, int>> my;
+  std::list<std::pair<int, int>> other;
+  srand(5);
+  for (int i = 0; i < 5000; i++) {
+    std::pair<int, int> p(rand() % 100, i);
+    my.push_back(p);
+    other.push_back(p);
+  }
+  std::vector<const std::pair<int, int>*> nodes;
+  for (auto& i : my) {
+    nodes.push_back(&i);
+  }
+  auto by_key = [](const std::pair<int, int>& a,
+                   const std::pair<int, int>& b) { return a.first < b.first; };
+  my.sort(by_key);
+  other.sort(by_key);
+  EXPECT_EQ(my.size(), other.size());
+  EXPECT_TRUE(std::equal(my.begin(), my.end(), other.begin()));
+  std::vector<const std::pair<int, int>*> sorted_nodes;
+  for (auto& i : my) {
+    sorted_nodes.push_back(&i);
+  }
+  std::sort(nodes.begin(), nodes.end());
+  std::sort(sorted_nodes.begin(), sorted_nodes.end());
+  EXPECT_EQ(nodes, sorted_nodes);
+  EXPECT_EQ(my.back().first, 99);
+
+  s21::list<int> ints{5, 1, 4, 1, 3};
+  ints.sort(std::greater<>());
+  EXPECT_EQ(std::vector<int>(ints.begin(), ints.end()),
+            std::vector<int>({5, 4, 3, 1, 1}));
+  ints.sort();
+  EXPECT_EQ(ints.front(), 1);
+  EXPECT_EQ(ints.back(), 5);
+}
+
+TEST_F(ListTest, MergeUniqueAndSplice) {
+  s21::list<int> a{1, 3, 5, 7, 7};
+  s21::list<int> b{0, 3, 8};
+  a.merge(b);
+  EXPECT_TRUE(b.empty());
+  EXPECT_EQ(a.size(), 8U);
+  EXPECT_EQ(std::vector<int>(a.begin(), a.end()),
+            std::vector<int>({0, 1, 3, 3, 5, 7, 7, 8}));
+  b.push_back(2);
+  EXPECT_EQ(b.front(), 2);
+  a.unique();
+  EXPECT_EQ(a.size(), 6U);
+  EXPECT_EQ(std::vector<int>(a.begin(), a.end()),
+            std::vector<int>({0, 1, 3, 5, 7, 8}));
+  a.unique([](int x, int y) { return y - x < 3; });
+  EXPECT_EQ(std::vector<int>(a.begin(), a.end()),
+            std::vector<int>({0, 3, 7}));
+
+  s21::list<int> c{9, 6};
+  s21::list<int> d{8, 4};
+  c.merge(d, std::greater<>());
+  EXPECT_EQ(std::vector<int>(c.begin(), c.end()),
+            std::vector<int>({9, 8, 6, 4}));
+
+  a.splice(++a.begin(), c);
+  EXPECT_TRUE(c.empty());
+  EXPECT_EQ(a.size(), 7U);
+  EXPECT_EQ(std::vector<int>(a.begin(), a.end()),
+            std::vector<int>({0, 9, 8, 6, 4, 3, 7}));
+  a.splice(a.begin(), b);
+  a.splice(a.end(), c);
+  EXPECT_EQ(a.front(), 2);
+  EXPECT_EQ(a.back(), 7);
+  EXPECT_EQ(a.size(), 8U);
+}
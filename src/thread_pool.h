@@ -0,0 +1,151 @@
+#ifndef SRC_THREAD_POOL
+#define SRC_THREAD_POOL
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+// Fork-join pool for divide and conquer algorithms. invoke(f, g) offers g to
+// the workers and runs f on the calling thread; if nobody picked g up in the
+// meantime the caller runs it too, otherwise it helps with queued work until
+// g is done. Waiting threads never block while there is work, so nested
+// invoke calls cannot deadlock.
+class fork_join_pool {
+ public:
+  // CONSTRUCTORS
+  explicit fork_join_pool(size_t threads = std::thread::hardware_concurrency())
+      : stop_(false) {
+    for (size_t i = 1; i < threads; i++) {
+      workers_.emplace_back([this] { work_(); });
+    }
+  }
+  fork_join_pool(const fork_join_pool&) = delete;
+  fork_join_pool& operator=(const fork_join_pool&) = delete;
+  ~fork_join_pool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    ready_.notify_all();
+    for (auto& i : workers_) {
+      i.join();
+    }
+  }
+
+  // METHODS
+  static fork_join_pool& instance() {
+    static fork_join_pool pool;
+    return pool;
+  }
+  // Number of threads taking part in the work, the caller included.
+  size_t concurrency() const { return workers_.size() + 1; }
+
+  template <class F, class G>
+  void invoke(F&& f, G&& g) {
+    if (workers_.empty()) {
+      f();
+      g();
+      return;
+    }
+    task_impl<G> t(g);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push_back(&t);
+    }
+    ready_.notify_one();
+    std::exception_ptr error;
+    try {
+      f();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    if (take_back_(&t)) {
+      t.run();
+    } else {
+      while (!t.done.load(std::memory_order_acquire)) {
+        task* other = try_pop_();
+        if (other != nullptr) {
+          other->run();
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    }
+    if (error) std::rethrow_exception(error);
+    if (t.error) std::rethrow_exception(t.error);
+  }
+
+ private:
+  struct task {
+    std::atomic<bool> done{false};
+    std::exception_ptr error;
+    virtual void call() = 0;
+    void run() {
+      try {
+        call();
+      } catch (...) {
+        error = std::current_exception();
+      }
+      done.store(true, std::memory_order_release);
+    }
+
+   protected:
+    ~task() = default;
+  };
+  template <class G>
+  struct task_impl final : task {
+    G& g;
+    explicit task_impl(G& fn) : g(fn) {}
+    void call() override { g(); }
+  };
+
+  // The task is usually the newest one, so the search is short.
+  bool take_back_(task* t) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto i = tasks_.rbegin(); i != tasks_.rend(); ++i) {
+      if (*i == t) {
+        tasks_.erase(std::next(i).base());
+        return true;
+      }
+    }
+    return false;
+  }
+  task* try_pop_() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tasks_.empty()) return nullptr;
+    task* t = tasks_.front();
+    tasks_.pop_front();
+    return t;
+  }
+  void work_() {
+    for (;;) {
+      task* t;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+        if (stop_) return;
+        t = tasks_.front();
+        tasks_.pop_front();
+      }
+      t->run();
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::deque<task*> tasks_;
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  bool stop_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_THREAD_POOL
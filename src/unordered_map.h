@@ -0,0 +1,119 @@
+#ifndef SRC_UNORDERED_MAP
+#define SRC_UNORDERED_MAP
+
+#include <functional>
+#include <memory>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "hash_table.h"
+
+namespace s21 {
+
+template <class K, class V, class Hash = std::hash<K>,
+          class KeyEqual = std::equal_to<K>,
+          class Allocator = std::allocator<std::pair<K, V>>>
+class unordered_map
+    : public hash_table<K, std::pair<K, V>, false, Hash, KeyEqual,
+                        Allocator> {
+  using base =
+      hash_table<K, std::pair<K, V>, false, Hash, KeyEqual, Allocator>;
+  using mapped_type = V;
+  using value_type = std::pair<K, V>;
+  using iterator = typename base::iterator;
+  using base::base;
+
+ public:
+  V& at(const K& key) {
+    auto found = this->find(key);
+    if (found == this->end()) {
+      throw std::out_of_range("index out of range");
+    }
+    return (*found).second;
+  }
+  const V& at(const K& key) const {
+    auto found = this->find(key);
+    if (found == this->end()) {
+      throw std::out_of_range("index out of range");
+    }
+    return (*found).second;
+  }
+  V& operator[](const K& key) {
+    auto found = this->find(key);
+    if (found == this->end()) {
+      return (*this->insert_iter(value_type(key, V())).first).second;
+    }
+    return (*found).second;
+  }
+  V& operator[](K&& key) {
+    auto found = this->find(key);
+    if (found == this->end()) {
+      return (*this->insert_iter(value_type(std::move(key), V())).first)
+          .second;
+    }
+    return (*found).second;
+  }
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return this->insert_iter(value);
+  }
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return this->insert_iter(std::move(value));
+  }
+  std::pair<iterator, bool> insert(const K& key, const V& obj) {
+    return this->insert_iter(value_type(key, obj));
+  }
+  // Constrained so that insert("key", "value") is not taken for a range.
+  template <class InputIt,
+            class = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIt>::reference,
+                value_type>::value>>
+  void insert(InputIt first, InputIt last) {
+    this->insert_range_(first, last);
+  }
+  std::pair<iterator, bool> insert_or_assign(const K& key, const V& obj) {
+    auto ret = this->insert_iter(value_type(key, obj));
+    if (!ret.second) {
+      (*ret.first).second = obj;
+    }
+    return ret;
+  }
+};
+
+template <class K, class V, class Hash = std::hash<K>,
+          class KeyEqual = std::equal_to<K>,
+          class Allocator = std::allocator<std::pair<K, V>>>
+class unordered_multimap
+    : public hash_table<K, std::pair<K, V>, true, Hash, KeyEqual,
+                        Allocator> {
+  using base =
+      hash_table<K, std::pair<K, V>, true, Hash, KeyEqual, Allocator>;
+  using mapped_type = V;
+  using value_type = std::pair<K, V>;
+  using iterator = typename base::iterator;
+  using base::base;
+
+ public:
+  iterator insert(const value_type& value) {
+    return this->insert_iter(value).first;
+  }
+  iterator insert(value_type&& value) {
+    return this->insert_iter(std::move(value)).first;
+  }
+  iterator insert(const K& key, const V& obj) {
+    return this->insert_iter(value_type(key, obj)).first;
+  }
+  // Constrained so that insert("key", "value") is not taken for a range.
+  template <class InputIt,
+            class = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIt>::reference,
+                value_type>::value>>
+  void insert(InputIt first, InputIt last) {
+    this->insert_range_(first, last);
+  }
+};
+
+}  // namespace s21
+
+#endif  // SRC_UNORDERED_MAP
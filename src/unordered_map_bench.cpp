@@ -0,0 +1,92 @@
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "bench.h"
+#include "unordered_map.h"
+
+namespace {
+
+using namespace s21::bench;
+
+template <class M, class T>
+void run_unordered_map(const char* impl, size_t n) {
+  const char* key = key_name<T>();
+  auto keys = shuffled_keys<T>(2 * n);
+  std::vector<T> present(keys.begin(), keys.begin() + n);
+  std::vector<T> absent(keys.begin() + n, keys.end());
+  auto filled = [&] {
+    auto m = std::make_unique<M>();
+    int v = 0;
+    for (auto& i : present) {
+      m->insert(std::pair<T, int>(i, v++));
+    }
+    return m;
+  };
+  measure(
+      "unordered_map", impl, "insert", key, n, n,
+      [] { return std::make_unique<M>(); },
+      [&](std::unique_ptr<M>& m) {
+        int v = 0;
+        for (auto& i : present) {
+          m->insert(std::pair<T, int>(i, v++));
+        }
+        keep(m->size());
+      });
+  auto full = filled();
+  measure(
+      "unordered_map", impl, "find_hit", key, n, n, [&] { return full.get(); },
+      [&](M* m) {
+        std::uint64_t sum = 0;
+        for (auto& i : present) {
+          sum += (*m->find(i)).second;
+        }
+        keep(sum);
+      });
+  measure(
+      "unordered_map", impl, "find_miss", key, n, n,
+      [&] { return full.get(); },
+      [&](M* m) {
+        std::uint64_t sum = 0;
+        for (auto& i : absent) {
+          sum += m->find(i) == m->end();
+        }
+        keep(sum);
+      });
+  measure(
+      "unordered_map", impl, "iterate", key, n, n, [&] { return full.get(); },
+      [](M* m) {
+        std::uint64_t sum = 0;
+        for (auto i = m->begin(); i != m->end(); ++i) {
+          sum += checksum(*i);
+        }
+        keep(sum);
+      });
+  full.reset();
+  measure(
+      "unordered_map", impl, "erase", key, n, n, filled,
+      [&](std::unique_ptr<M>& m) {
+        for (auto& i : present) {
+          m->erase(i);
+        }
+        keep(m->size());
+      });
+}
+
+template <class T>
+void run_key() {
+  for (size_t n : sizes()) {
+    run_unordered_map<s21::unordered_map<T, int, key_hash>, T>("s21", n);
+    run_unordered_map<std::unordered_map<T, int, key_hash>, T>("std", n);
+  }
+}
+
+void run() {
+  run_key<int>();
+  run_key<std::string>();
+  run_key<blob64>();
+}
+
+registrar reg("unordered_map", run);
+
+}  // namespace
@@ -0,0 +1,60 @@
+#ifndef SRC_UNORDERED_SET
+#define SRC_UNORDERED_SET
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "hash_table.h"
+
+namespace s21 {
+
+template <class K, class Hash = std::hash<K>,
+          class KeyEqual = std::equal_to<K>,
+          class Allocator = std::allocator<K>>
+class unordered_set
+    : public hash_table<K, K, false, Hash, KeyEqual, Allocator> {
+  using base = hash_table<K, K, false, Hash, KeyEqual, Allocator>;
+  using value_type = K;
+  using iterator = typename base::iterator;
+  using base::base;
+
+ public:
+  std::pair<iterator, bool> insert(const value_type& key) {
+    return this->insert_iter(key);
+  }
+  std::pair<iterator, bool> insert(value_type&& key) {
+    return this->insert_iter(std::move(key));
+  }
+  template <class InputIt>
+  void insert(InputIt first, InputIt last) {
+    this->insert_range_(first, last);
+  }
+};
+
+template <class K, class Hash = std::hash<K>,
+          class KeyEqual = std::equal_to<K>,
+          class Allocator = std::allocator<K>>
+class unordered_multiset
+    : public hash_table<K, K, true, Hash, KeyEqual, Allocator> {
+  using base = hash_table<K, K, true, Hash, KeyEqual, Allocator>;
+  using value_type = K;
+  using iterator = typename base::iterator;
+  using base::base;
+
+ public:
+  iterator insert(const value_type& key) {
+    return this->insert_iter(key).first;
+  }
+  iterator insert(value_type&& key) {
+    return this->insert_iter(std::move(key)).first;
+  }
+  template <class InputIt>
+  void insert(InputIt first, InputIt last) {
+    this->insert_range_(first, last);
+  }
+};
+
+}  // namespace s21
+
+#endif  // SRC_UNORDERED_SET
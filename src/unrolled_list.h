@@ -0,0 +1,469 @@
+#ifndef SRC_UNROLLED_LIST
+#define SRC_UNROLLED_LIST
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+struct unrolled_link {
+  unrolled_link* prev;
+  unrolled_link* next;
+};
+
+// Up to B elements, packed at the start of storage.
+template <class T, size_t B>
+struct unrolled_node : unrolled_link {
+  size_t count;
+  alignas(T) unsigned char storage[B * sizeof(T)];
+
+  T* data() { return reinterpret_cast<T*>(storage); }
+};
+
+template <class T, size_t B, bool Const>
+class unrolled_list_iterator;
+
+// Doubly linked list of nodes that each hold up to B elements, so a walk
+// touches one node per B elements instead of one per element. A full node
+// is split in half to make room, and a node that drops below a quarter
+// full is merged into a neighbour that can take it, so erasing does not
+// leave a trail of nearly empty nodes. Inserting and erasing move at most B
+// elements and invalidate iterators into the node they touch; references
+// to other nodes stay valid. The nodes hang off a link inside the list
+// object, which moves and swaps relink.
+template <class T, size_t B = std::max<size_t>(8, 512 / sizeof(T))>
+class unrolled_list {
+  static_assert(B >= 4, "unrolled_list nodes need room for four elements");
+  using link = unrolled_link;
+  using Node = unrolled_node<T, B>;
+
+ public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = size_t;
+  using iterator = unrolled_list_iterator<T, B, false>;
+  using const_iterator = unrolled_list_iterator<T, B, true>;
+
+ private:
+  link head_;
+  size_type size_;
+
+ public:
+  // CONSTRUCTORS
+  unrolled_list() : size_(0) { head_.prev = head_.next = &head_; }
+  unrolled_list(std::initializer_list<value_type> const& items)
+      : unrolled_list() {
+    for (auto& i : items) {
+      push_back(i);
+    }
+  }
+  unrolled_list(const unrolled_list& other) : unrolled_list() {
+    for (auto& i : other) {
+      push_back(i);
+    }
+  }
+  unrolled_list(unrolled_list&& other) noexcept : unrolled_list() {
+    swap(other);
+  }
+  ~unrolled_list() { clear(); }
+
+  // OPERATORS
+  unrolled_list& operator=(const unrolled_list& other) {
+    if (this != &other) {
+      unrolled_list copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+  unrolled_list& operator=(unrolled_list&& other) noexcept {
+    if (this != &other) {
+      clear();
+      swap(other);
+    }
+    return *this;
+  }
+
+  // ITERATORS
+  iterator begin() { return iterator(head_.next, 0); }
+  iterator end() { return iterator(&head_, 0); }
+  const_iterator begin() const { return const_iterator(head_.next, 0); }
+  const_iterator end() const { return const_iterator(&head_, 0); }
+
+  // ELEMENT ACCESS
+  reference front() { return node_(head_.next)->data()[0]; }
+  const_reference front() const { return node_(head_.next)->data()[0]; }
+  reference back() {
+    Node* n = node_(head_.prev);
+    return n->data()[n->count - 1];
+  }
+  const_reference back() const {
+    Node* n = node_(head_.prev);
+    return n->data()[n->count - 1];
+  }
+
+  // CAPACITY
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+  [[nodiscard]] size_type size() const { return size_; }
+  [[nodiscard]] size_type max_size() const {
+    return std::numeric_limits<std::ptrdiff_t>::max() / sizeof(T);
+  }
+
+  // MODIFIERS
+  void clear() {
+    link* l = head_.next;
+    while (l != &head_) {
+      link* next = l->next;
+      free_node_(node_(l));
+      l = next;
+    }
+    head_.prev = head_.next = &head_;
+    size_ = 0;
+  }
+  void push_back(const_reference value) { emplace_back(value); }
+  void push_back(value_type&& value) { emplace_back(std::move(value)); }
+  void push_front(const_reference value) { emplace_front(value); }
+  void push_front(value_type&& value) { emplace_front(std::move(value)); }
+  template <class... Args>
+  reference emplace_back(Args&&... args) {
+    if (head_.prev == &head_ || node_(head_.prev)->count == B) {
+      Node* n = new_node_before_(&head_);
+      return construct_(n, 0, std::forward<Args>(args)...);
+    }
+    Node* n = node_(head_.prev);
+    return construct_(n, n->count, std::forward<Args>(args)...);
+  }
+  template <class... Args>
+  reference emplace_front(Args&&... args) {
+    if (head_.next == &head_ || node_(head_.next)->count == B) {
+      Node* n = new_node_before_(head_.next);
+      return construct_(n, 0, std::forward<Args>(args)...);
+    }
+    T value(std::forward<Args>(args)...);
+    return *place_(node_(head_.next), 0, std::move(value));
+  }
+  iterator insert(const_iterator pos, const_reference value) {
+    return emplace(pos, value);
+  }
+  iterator insert(const_iterator pos, value_type&& value) {
+    return emplace(pos, std::move(value));
+  }
+  // The element is built before anything moves, so args may refer into
+  // the list.
+  template <class... Args>
+  iterator emplace(const_iterator pos, Args&&... args) {
+    if (pos.node_ == &head_) {
+      emplace_back(std::forward<Args>(args)...);
+      return iterator(head_.prev, node_(head_.prev)->count - 1);
+    }
+    T value(std::forward<Args>(args)...);
+    Node* n = node_(pos.node_);
+    size_t i = pos.pos_;
+    if (n->count == B) {
+      Node* m = split_(n, B / 2);
+      if (i > n->count) {
+        i -= n->count;
+        n = m;
+      }
+    }
+    return place_(n, i, std::move(value));
+  }
+  // Returns the element after the erased one.
+  iterator erase(const_iterator pos) {
+    Node* n = node_(pos.node_);
+    size_t i = pos.pos_;
+    T* d = n->data();
+    std::move(d + i + 1, d + n->count, d + i);
+    d[n->count - 1].~T();
+    n->count--;
+    size_--;
+    if (n->count == 0) {
+      link* next = n->next;
+      unlink_(n);
+      delete n;
+      return iterator(next, 0);
+    }
+    if (n->count < B / 4) {
+      if (n->prev != &head_ && node_(n->prev)->count + n->count <= B) {
+        Node* prev = node_(n->prev);
+        i += prev->count;
+        absorb_next_(prev);
+        n = prev;
+      } else if (n->next != &head_ &&
+                 node_(n->next)->count + n->count <= B) {
+        absorb_next_(n);
+      }
+    }
+    if (i == n->count) return iterator(n->next, 0);
+    return iterator(n, i);
+  }
+  void pop_front() { erase(begin()); }
+  void pop_back() { erase(--end()); }
+  void swap(unrolled_list& other) noexcept {
+    link tmp;
+    move_ring_(head_, tmp);
+    move_ring_(other.head_, head_);
+    move_ring_(tmp, other.head_);
+    std::swap(size_, other.size_);
+  }
+
+  // Moves all of other in front of pos. The nodes are relinked; only the
+  // node pos points into is split, so this is O(B).
+  void splice(const_iterator pos, unrolled_list& other) {
+    if (&other == this || other.empty()) {
+      return;
+    }
+    link* at = pos.node_;
+    if (pos.pos_ != 0) {
+      at = split_(node_(at), pos.pos_);
+    }
+    link* first = other.head_.next;
+    link* last = other.head_.prev;
+    first->prev = at->prev;
+    last->next = at;
+    at->prev->next = first;
+    at->prev = last;
+    size_ += other.size_;
+    other.head_.prev = other.head_.next = &other.head_;
+    other.size_ = 0;
+  }
+  // Merges the sorted other into this sorted list in one pass, moving the
+  // elements into freshly packed nodes while the drained ones are freed.
+  // Equal elements of this list stay first. Once one side runs out, the
+  // remaining nodes of the other are relinked instead of moved.
+  void merge(unrolled_list& other) { merge(other, std::less<>()); }
+  template <class Compare>
+  void merge(unrolled_list& other, Compare comp) {
+    if (&other == this || other.empty()) {
+      return;
+    }
+    size_type size = size_ + other.size_;
+    cursor_ a(*this);
+    cursor_ b(other);
+    while (a.node != nullptr && b.node != nullptr) {
+      cursor_& from = comp(*b, *a) ? b : a;
+      emplace_back(std::move(*from));
+      from.advance();
+    }
+    cursor_& rest = a.node != nullptr ? a : b;
+    while (rest.node != nullptr && rest.pos != 0) {
+      emplace_back(std::move(*rest));
+      rest.advance();
+    }
+    for (Node* n = rest.node; n != nullptr;) {
+      Node* next = node_(n->next);
+      n->prev = head_.prev;
+      n->next = &head_;
+      head_.prev->next = n;
+      head_.prev = n;
+      n = next;
+    }
+    size_ = size;
+  }
+  // Stable sort through one temporary buffer: the elements are moved out,
+  // sorted contiguously and moved back into the same nodes.
+  void sort() { sort(std::less<>()); }
+  template <class Compare>
+  void sort(Compare comp) {
+    std::vector<T> buffer;
+    buffer.reserve(size_);
+    for (auto& i : *this) {
+      buffer.push_back(std::move(i));
+    }
+    std::stable_sort(buffer.begin(), buffer.end(), comp);
+    auto src = buffer.begin();
+    for (auto& i : *this) {
+      i = std::move(*src++);
+    }
+  }
+  void reverse() {
+    link* l = &head_;
+    do {
+      std::swap(l->prev, l->next);
+      l = l->prev;
+      if (l != &head_) {
+        std::reverse(node_(l)->data(), node_(l)->data() + node_(l)->count);
+      }
+    } while (l != &head_);
+  }
+
+ private:
+  // Walks a list that merge is draining, freeing each node once all its
+  // elements have been moved out. node is nullptr at the end.
+  struct cursor_ {
+    Node* node;
+    size_t pos;
+
+    explicit cursor_(unrolled_list& l) : node(nullptr), pos(0) {
+      if (l.head_.next != &l.head_) {
+        node = node_(l.head_.next);
+        l.head_.prev->next = nullptr;
+      }
+      l.head_.prev = l.head_.next = &l.head_;
+      l.size_ = 0;
+    }
+    T& operator*() const { return node->data()[pos]; }
+    void advance() {
+      if (++pos == node->count) {
+        Node* next = node_(node->next);
+        free_node_(node);
+        node = next;
+        pos = 0;
+      }
+    }
+  };
+
+  // HELPER FUNCTIONS
+  static Node* node_(link* l) { return static_cast<Node*>(l); }
+  static void free_node_(Node* n) {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+      for (size_t i = 0; i < n->count; i++) {
+        n->data()[i].~T();
+      }
+    }
+    delete n;
+  }
+  static void unlink_(link* l) {
+    l->prev->next = l->next;
+    l->next->prev = l->prev;
+  }
+  Node* new_node_before_(link* pos) {
+    Node* n = new Node;
+    n->count = 0;
+    n->next = pos;
+    n->prev = pos->prev;
+    pos->prev->next = n;
+    pos->prev = n;
+    return n;
+  }
+  template <class... Args>
+  T& construct_(Node* n, size_t i, Args&&... args) {
+    T* slot = ::new (static_cast<void*>(n->data() + i))
+        T(std::forward<Args>(args)...);
+    n->count++;
+    size_++;
+    return *slot;
+  }
+  // Moves value into position i of n, which has room, shifting the
+  // elements from i on up by one.
+  iterator place_(Node* n, size_t i, T&& value) {
+    T* d = n->data();
+    if (i == n->count) {
+      construct_(n, i, std::move(value));
+    } else {
+      construct_(n, n->count, std::move(d[n->count - 1]));
+      std::move_backward(d + i, d + n->count - 2, d + n->count - 1);
+      d[i] = std::move(value);
+    }
+    return iterator(n, i);
+  }
+  // Moves the elements of n from i on into a new node after it.
+  Node* split_(Node* n, size_t i) {
+    Node* m = new_node_before_(n->next);
+    relocate_(n->data() + i, n->count - i, m->data());
+    m->count = n->count - i;
+    n->count = i;
+    return m;
+  }
+  // Appends the elements of the node after n to n and frees that node.
+  void absorb_next_(Node* n) {
+    Node* next = node_(n->next);
+    relocate_(next->data(), next->count, n->data() + n->count);
+    n->count += next->count;
+    unlink_(next);
+    delete next;
+  }
+  static void relocate_(T* src, size_t count, T* dest) {
+    for (size_t i = 0; i < count; i++) {
+      ::new (static_cast<void*>(dest + i)) T(std::move(src[i]));
+      src[i].~T();
+    }
+  }
+  // Hands the ring closed by from over to to, leaving from empty.
+  static void move_ring_(link& from, link& to) {
+    if (from.next == &from) {
+      to.prev = to.next = &to;
+    } else {
+      to.next = from.next;
+      to.prev = from.prev;
+      to.next->prev = &to;
+      to.prev->next = &to;
+    }
+    from.prev = from.next = &from;
+  }
+};
+
+template <class T, size_t B, bool Const>
+class unrolled_list_iterator {
+  friend class unrolled_list<T, B>;
+  friend class unrolled_list_iterator<T, B, !Const>;
+  using Node = unrolled_node<T, B>;
+
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = T;
+  using pointer = std::conditional_t<Const, const T*, T*>;
+  using reference = std::conditional_t<Const, const T&, T&>;
+
+  unrolled_list_iterator() : node_(nullptr), pos_(0) {}
+  unrolled_list_iterator(const unrolled_link* node, size_t pos)
+      : node_(const_cast<unrolled_link*>(node)), pos_(pos) {}
+  operator unrolled_list_iterator<T, B, true>() const {
+    return unrolled_list_iterator<T, B, true>(node_, pos_);
+  }
+
+  reference operator*() const {
+    return static_cast<Node*>(node_)->data()[pos_];
+  }
+  pointer operator->() const { return &**this; }
+  unrolled_list_iterator& operator++() {
+    if (++pos_ == static_cast<Node*>(node_)->count) {
+      node_ = node_->next;
+      pos_ = 0;
+    }
+    return *this;
+  }
+  unrolled_list_iterator operator++(int) {
+    unrolled_list_iterator tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  unrolled_list_iterator& operator--() {
+    if (pos_ == 0) {
+      node_ = node_->prev;
+      pos_ = static_cast<Node*>(node_)->count;
+    }
+    --pos_;
+    return *this;
+  }
+  unrolled_list_iterator operator--(int) {
+    unrolled_list_iterator tmp = *this;
+    --*this;
+    return tmp;
+  }
+  friend bool operator==(const unrolled_list_iterator& a,
+                         const unrolled_list_iterator& b) {
+    return a.node_ == b.node_ && a.pos_ == b.pos_;
+  }
+  friend bool operator!=(const unrolled_list_iterator& a,
+                         const unrolled_list_iterator& b) {
+    return !(a == b);
+  }
+
+ private:
+  unrolled_link* node_;
+  size_t pos_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_UNROLLED_LIST
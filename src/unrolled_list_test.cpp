@@ -0,0 +1,149 @@
+#include "unrolled_list.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+template <class L, class S>
+void expect_same(const L& a, const S& b) {
+  ASSERT_EQ(a.size(), b.size());
+  EXPECT_TRUE(std::equal(a.begin(), a.end(), b.begin()));
+  if (!b.empty()) {
+    EXPECT_EQ(a.front(), b.front());
+    EXPECT_EQ(a.back(), b.back());
+  }
+}
+
+}  // namespace
+
+class UnrolledListTest : public ::testing::Test {};
+
+TEST(UnrolledListTest, RandomEditsMatchStdList) {
+  s21::unrolled_list<std::string, 8> A;
+  std::list<std::string> B;
+  srand(11);
+  for (int step = 0; step < 20000; step++) {
+    std::string s = std::to_string(step);
+    int op = rand() % 10;
+    size_t pos = B.empty() ? 0 : rand() % (B.size() + 1);
+    auto a = A.begin();
+    auto b = B.begin();
+    for (size_t i = 0; i < pos; i++, ++a, ++b) {
+    }
+    if (op < 2) {
+      A.push_back(s);
+      B.push_back(s);
+    } else if (op < 3) {
+      A.push_front(s);
+      B.push_front(s);
+    } else if (op < 7 || B.empty()) {
+      EXPECT_EQ(*A.insert(a, s), *B.insert(b, s));
+    } else if (b != B.end()) {
+      auto a_next = A.erase(a);
+      auto b_next = B.erase(b);
+      EXPECT_EQ(a_next == A.end(), b_next == B.end());
+      if (b_next != B.end()) {
+        EXPECT_EQ(*a_next, *b_next);
+      }
+    }
+    if (step % 1000 == 0) expect_same(A, B);
+    if (B.size() > 500) {
+      while (B.size() > 50) {
+        A.pop_back();
+        B.pop_back();
+        A.pop_front();
+        B.pop_front();
+      }
+    }
+  }
+  expect_same(A, B);
+  auto it = A.end();
+  auto jt = B.end();
+  while (jt != B.begin()) {
+    EXPECT_EQ(*--it, *--jt);
+  }
+}
+
+TEST(UnrolledListTest, SpliceMergeSortReverse) {
+  s21::unrolled_list<int, 4> A{1, 4, 6, 9, 12, 15};
+  s21::unrolled_list<int, 4> B{0, 4, 5, 20};
+  std::list<int> C{1, 4, 6, 9, 12, 15};
+  std::list<int> D{0, 4, 5, 20};
+  A.merge(B);
+  C.merge(D);
+  expect_same(A, C);
+  EXPECT_TRUE(B.empty());
+
+  s21::unrolled_list<int, 4> E{100, 101, 102};
+  std::list<int> F{100, 101, 102};
+  auto a = A.begin();
+  auto c = C.begin();
+  std::advance(a, 3);
+  std::advance(c, 3);
+  A.splice(a, E);
+  C.splice(c, F);
+  expect_same(A, C);
+  EXPECT_TRUE(E.empty());
+  E.push_back(7);
+  A.splice(A.end(), E);
+  C.push_back(7);
+  expect_same(A, C);
+
+  A.sort(std::greater<>());
+  C.sort(std::greater<>());
+  expect_same(A, C);
+  A.reverse();
+  C.reverse();
+  expect_same(A, C);
+
+  s21::unrolled_list<std::pair<int, int>> G;
+  std::list<std::pair<int, int>> H;
+  for (int i = 0; i < 3000; i++) {
+    std::pair<int, int> p(rand() % 50, i);
+    G.push_back(p);
+    H.push_back(p);
+  }
+  auto by_key = [](const std::pair<int, int>& x,
+                   const std::pair<int, int>& y) { return x.first < y.first; };
+  G.sort(by_key);
+  H.sort(by_key);
+  expect_same(G, H);
+  s21::unrolled_list<std::pair<int, int>> I(G);
+  std::list<std::pair<int, int>> J(H);
+  G.merge(I, by_key);
+  H.merge(J, by_key);
+  expect_same(G, H);
+}
+
+TEST(UnrolledListTest, CopyMoveSwap) {
+  s21::unrolled_list<std::string, 4> A;
+  for (int i = 0; i < 50; i++) {
+    A.emplace_back(10, 'a' + i % 26);
+  }
+  s21::unrolled_list<std::string, 4> B(A);
+  s21::unrolled_list<std::string, 4> C(std::move(A));
+  EXPECT_TRUE(A.empty());
+  A.push_back("again");
+  EXPECT_EQ(A.front(), "again");
+  EXPECT_TRUE(std::equal(B.begin(), B.end(), C.begin()));
+  A.swap(C);
+  EXPECT_EQ(A.size(), 50U);
+  EXPECT_EQ(C.size(), 1U);
+  C = A;
+  B = std::move(A);
+  EXPECT_EQ(C.size(), 50U);
+  EXPECT_EQ(B.back(), std::string(10, 'a' + 49 % 26));
+  const s21::unrolled_list<std::string, 4>& D = B;
+  EXPECT_EQ(std::distance(D.begin(), D.end()), 50);
+  B.clear();
+  EXPECT_TRUE(B.empty());
+  EXPECT_TRUE(B.begin() == B.end());
+}
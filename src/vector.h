@@ -1,10 +1,18 @@
 #ifndef S21_VECTOR
 #define S21_VECTOR
+#include <algorithm>
 #include <cstddef>
 #include <cstring>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
 
+#include "raw_storage.h"
+
 namespace s21 {
 
 using std::cout;
@@ -28,6 +36,8 @@ class vector {
   using const_iterator = const_iterator_vector<T>;
 
  private:
+  // Only [front_, front_ + size_) holds constructed elements, the rest of
+  // the alloc_size_ slots is raw memory.
   value_type* front_;
   size_t size_;
   size_t alloc_size_;
@@ -36,30 +46,20 @@ class vector {
   // CONSTRUCTORS, ASSIGNMENT OPERATORS
   vector() : front_(nullptr), size_(0), alloc_size_(0) {}
 
-  vector(std::initializer_list<value_type> const& items) {
-    size_ = alloc_size_ = items.size();
-    if (size_ > 0) {
-      front_ = new value_type[size_];
-      pointer ptr = front_;
-      for (auto i : items) {
-        *(ptr++) = i;
-      }
-    } else {
-      front_ = nullptr;
-    }
+  explicit vector(size_type n) : vector() { resize(n); }
+
+  vector(std::initializer_list<value_type> const& items)
+      : front_(allocate_(items.size())),
+        size_(items.size()),
+        alloc_size_(items.size()) {
+    copy_construct_(items.begin(), size_, front_);
   }
 
   vector(const vector& other)
-      : size_(other.size_), alloc_size_(other.alloc_size_) {
-    if (size_ > 0) {
-      front_ = new T[other.alloc_size_];
-      pointer ptr = front_;
-      for (auto i : other) {
-        *(ptr++) = i;
-      }
-    } else {
-      front_ = nullptr;
-    }
+      : front_(allocate_(other.size_)),
+        size_(other.size_),
+        alloc_size_(other.size_) {
+    copy_construct_(other.front_, size_, front_);
   }
 
   vector(vector&& other) noexcept
@@ -72,19 +72,14 @@ class vector {
   }
 
   ~vector() {
-    if (!front_) {
-      delete[] front_;
-    }
-    front_ = nullptr;
-    size_ = 0;
-    alloc_size_ = 0;
+    destroy_(front_, front_ + size_);
+    deallocate_(front_, alloc_size_);
   }
 
   vector& operator=(vector&& other) noexcept {
-    if (this == other) return *this;
-    if (!front_) {
-      delete[] front_;
-    }
+    if (this == &other) return *this;
+    destroy_(front_, front_ + size_);
+    deallocate_(front_, alloc_size_);
     front_ = other.front_;
     size_ = other.size_;
     alloc_size_ = other.alloc_size_;
@@ -93,44 +88,42 @@ class vector {
     other.alloc_size_ = 0;
     return *this;
   }
+  // Reuses the current buffer when it is large enough.
   vector& operator=(const vector& other) {
-    if (this->front_ == other.front_) return *this;
-    if (!front_) {
-      delete[] front_;
+    if (this == &other) return *this;
+    clear();
+    if (other.size_ > alloc_size_) {
+      T* buffer = allocate_(other.size_);
+      deallocate_(front_, alloc_size_);
+      front_ = buffer;
+      alloc_size_ = other.size_;
     }
+    copy_construct_(other.front_, other.size_, front_);
     size_ = other.size_;
-    alloc_size_ = other.alloc_size_;
-    if (size_ > 0) {
-      front_ = new T[other.alloc_size_];
-      pointer ptr = front_;
-      for (auto i : other) {
-        *ptr = i;
-        ptr++;
-      }
-    } else {
-      front_ = nullptr;
-    }
     return *this;
   }
 
   // METHODS FOR ACCESS OF ELEMENTS
   reference at(size_type pos) {
-    if (pos < 0 || pos > size_ - 1) {
+    if (pos >= size_) {
       throw std::out_of_range("index out of range");
     }
     return *(front_ + pos);
   }
   const_reference at(size_type pos) const {
-    if (pos < 0 || pos > size_ - 1) {
+    if (pos >= size_) {
       throw std::out_of_range("index out of range");
     }
     return *(front_ + pos);
   }
   reference operator[](size_type pos) { return *(front_ + pos); }
   const_reference operator[](size_type pos) const { return *(front_ + pos); }
+  reference front() { return *front_; }
   const_reference front() const { return *front_; }
+  reference back() { return *(front_ + size_ - 1); }
   const_reference back() const { return *(front_ + size_ - 1); }
   T* data() { return front_; }
+  const T* data() const { return front_; }
 
   // Vector iterators
   iterator begin() { return iterator(front_); }
@@ -147,31 +140,40 @@ class vector {
   }
   [[nodiscard]] size_type size() const { return size_; }
   [[nodiscard]] size_type max_size() const {
-    return std::numeric_limits<T>::max();
+    return std::numeric_limits<std::ptrdiff_t>::max() / sizeof(T);
   }
   void reserve(size_type size) {
-    if (size > alloc_size_) {
-      alloc_size_ = size;
-      T* reallocated = new T[alloc_size_];
-      std::memcpy(reallocated, front_, size_ * sizeof(T));
-      delete[] front_;
-      front_ = reallocated;
-    }
+    if (size > alloc_size_) reallocate_(size);
   }
   [[nodiscard]] size_type capacity() const { return alloc_size_; }
   void shrink_to_fit() {
-    if (alloc_size_ > size_) {
-      alloc_size_ = size_;
-      T* reallocated = new T[alloc_size_];
-      std::memmove(reallocated, front_, size_ * sizeof(T));
-      delete[] front_;
-      front_ = reallocated;
+    if (alloc_size_ > size_) reallocate_(size_);
+  }
+  // Value-initializes new elements, so arithmetic types become zero.
+  void resize(size_type n) {
+    resize_with_(n, [](T* p) { ::new (static_cast<void*>(p)) T(); });
+  }
+  void resize(size_type n, const_reference value) {
+    if (n > alloc_size_ && front_ <= &value && &value < front_ + size_) {
+      T copy(value);
+      resize(n, copy);
+      return;
     }
+    resize_with_(n, [&value](T* p) { ::new (static_cast<void*>(p)) T(value); });
+  }
+  // Default-initializes new elements: trivial types are left uninitialized,
+  // for buffers that are overwritten right away.
+  void resize_default_init(size_type n) {
+    resize_with_(n, [](T* p) { ::new (static_cast<void*>(p)) T; });
   }
 
-  void push_back(const_reference value) { this->insert(this->end(), value); }
+  void push_back(const_reference value) { emplace_at_(size_, value); }
+  void push_back(value_type&& value) { emplace_at_(size_, std::move(value)); }
   void pop_back() {
-    if (size_ > 0) size_--;
+    if (size_ > 0) {
+      size_--;
+      front_[size_].~T();
+    }
   }
   void show() {
     size_t mysize = 0;
@@ -183,42 +185,24 @@ class vector {
   }
 
   iterator insert(iterator pos, const_reference value) {
-    size_++;
-    if (front_ == nullptr) {
-      alloc_size_ = 1;
-      front_ = new value_type[alloc_size_];
-      *front_ = value;
-      return iterator(front_);
-    }
-    if (size_ <= alloc_size_) {
-      std::memmove(pos.ptr_ + 1, pos.ptr_,
-                   (size_ - 1) * sizeof(T) - (pos.ptr_ - front_) * sizeof(T));
-      *(pos.ptr_) = value;
-      return iterator(pos);
-    } else {
-      alloc_size_ *= 2;
-      T* reallocated = new T[alloc_size_];
-      std::memmove(reallocated, front_, (size_ - 1) * sizeof(T));
-      size_t p = pos.ptr_ - front_;
-      delete[] front_;
-      front_ = reallocated;
-      if (p != size_ - 1)
-        std::memmove(front_ + p + 1, front_ + p, (size_ - 1 - p) * sizeof(T));
-      *(front_ + p) = value;
-      return iterator(front_ + p);
-    }
+    return iterator(emplace_at_(pos.ptr_ - front_, value));
+  }
+  iterator insert(iterator pos, value_type&& value) {
+    return iterator(emplace_at_(pos.ptr_ - front_, std::move(value)));
   }
   void erase(iterator pos) {
-    if (front_ == nullptr) {
+    if (size_ == 0) {
       return;
     }
-    std::memmove(pos.ptr_, pos.ptr_ + 1,
-                 (size_ - 1) * sizeof(value_type) -
-                     (pos.ptr_ - front_) * sizeof(value_type));
-    size_--;
+    std::move(pos.ptr_ + 1, front_ + size_, pos.ptr_);
+    pop_back();
   }
-  void clear() { this->~vector(); }
-  void swap(vector& other) {
+  // Destroys the elements and keeps the buffer.
+  void clear() {
+    destroy_(front_, front_ + size_);
+    size_ = 0;
+  }
+  void swap(vector& other) noexcept {
     size_t temp = other.size_;
     other.size_ = size_;
     size_ = temp;
@@ -232,14 +216,56 @@ class vector {
 
   template <class... Args>
   iterator emplace(const_iterator pos, Args&&... args) {
-    value_type val(args...);
-    return this->insert(pos, val);
+    return iterator(
+        emplace_at_(pos.ptr_ - front_, std::forward<Args>(args)...));
   }
 
   template <class... Args>
   iterator emplace_back(Args&&... args) {
-    value_type val(args...);
-    return this->insert(this->end(), val);
+    return iterator(emplace_at_(size_, std::forward<Args>(args)...));
+  }
+
+ private:
+  // HELPER FUNCTIONS
+  static T* allocate_(size_type n) { return raw_storage::allocate<T>(n); }
+  static void deallocate_(T* p, size_type n) {
+    raw_storage::deallocate(p, n);
+  }
+  static void destroy_(T* first, T* last) {
+    raw_storage::destroy(first, last);
+  }
+  template <class It>
+  static void copy_construct_(It src, size_type n, T* dest) {
+    raw_storage::copy_construct(src, n, dest);
+  }
+  void reallocate_(size_type cap) {
+    T* buffer = allocate_(cap);
+    raw_storage::relocate(front_, front_ + size_, buffer);
+    deallocate_(front_, alloc_size_);
+    front_ = buffer;
+    alloc_size_ = cap;
+  }
+  template <class Init>
+  void resize_with_(size_type n, Init init) {
+    if (n > alloc_size_) reallocate_(std::max(n, 2 * alloc_size_));
+    raw_storage::resize_with(front_, size_, n, init);
+  }
+  // Constructs an element from args at index p, shifting the ones behind it
+  // up by one. args may refer into the vector.
+  template <class... Args>
+  T* emplace_at_(size_type p, Args&&... args) {
+    if (size_ == alloc_size_) {
+      size_type cap = alloc_size_ != 0 ? 2 * alloc_size_ : 1;
+      T* buffer = raw_storage::grow_emplace(front_, size_, p, cap,
+                                            std::forward<Args>(args)...);
+      deallocate_(front_, alloc_size_);
+      front_ = buffer;
+      alloc_size_ = cap;
+    } else {
+      raw_storage::emplace(front_, size_, p, std::forward<Args>(args)...);
+    }
+    size_++;
+    return front_ + p;
   }
 };
 
@@ -0,0 +1,74 @@
+#include <memory>
+#include <vector>
+
+#include "bench.h"
+#include "small_vector.h"
+#include "vector.h"
+
+namespace {
+
+using namespace s21::bench;
+
+template <class V, class T>
+void run_vector(const char* impl, size_t n) {
+  const char* key = key_name<T>();
+  auto keys = shuffled_keys<T>(n);
+  measure(
+      "vector", impl, "push_back", key, n, n,
+      [] { return std::make_unique<V>(); },
+      [&](std::unique_ptr<V>& v) {
+        for (auto& i : keys) {
+          v->push_back(i);
+        }
+        keep(v->size());
+      });
+  V full;
+  for (auto& i : keys) {
+    full.push_back(i);
+  }
+  measure(
+      "vector", impl, "iterate", key, n, n, [&] { return &full; },
+      [](V* v) {
+        std::uint64_t sum = 0;
+        for (auto i = v->begin(); i != v->end(); ++i) {
+          sum += checksum(*i);
+        }
+        keep(sum);
+      });
+  measure(
+      "vector", impl, "random_access", key, n, n, [&] { return &full; },
+      [&](V* v) {
+        std::uint64_t sum = 0, k = 1;
+        for (size_t i = 0; i < n; i++) {
+          k = k * 6364136223846793005ULL + 1442695040888963407ULL;
+          sum += checksum((*v)[(k >> 33) % n]);
+        }
+        keep(sum);
+      });
+  measure(
+      "vector", impl, "copy", key, n, n, [&] { return &full; },
+      [](V* v) {
+        V copy(*v);
+        keep(copy.size());
+      });
+}
+
+// std::string is left out until s21::vector stops relocating its elements
+// with memmove.
+template <class T>
+void run_key() {
+  for (size_t n : sizes()) {
+    run_vector<s21::vector<T>, T>("s21", n);
+    run_vector<s21::small_vector<T, 16>, T>("s21_small", n);
+    run_vector<std::vector<T>, T>("std", n);
+  }
+}
+
+void run() {
+  run_key<int>();
+  run_key<blob64>();
+}
+
+registrar reg("vector", run);
+
+}  // namespace
@@ -1,7 +1,11 @@
 #include "vector.h"
 
+#include <cstddef>
 #include <ctime>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 
 #include "gtest/gtest.h"
 // Copyright 2022 nolanhea
@@ -12,6 +16,67 @@ using vector = s21::vector<T>;
 template <class T>
 using original_vector = std::vector<T>;
 
+namespace {
+// Counts copies, so tests can check that moved-in elements are never
+// copied on their way into a container.
+struct copy_counted {
+  static int copies;
+  std::string payload;
+  explicit copy_counted(size_t n = 0) : payload(n, 'x') {}
+  copy_counted(const copy_counted& other) : payload(other.payload) {
+    copies++;
+  }
+  copy_counted(copy_counted&&) = default;
+  copy_counted& operator=(const copy_counted& other) {
+    payload = other.payload;
+    copies++;
+    return *this;
+  }
+  copy_counted& operator=(copy_counted&&) = default;
+};
+int copy_counted::copies = 0;
+
+// Throws from its constructor while armed, and counts the live instances.
+struct may_throw {
+  static bool armed;
+  static int alive;
+  int value;
+  explicit may_throw(int v = 0) : value(v) {
+    if (armed) throw std::runtime_error("may_throw");
+    alive++;
+  }
+  may_throw(const may_throw& other) : value(other.value) { alive++; }
+  may_throw& operator=(const may_throw&) = default;
+  ~may_throw() { alive--; }
+};
+bool may_throw::armed = false;
+int may_throw::alive = 0;
+}  // namespace
+
+// s21::vector allocates through std::allocator, so this specialization
+// lets the tests count the buffers of may_throw that are still allocated.
+template <>
+struct std::allocator<may_throw> {
+  using value_type = may_throw;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using propagate_on_container_move_assignment = std::true_type;
+  using is_always_equal = std::true_type;
+  static inline int live = 0;
+
+  allocator() = default;
+  template <class U>
+  allocator(const allocator<U>&) {}
+  may_throw* allocate(size_t n) {
+    live++;
+    return static_cast<may_throw*>(::operator new(n * sizeof(may_throw)));
+  }
+  void deallocate(may_throw* p, size_t) {
+    live--;
+    ::operator delete(p);
+  }
+};
+
 class S21VectorTest : public ::testing::Test {};
 
 TEST(S21VectorTest, DefaultConstructor) {
@@ -273,3 +338,106 @@ TEST(S21VectorTest, Emplace) {
     j++;
   }
 }
+
+TEST(S21VectorTest, Resize) {
+  vector<std::string> A{"a", "b"};
+  A.resize(5);
+  EXPECT_EQ(A.size(), 5);
+  EXPECT_EQ(A[1], "b");
+  EXPECT_EQ(A[4], "");
+  A.resize(7, A[0]);
+  EXPECT_EQ(A[6], "a");
+  A.resize(1);
+  EXPECT_EQ(A.size(), 1);
+  EXPECT_EQ(A.back(), "a");
+  vector<int> B(3);
+  EXPECT_EQ(B[2], 0);
+  B.resize_default_init(1000);
+  for (int i = 0; i < 1000; i++) {
+    B[i] = i;
+  }
+  EXPECT_EQ(B[999], 999);
+  EXPECT_GE(B.capacity(), 1000);
+}
+
+TEST(S21VectorTest, NonTrivialElements) {
+  vector<std::string> A;
+  original_vector<std::string> B;
+  for (int i = 0; i < 200; i++) {
+    std::string s(30, static_cast<char>('a' + i % 26));
+    A.push_back(s);
+    B.push_back(s);
+    if (i % 5 == 0) {
+      A.insert(A.begin(), A.back());
+      B.insert(B.begin(), B.back());
+    }
+  }
+  A.erase(++A.begin());
+  B.erase(++B.begin());
+  vector<std::string> C;
+  C = A;
+  vector<std::string> D(C);
+  C.clear();
+  EXPECT_TRUE(C.empty());
+  C = D;
+  ASSERT_EQ(C.size(), B.size());
+  for (size_t i = 0; i < B.size(); i++) {
+    EXPECT_EQ(C[i], B[i]);
+  }
+  D.shrink_to_fit();
+  EXPECT_EQ(D.capacity(), B.size());
+}
+
+TEST(S21VectorTest, MovesWithoutCopies) {
+  copy_counted::copies = 0;
+  vector<copy_counted> A;
+  for (int i = 0; i < 100; i++) {
+    copy_counted c(1024);
+    A.push_back(std::move(c));
+    A.emplace_back(1024);
+    A.insert(A.begin(), copy_counted(1024));
+    A.emplace(A.begin(), 1024);
+  }
+  EXPECT_EQ(A.size(), 400);
+  EXPECT_EQ(A[0].payload.size(), 1024);
+  EXPECT_EQ(copy_counted::copies, 0);
+}
+
+TEST(S21VectorTest, ThrowingEmplaceLeavesVectorUnchanged) {
+  {
+    vector<may_throw> A;
+    for (int i = 0; i < 4; i++) {
+      A.emplace_back(i);
+    }
+    ASSERT_EQ(A.size(), A.capacity());
+    const may_throw* data = A.data();
+    may_throw::armed = true;
+    EXPECT_THROW(A.emplace_back(4), std::runtime_error);
+    EXPECT_THROW(A.emplace(A.begin(), 4), std::runtime_error);
+    may_throw::armed = false;
+    EXPECT_EQ(A.size(), 4U);
+    EXPECT_EQ(A.capacity(), 4U);
+    EXPECT_EQ(A.data(), data);
+    EXPECT_EQ(A[3].value, 3);
+    EXPECT_EQ(std::allocator<may_throw>::live, 1);
+  }
+  EXPECT_EQ(std::allocator<may_throw>::live, 0);
+}
+
+TEST(S21VectorTest, FreesElementsAndBuffers) {
+  {
+    vector<may_throw> A;
+    for (int i = 0; i < 10; i++) {
+      A.emplace_back(i);
+    }
+    vector<may_throw> B(A);
+    vector<may_throw> C;
+    C = A;
+    B = std::move(C);
+    A = B;
+    EXPECT_EQ(may_throw::alive, 20);
+    EXPECT_EQ(std::allocator<may_throw>::live, 2);
+  }
+  EXPECT_EQ(may_throw::alive, 0);
+  EXPECT_EQ(std::allocator<may_throw>::live, 0);
+}
@@ -0,0 +1,150 @@
+#ifndef SRC_WORK_STEALING_DEQUE
+#define SRC_WORK_STEALING_DEQUE
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace s21 {
+
+// Chase-Lev work-stealing deque, in the C11 formulation of Le, Pop, Cohen
+// and Zappa Nardelli. One owner thread pushes and pops at the bottom like a
+// stack; any number of thieves take the oldest element from the top. The
+// owner's push does no read-modify-write at all, and its pop only competes
+// with thieves for the very last element. Thieves claim an element by
+// advancing top_ with a CAS.
+//
+// The elements live in a circular array that the owner doubles when it is
+// full. A thief may still be reading the old array, so it is not freed but
+// chained to the new one and released with the deque; since each array is
+// twice the previous one, they add up to less than the current array.
+//
+// Thieves read a slot before they know whether they won it, so elements are
+// stored in atomics and T must be trivially copyable: typically a pointer
+// to a task.
+template <class T>
+class work_stealing_deque {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "work_stealing_deque elements must be trivially copyable");
+  using index = std::int64_t;
+
+  struct ring_ {
+    index mask;
+    std::unique_ptr<std::atomic<T>[]> slots;
+    std::unique_ptr<ring_> retired;
+
+    explicit ring_(index capacity)
+        : mask(capacity - 1), slots(new std::atomic<T>[capacity]) {}
+    index capacity() const { return mask + 1; }
+    T get(index i) const {
+      return slots[i & mask].load(std::memory_order_relaxed);
+    }
+    void put(index i, T value) {
+      slots[i & mask].store(value, std::memory_order_relaxed);
+    }
+  };
+
+ public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = size_t;
+
+  // CONSTRUCTORS
+  // capacity is rounded up to a power of two.
+  explicit work_stealing_deque(size_type capacity = 64) : top_(0), bottom_(0) {
+    index c = 2;
+    while (static_cast<size_type>(c) < capacity) c *= 2;
+    ring_* r = new ring_(c);
+    array_.store(r, std::memory_order_relaxed);
+  }
+  work_stealing_deque(const work_stealing_deque&) = delete;
+  work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+  ~work_stealing_deque() { delete array_.load(std::memory_order_relaxed); }
+
+  // OWNER
+  void push(T value) {
+    index b = bottom_.load(std::memory_order_relaxed);
+    index t = top_.load(std::memory_order_acquire);
+    ring_* r = array_.load(std::memory_order_relaxed);
+    if (b - t >= r->capacity()) r = grow_(r, t, b);
+    r->put(b, value);
+    bottom_.store(b + 1, std::memory_order_release);
+  }
+  // Takes the newest element. Returns false if the deque was empty or a
+  // thief took the last element first.
+  bool pop(reference out) {
+    index b = bottom_.load(std::memory_order_relaxed) - 1;
+    ring_* r = array_.load(std::memory_order_relaxed);
+    // Publishing the smaller bottom before reading top is what keeps the
+    // owner and a thief from both taking the last element; it has to be
+    // sequentially consistent against the thief's loads in steal.
+    bottom_.store(b, std::memory_order_seq_cst);
+    index t = top_.load(std::memory_order_seq_cst);
+    if (t > b) {
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return false;
+    }
+    out = r->get(b);
+    if (t < b) return true;
+    bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                            std::memory_order_relaxed);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return won;
+  }
+
+  // THIEVES
+  // Takes the oldest element. Returns false if the deque was empty or
+  // another thread won the race for that element; callers that need an
+  // answer retry or move on to another victim.
+  bool steal(reference out) {
+    index t = top_.load(std::memory_order_seq_cst);
+    index b = bottom_.load(std::memory_order_seq_cst);
+    if (t >= b) return false;
+    T value = array_.load(std::memory_order_acquire)->get(t);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return false;
+    }
+    out = value;
+    return true;
+  }
+
+  // CAPACITY
+  // A snapshot; exact only on the owner while no thief is stealing.
+  size_type size() const {
+    index b = bottom_.load(std::memory_order_acquire);
+    index t = top_.load(std::memory_order_acquire);
+    return b > t ? static_cast<size_type>(b - t) : 0;
+  }
+  bool empty() const { return size() == 0; }
+  size_type capacity() const {
+    return static_cast<size_type>(
+        array_.load(std::memory_order_acquire)->capacity());
+  }
+
+ private:
+  static constexpr size_t cache_line_ = 64;
+
+  // Copies the live range [t, b) into an array twice the size and retires
+  // the old one. Only the owner calls this, so the copied slots are stable.
+  ring_* grow_(ring_* old, index t, index b) {
+    ring_* r = new ring_(old->capacity() * 2);
+    for (index i = t; i < b; i++) {
+      r->put(i, old->get(i));
+    }
+    r->retired.reset(old);
+    array_.store(r, std::memory_order_release);
+    return r;
+  }
+
+  alignas(cache_line_) std::atomic<index> top_;
+  alignas(cache_line_) std::atomic<index> bottom_;
+  alignas(cache_line_) std::atomic<ring_*> array_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_WORK_STEALING_DEQUE
@@ -0,0 +1,148 @@
+// work_stealing_deque against s21::stack behind a mutex. owner_push_pop is
+// the owner alone; steal_tK has K thieves drain a filled deque;
+// push_steal_tK has the owner push while K thieves steal. ns_per_op is wall
+// time per element taken.
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "stack.h"
+#include "work_stealing_deque.h"
+
+namespace {
+
+using namespace s21::bench;
+
+const int kMaxThieves = 8;
+
+struct chase_lev_channel {
+  s21::work_stealing_deque<int> d;
+  void push(int value) { d.push(value); }
+  bool pop(int& out) { return d.pop(out); }
+  bool steal(int& out) { return d.steal(out); }
+};
+
+struct locked_channel {
+  s21::stack<int> s;
+  std::mutex m;
+  void push(int value) {
+    std::lock_guard<std::mutex> lock(m);
+    s.push(value);
+  }
+  bool pop(int& out) {
+    std::lock_guard<std::mutex> lock(m);
+    if (s.empty()) return false;
+    out = s.top();
+    s.pop();
+    return true;
+  }
+  bool steal(int& out) { return pop(out); }
+};
+
+template <class C>
+std::unique_ptr<C> filled(const std::vector<int>& keys) {
+  auto ret = std::make_unique<C>();
+  for (int i : keys) {
+    ret->push(i);
+  }
+  return ret;
+}
+
+// Starts thieves that steal until taken reaches n, adding what they took to
+// sum.
+template <class C>
+std::vector<std::thread> start_thieves(C& c, int thieves, size_t n,
+                                       std::atomic<size_t>& taken,
+                                       std::atomic<std::uint64_t>& sum) {
+  std::vector<std::thread> ret;
+  for (int k = 0; k < thieves; k++) {
+    ret.emplace_back([&c, &taken, &sum, n] {
+      std::uint64_t local = 0;
+      int out;
+      while (taken.load(std::memory_order_relaxed) < n) {
+        if (c.steal(out)) {
+          local += out;
+          taken.fetch_add(1, std::memory_order_relaxed);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+      sum += local;
+    });
+  }
+  return ret;
+}
+
+template <class C>
+void run_channel(const char* impl, const std::vector<int>& keys) {
+  size_t n = keys.size();
+  measure(
+      "work_stealing_deque", impl, "owner_push_pop", "int", n, 2 * n,
+      [] { return std::make_unique<C>(); },
+      [&](std::unique_ptr<C>& c) {
+        for (int i : keys) {
+          c->push(i);
+        }
+        std::uint64_t sum = 0;
+        int out;
+        while (c->pop(out)) {
+          sum += out;
+        }
+        keep(sum);
+      });
+  for (int t = 1; t <= kMaxThieves; t *= 2) {
+    std::string op = "steal_t" + std::to_string(t);
+    measure(
+        "work_stealing_deque", impl, op.c_str(), "int", n, n,
+        [&] { return filled<C>(keys); },
+        [&](std::unique_ptr<C>& c) {
+          std::atomic<size_t> taken(0);
+          std::atomic<std::uint64_t> sum(0);
+          auto threads = start_thieves(*c, t, n, taken, sum);
+          for (auto& i : threads) {
+            i.join();
+          }
+          keep(sum.load());
+        });
+    op = "push_steal_t" + std::to_string(t);
+    measure(
+        "work_stealing_deque", impl, op.c_str(), "int", n, n,
+        [] { return std::make_unique<C>(); },
+        [&](std::unique_ptr<C>& c) {
+          std::atomic<size_t> taken(0);
+          std::atomic<std::uint64_t> sum(0);
+          auto threads = start_thieves(*c, t, n, taken, sum);
+          for (int i : keys) {
+            c->push(i);
+          }
+          std::uint64_t local = 0;
+          int out;
+          while (taken.load(std::memory_order_relaxed) < n) {
+            if (c->pop(out)) {
+              local += out;
+              taken.fetch_add(1, std::memory_order_relaxed);
+            }
+          }
+          for (auto& i : threads) {
+            i.join();
+          }
+          keep(sum.load() + local);
+        });
+  }
+}
+
+void run() {
+  for (size_t n : sizes()) {
+    auto keys = shuffled_keys<int>(n);
+    run_channel<chase_lev_channel>("s21", keys);
+    run_channel<locked_channel>("stack+mutex", keys);
+  }
+}
+
+registrar reg("work_stealing_deque", run);
+
+}  // namespace
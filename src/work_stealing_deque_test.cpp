@@ -0,0 +1,130 @@
+#include "work_stealing_deque.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+class WorkStealingDequeTest : public ::testing::Test {};
+
+TEST(WorkStealingDequeTest, OwnerIsLifoThievesAreFifo) {
+  s21::work_stealing_deque<int> A(3);
+  EXPECT_EQ(A.capacity(), 4U);
+  int out = -1;
+  EXPECT_FALSE(A.pop(out));
+  EXPECT_FALSE(A.steal(out));
+  for (int i = 0; i < 100; i++) {
+    A.push(i);
+  }
+  EXPECT_EQ(A.size(), 100U);
+  EXPECT_EQ(A.capacity(), 128U);
+  EXPECT_TRUE(A.steal(out));
+  EXPECT_EQ(out, 0);
+  EXPECT_TRUE(A.pop(out));
+  EXPECT_EQ(out, 99);
+  for (int i = 1; i < 50; i++) {
+    EXPECT_TRUE(A.steal(out));
+    EXPECT_EQ(out, i);
+  }
+  for (int i = 98; i >= 50; i--) {
+    EXPECT_TRUE(A.pop(out));
+    EXPECT_EQ(out, i);
+  }
+  EXPECT_TRUE(A.empty());
+  EXPECT_FALSE(A.pop(out));
+  EXPECT_FALSE(A.steal(out));
+  // Wraps around the ring without growing it again.
+  for (int round = 0; round < 10; round++) {
+    for (int i = 0; i < 100; i++) {
+      A.push(i);
+    }
+    for (int i = 0; i < 100; i++) {
+      EXPECT_TRUE(A.steal(out));
+      EXPECT_EQ(out, i);
+    }
+  }
+  EXPECT_EQ(A.capacity(), 128U);
+}
+
+// The owner pushes in bursts from a small initial ring, so it grows while
+// thieves are reading it, and pops back part of every burst. Every value
+// must be taken exactly once, by either side.
+TEST(WorkStealingDequeTest, StressOwnerAgainstThieves) {
+  const int thieves = 4;
+  const int total = 200000;
+  s21::work_stealing_deque<int> A(2);
+  std::vector<std::atomic<int>> seen(total);
+  std::atomic<bool> done(false);
+  std::atomic<int> stolen(0);
+  std::vector<std::thread> threads;
+  for (int k = 0; k < thieves; k++) {
+    threads.emplace_back([&] {
+      int out;
+      while (!done.load(std::memory_order_acquire) || !A.empty()) {
+        if (A.steal(out)) {
+          seen[out]++;
+          stolen++;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  int popped = 0;
+  int out;
+  for (int i = 0; i < total;) {
+    int burst = std::min(total - i, 1 + i % 97);
+    for (int j = 0; j < burst; j++) {
+      A.push(i++);
+    }
+    for (int j = 0; j < burst / 2 && A.pop(out); j++) {
+      seen[out]++;
+      popped++;
+    }
+  }
+  while (A.pop(out)) {
+    seen[out]++;
+    popped++;
+  }
+  done.store(true, std::memory_order_release);
+  for (auto& i : threads) {
+    i.join();
+  }
+  EXPECT_EQ(popped + stolen.load(), total);
+  int wrong = 0;
+  for (auto& i : seen) {
+    wrong += i.load() != 1;
+  }
+  EXPECT_EQ(wrong, 0);
+}
+
+// The last element is what the owner's pop and a thief's steal race for.
+TEST(WorkStealingDequeTest, LastElementGoesToExactlyOneSide) {
+  s21::work_stealing_deque<int> A;
+  std::atomic<int> go(0);
+  std::atomic<int> stolen(0);
+  const int rounds = 20000;
+  std::thread thief([&] {
+    int out;
+    for (int r = 1; r <= rounds; r++) {
+      while (go.load(std::memory_order_acquire) < r) {
+        std::this_thread::yield();
+      }
+      stolen += A.steal(out);
+    }
+  });
+  int popped = 0;
+  int out;
+  for (int r = 1; r <= rounds; r++) {
+    A.push(r);
+    go.store(r, std::memory_order_release);
+    popped += A.pop(out);
+    while (!A.empty()) {
+      std::this_thread::yield();
+    }
+  }
+  thief.join();
+  EXPECT_EQ(popped + stolen.load(), rounds);
+}